@@ -0,0 +1,89 @@
+/**
+ * @file alloc_count.hpp
+ * @brief Heap-counting hooks feeding bench::alloc_counters().
+ *
+ * Defines the replaceable global operator new/delete and linker wrappers
+ * for malloc/calloc/realloc/free, so include it from exactly one
+ * translation unit and link that binary with
+ *   -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+ * (see BENCH_WRAP_LDFLAGS in the Makefile). Only calls made from objects
+ * linked with --wrap are seen; operator new goes straight to __real_malloc
+ * so each allocation is counted once.
+ */
+
+#ifndef ALLOC_COUNT_HPP
+#define ALLOC_COUNT_HPP
+
+#include "bench.hpp"
+
+#include <cstddef>
+#include <new>
+
+extern "C" {
+void *__real_malloc(std::size_t size);
+void *__real_calloc(std::size_t n, std::size_t size);
+void *__real_realloc(void *p, std::size_t size);
+void __real_free(void *p);
+}
+
+namespace bench {
+namespace detail {
+
+inline void count_allocation(std::size_t bytes) noexcept {
+    alloc_stats &a = alloc_counters();
+    a.count.fetch_add(1u, std::memory_order_relaxed);
+    a.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+inline void *counted_new(std::size_t size) {
+    void *p = __real_malloc((size == 0u) ? 1u : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    count_allocation(size);
+    return p;
+}
+
+}  // namespace detail
+}  // namespace bench
+
+extern "C" {
+void *__wrap_malloc(std::size_t size) {
+    bench::detail::count_allocation(size);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(std::size_t n, std::size_t size) {
+    bench::detail::count_allocation(n * size);
+    return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *p, std::size_t size) {
+    bench::detail::count_allocation(size);
+    return __real_realloc(p, size);
+}
+
+void __wrap_free(void *p) { __real_free(p); }
+}
+
+void *operator new(std::size_t size) { return bench::detail::counted_new(size); }
+void *operator new[](std::size_t size) { return bench::detail::counted_new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    void *p = __real_malloc((size == 0u) ? 1u : size);
+    if (p != nullptr) {
+        bench::detail::count_allocation(size);
+    }
+    return p;
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept { __real_free(p); }
+void operator delete[](void *p) noexcept { __real_free(p); }
+void operator delete(void *p, std::size_t) noexcept { __real_free(p); }
+void operator delete[](void *p, std::size_t) noexcept { __real_free(p); }
+
+#endif  // ALLOC_COUNT_HPP
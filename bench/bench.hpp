@@ -0,0 +1,236 @@
+/**
+ * @file bench.hpp
+ * @brief Shared timing helpers for the benchmark programs under bench/.
+ */
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench {
+
+/** Cheap monotonic tick counter: TSC on x86, nanoseconds elsewhere. */
+inline std::uint64_t ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+inline std::uint64_t now_ns() noexcept {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+/** Keep the compiler from discarding a computed value. */
+template <typename T>
+inline void do_not_optimize(T const &value) noexcept {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/** Compiler barrier for values the benchmark loop writes through memory. */
+inline void clobber_memory() noexcept { asm volatile("" : : : "memory"); }
+
+/**
+ * Return an integer or pointer unchanged but unknown to the optimiser, so
+ * benchmark inputs cannot be constant-folded.
+ */
+template <typename T>
+inline T opaque(T value) noexcept {
+    asm volatile("" : "+r"(value));
+    return value;
+}
+
+/** Run `body` `n` times; the lambda is inlined into the loop. */
+template <typename F>
+inline void repeat(std::uint64_t n, F body) {
+    for (std::uint64_t i = 0u; i < n; ++i) {
+        body();
+    }
+}
+
+/**
+ * Heap traffic seen by the current program. Always zero unless the
+ * benchmark includes alloc_count.hpp, which installs the counting hooks.
+ */
+struct alloc_stats {
+    std::atomic<std::uint64_t> count{0u};
+    std::atomic<std::uint64_t> bytes{0u};
+};
+
+inline alloc_stats &alloc_counters() noexcept {
+    static alloc_stats stats;
+    return stats;
+}
+
+/**
+ * CPU cycles from the hardware PMU via perf_event_open(); falls back to
+ * the TSC where the PMU is unavailable (containers, VMs, paranoid kernels).
+ */
+class cycle_counter {
+public:
+    cycle_counter() noexcept {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    ~cycle_counter() {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+    cycle_counter(const cycle_counter &) = delete;
+    cycle_counter &operator=(const cycle_counter &) = delete;
+
+    std::uint64_t read() const noexcept {
+        std::uint64_t value = 0u;
+        if ((fd_ < 0) || (::read(fd_, &value, sizeof(value)) != sizeof(value))) {
+            value = ticks();
+        }
+        return value;
+    }
+
+    const char *source() const noexcept { return (fd_ >= 0) ? "pmu" : "tsc"; }
+
+private:
+    int fd_ = -1;
+};
+
+struct measurement {
+    std::uint64_t iterations;
+    double ns_per_op;
+    double cycles_per_op;
+    double allocs_per_op;
+    double bytes_per_op;
+};
+
+/**
+ * Time `fn(n)`: calibrate n so one run takes about min_seconds / reps,
+ * then report the median of `reps` runs. Allocations are counted over
+ * one extra run so counting never perturbs the timed ones.
+ */
+inline measurement measure(void (*fn)(std::uint64_t), const cycle_counter &cycles,
+                           double min_seconds = 0.25, int reps = 5) {
+    const double target_ns = (min_seconds * 1e9) / static_cast<double>(reps);
+    std::uint64_t n = 1u;
+    for (;;) {
+        std::uint64_t t0 = now_ns();
+        fn(n);
+        double ns = static_cast<double>(now_ns() - t0);
+        if (ns >= target_ns) {
+            break;
+        }
+        double scale = (ns > 0.0) ? (1.4 * target_ns / ns) : 10.0;
+        scale = std::min(std::max(scale, 1.5), 100.0);
+        n = static_cast<std::uint64_t>(static_cast<double>(n) * scale) + 1u;
+    }
+
+    std::vector<double> ns_samples;
+    std::vector<double> cycle_samples;
+    for (int r = 0; r < reps; ++r) {
+        std::uint64_t c0 = cycles.read();
+        std::uint64_t t0 = now_ns();
+        fn(n);
+        std::uint64_t t1 = now_ns();
+        std::uint64_t c1 = cycles.read();
+        ns_samples.push_back(static_cast<double>(t1 - t0) / static_cast<double>(n));
+        cycle_samples.push_back(static_cast<double>(c1 - c0) / static_cast<double>(n));
+    }
+    std::sort(ns_samples.begin(), ns_samples.end());
+    std::sort(cycle_samples.begin(), cycle_samples.end());
+
+    alloc_stats &a = alloc_counters();
+    std::uint64_t count0 = a.count.load();
+    std::uint64_t bytes0 = a.bytes.load();
+    fn(n);
+    std::uint64_t count1 = a.count.load();
+    std::uint64_t bytes1 = a.bytes.load();
+
+    measurement m{};
+    m.iterations = n;
+    m.ns_per_op = ns_samples[ns_samples.size() / 2u];
+    m.cycles_per_op = cycle_samples[cycle_samples.size() / 2u];
+    m.allocs_per_op = static_cast<double>(count1 - count0) / static_cast<double>(n);
+    m.bytes_per_op = static_cast<double>(bytes1 - bytes0) / static_cast<double>(n);
+    return m;
+}
+
+struct latency_stats {
+    double mean;
+    double stddev;
+    std::uint64_t min;
+    std::uint64_t p50;
+    std::uint64_t p99;
+    std::uint64_t p999;
+    std::uint64_t max;
+};
+
+/** Summarise raw per-operation samples (sorts the vector in place). */
+inline latency_stats summarize(std::vector<std::uint64_t> &samples) {
+    latency_stats s{};
+    if (!samples.empty()) {
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (std::uint64_t v : samples) {
+            sum += static_cast<double>(v);
+        }
+        s.mean = sum / static_cast<double>(samples.size());
+        double sq = 0.0;
+        for (std::uint64_t v : samples) {
+            double d = static_cast<double>(v) - s.mean;
+            sq += d * d;
+        }
+        s.stddev = std::sqrt(sq / static_cast<double>(samples.size()));
+        auto pct = [&samples](double p) {
+            std::size_t idx = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1u));
+            return samples[idx];
+        };
+        s.min = samples.front();
+        s.p50 = pct(0.50);
+        s.p99 = pct(0.99);
+        s.p999 = pct(0.999);
+        s.max = samples.back();
+    }
+    return s;
+}
+
+inline void print_stats_header(const char *unit) {
+    std::printf("%-28s %10s %10s %10s %10s %10s %10s %12s  (%s)\n", "case", "mean", "stddev",
+                "min", "p50", "p99", "p99.9", "max", unit);
+}
+
+inline void print_stats(const char *name, const latency_stats &s) {
+    std::printf("%-28s %10.1f %10.1f %10llu %10llu %10llu %10llu %12llu\n", name, s.mean, s.stddev,
+                static_cast<unsigned long long>(s.min), static_cast<unsigned long long>(s.p50),
+                static_cast<unsigned long long>(s.p99), static_cast<unsigned long long>(s.p999),
+                static_cast<unsigned long long>(s.max));
+}
+
+}  // namespace bench
+
+#endif  // BENCH_HPP
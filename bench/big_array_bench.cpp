@@ -0,0 +1,200 @@
+/**
+ * @file big_array_bench.cpp
+ * @brief Multi-GB arrays through cs::big_array (CERT C++ MEM52-CPP) vs
+ * new[]: allocation, first touch, TLB reach and resident memory.
+ *
+ * For an array of kDefaultMiB (or argv[1]) MiB, each variant allocates
+ * the whole array, writes one byte per 4 KiB page, and frees it again:
+ *
+ *   new[]              default-initialised; glibc maps it lazily
+ *   new[]()            value-initialised, as std::vector<char>(n) does
+ *   big_array          reserve + resize, 4 KiB pages faulted on touch
+ *   big_array THP      the same with madvise(MADV_HUGEPAGE)
+ *   big_array populate pages pre-faulted inside resize()
+ *   THP + populate
+ *
+ * Reported per variant: time to allocate, resident memory after
+ * allocating and after touching only the first eighth of the pages (peak
+ * RSS for a sparsely used array), time to touch the other seven eighths
+ * (the first-touch page-fault cost), and the cost
+ * of random 8-byte reads over the whole array once it is resident, where
+ * huge pages cut TLB misses.
+ */
+
+#include "bench.hpp"
+#include "big_array.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kDefaultMiB = 2048u;
+constexpr std::size_t kPage = 4096u;
+constexpr std::size_t kRandomReads = 1u << 24;
+
+/** Resident set size of this process, from /proc/self/statm. */
+std::size_t rss_bytes() {
+    std::size_t pages = 0u;
+    std::FILE *f = std::fopen("/proc/self/statm", "r");
+    if (f != nullptr) {
+        unsigned long size = 0u;
+        unsigned long resident = 0u;
+        if (std::fscanf(f, "%lu %lu", &size, &resident) == 2) {
+            pages = resident;
+        }
+        static_cast<void>(std::fclose(f));
+    }
+    return pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+double ms_since(std::uint64_t t0) {
+    return static_cast<double>(bench::now_ns() - t0) / 1e6;
+}
+
+double mib(std::size_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+void touch(unsigned char *p, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i += kPage) {
+        p[i] = 1u;
+    }
+    bench::clobber_memory();
+}
+
+/** Mean ns per random 8-byte read over p[0..bytes). */
+double random_reads(const unsigned char *p, std::size_t bytes) {
+    const std::uint64_t *w = reinterpret_cast<const std::uint64_t *>(p);
+    const std::uint64_t words = bytes / sizeof(std::uint64_t);
+    std::uint64_t s = 0x9E3779B97F4A7C15u;
+    std::uint64_t sum = 0u;
+    const std::uint64_t t0 = bench::now_ns();
+    for (std::size_t i = 0u; i < kRandomReads; ++i) {
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        sum += w[s % words];
+    }
+    const double ns = static_cast<double>(bench::now_ns() - t0);
+    bench::do_not_optimize(sum);
+    return ns / static_cast<double>(kRandomReads);
+}
+
+struct result {
+    double alloc_ms;
+    double touch_ms;
+    std::size_t rss_alloc;   // Resident growth after allocating
+    std::size_t rss_sparse;  // ... after touching the first eighth
+    double read_ns;
+    bool ok;
+};
+
+/** Everything after the allocation, the same for every variant. */
+void measure_array(unsigned char *p, std::size_t bytes, std::size_t rss0, result &r) {
+    r.rss_alloc = rss_bytes() - rss0;
+    touch(p, 0u, bytes / 8u);
+    r.rss_sparse = rss_bytes() - rss0;
+    const std::uint64_t t0 = bench::now_ns();
+    touch(p, bytes / 8u, bytes);
+    r.touch_ms = ms_since(t0);
+    r.read_ns = random_reads(p, bytes);
+}
+
+result run_new(std::size_t bytes, bool value_init) {
+    result r = {};
+    const std::size_t rss0 = rss_bytes();
+    const std::uint64_t t0 = bench::now_ns();
+    std::unique_ptr<unsigned char[]> p(value_init ? new (std::nothrow) unsigned char[bytes]()
+                                                  : new (std::nothrow) unsigned char[bytes]);
+    r.alloc_ms = ms_since(t0);
+    r.ok = p != nullptr;
+    if (r.ok) {
+        measure_array(p.get(), bytes, rss0, r);
+    }
+    return r;
+}
+
+result run_big(std::size_t bytes, bool huge, bool populate) {
+    result r = {};
+    const std::size_t rss0 = rss_bytes();
+    cs::big_array_options options;
+    options.huge_pages = huge;
+    options.populate = populate;
+    const std::uint64_t t0 = bench::now_ns();
+    cs::expected<cs::big_array<unsigned char>, std::errc> a =
+        cs::big_array<unsigned char>::reserve(bytes, options);
+    r.ok = a.has_value() && a.value().resize(bytes).has_value();
+    r.alloc_ms = ms_since(t0);
+    if (r.ok) {
+        measure_array(a.value().data(), bytes, rss0, r);
+    }
+    return r;
+}
+
+/** Semantics the timings rely on: zeroed growth, no re-zeroing, ERANGE. */
+bool check() {
+    cs::big_array_options options;
+    options.chunk_bytes = 1u << 16;
+    cs::expected<cs::big_array<std::uint32_t>, std::errc> a =
+        cs::big_array<std::uint32_t>::reserve(1u << 20, options);
+    bool ok = a.has_value() && a.value().resize(1000u).has_value();
+    if (ok) {
+        cs::big_array<std::uint32_t> &v = a.value();
+        v[999] = 7u;
+        const std::uint32_t *before = v.data();
+        ok = v.resize(1u << 20).has_value() && (v.data() == before) && (v[999] == 7u) &&
+             (v[(1u << 20) - 1u] == 0u) && v.resize(10u).has_value() &&
+             v.resize(1000u).has_value() && (v[999] == 0u) &&
+             (v.resize((1u << 20) + 1u).error() == std::errc::result_out_of_range);
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const std::size_t size_mib = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : kDefaultMiB;
+    const std::size_t bytes = size_mib * 1024u * 1024u;
+    if (bytes == 0u) {
+        std::fprintf(stderr, "usage: %s [MiB]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!check()) {
+        std::fprintf(stderr, "big_array resize check failed\n");
+        return EXIT_FAILURE;
+    }
+
+    struct variant {
+        const char *name;
+        result (*run)(std::size_t);
+    };
+    const variant variants[] = {
+        {"new[]", [](std::size_t b) { return run_new(b, false); }},
+        {"new[]()", [](std::size_t b) { return run_new(b, true); }},
+        {"big_array", [](std::size_t b) { return run_big(b, false, false); }},
+        {"big_array THP", [](std::size_t b) { return run_big(b, true, false); }},
+        {"big_array populate", [](std::size_t b) { return run_big(b, false, true); }},
+        {"THP + populate", [](std::size_t b) { return run_big(b, true, true); }},
+    };
+
+    std::printf("%zu MiB array, one write per 4 KiB page, %zu random reads\n", size_mib,
+                kRandomReads);
+    std::printf("%-20s %10s %10s %10s %12s %12s %10s\n", "variant", "alloc ms", "touch ms",
+                "total ms", "RSS alloc", "RSS 1/8", "ns/read");
+    for (const variant &v : variants) {
+        const result r = v.run(bytes);
+        if (r.ok) {
+            std::printf("%-20s %10.1f %10.1f %10.1f %9.0f MiB %8.0f MiB %10.2f\n", v.name,
+                        r.alloc_ms, r.touch_ms, r.alloc_ms + r.touch_ms, mib(r.rss_alloc),
+                        mib(r.rss_sparse), r.read_ns);
+        } else {
+            std::printf("%-20s allocation failed (reported, not dereferenced)\n", v.name);
+        }
+    }
+    return 0;
+}
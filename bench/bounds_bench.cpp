@@ -0,0 +1,152 @@
+/**
+ * @file bounds_bench.cpp
+ * @brief Cost of the bounds policies in tight loops.
+ *
+ * Three loops over 4096 32-bit elements:
+ *
+ *   seq      i < c.size(): the compiler proves every check redundant
+ *   seq/n    i < n with n opaque: checks stay in the loop
+ *   gather   c[random index]: every check has to run
+ *
+ * Each container is timed against a raw C array; "x raw" is the ratio of
+ * their ns/element.
+ */
+
+#include "bench.hpp"
+#include "bounds.hpp"
+#include "prng.hpp"
+#include "static_vector.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElems = 4096u;
+constexpr std::size_t kPasses = 20000u;
+constexpr int kReps = 5;
+
+std::array<std::uint32_t, kElems> g_index;
+
+template <typename F>
+double best_ns_per_elem(F fn) {
+    double best = 1e300;
+    for (int r = 0; r < kReps; ++r) {
+        std::uint64_t t0 = bench::now_ns();
+        for (std::size_t p = 0u; p < kPasses; ++p) {
+            bench::do_not_optimize(fn());
+            bench::clobber_memory();
+        }
+        double ns = static_cast<double>(bench::now_ns() - t0) /
+                    static_cast<double>(kPasses * kElems);
+        best = (ns < best) ? ns : best;
+    }
+    return best;
+}
+
+std::size_t size_of(const std::int32_t (&)[kElems]) { return kElems; }
+
+template <typename C>
+std::size_t size_of(const C &c) {
+    return c.size();
+}
+
+template <typename C>
+std::int32_t sequential_sum(const C &c) {
+    std::int32_t sum = 0;
+    for (std::size_t i = 0u; i < size_of(c); ++i) {
+        sum += c[i];
+    }
+    return sum;
+}
+
+template <typename C>
+std::int32_t sequential_sum_n(const C &c, std::size_t n) {
+    std::int32_t sum = 0;
+    for (std::size_t i = 0u; i < n; ++i) {
+        sum += c[i];
+    }
+    return sum;
+}
+
+template <typename C>
+std::int32_t gather_sum(const C &c) {
+    std::int32_t sum = 0;
+    for (std::size_t i = 0u; i < kElems; ++i) {
+        sum += c[g_index[i]];
+    }
+    return sum;
+}
+
+struct result {
+    double sequential;
+    double sequential_n;
+    double gather;
+};
+
+template <typename C>
+result run(const C &c, std::size_t n) {
+    result r{};
+    r.sequential = best_ns_per_elem([&c] { return sequential_sum(c); });
+    r.sequential_n = best_ns_per_elem([&c, n] { return sequential_sum_n(c, bench::opaque(n)); });
+    r.gather = best_ns_per_elem([&c] { return gather_sum(c); });
+    return r;
+}
+
+void row(const char *name, const result &r, const result &raw) {
+    std::printf("%-26s %8.3f %6.2f %8.3f %6.2f %8.3f %6.2f\n", name, r.sequential,
+                r.sequential / raw.sequential, r.sequential_n, r.sequential_n / raw.sequential_n,
+                r.gather, r.gather / raw.gather);
+}
+
+/** std::vector::at(), the usual run-time checked baseline. */
+struct vector_at {
+    const std::vector<std::int32_t> &v;
+    std::int32_t operator[](std::size_t i) const { return v.at(i); }
+    std::size_t size() const { return v.size(); }
+};
+
+}  // namespace
+
+int main() {
+    cs::xoshiro256 rng(7u);
+    for (std::uint32_t &i : g_index) {
+        i = static_cast<std::uint32_t>(rng() % kElems);
+    }
+
+    static std::int32_t raw[kElems];
+    static std::array<std::int32_t, kElems> std_array;
+    static cs::checked_array<std::int32_t, kElems, cs::bounds::unchecked> unchecked;
+    static cs::checked_array<std::int32_t, kElems, cs::bounds::trap> trapping;
+    static cs::checked_array<std::int32_t, kElems, cs::bounds::clamp> clamping;
+    static cs::static_vector<std::int32_t, kElems, cs::bounds::trap> sv_trap;
+    static cs::static_vector<std::int32_t, kElems, cs::bounds::unchecked> sv_unchecked;
+    std::vector<std::int32_t> vec(kElems);
+    for (std::size_t i = 0u; i < kElems; ++i) {
+        std::int32_t v = static_cast<std::int32_t>(rng() & 0xFFu);
+        raw[i] = v;
+        std_array[i] = v;
+        unchecked[i] = v;
+        trapping[i] = v;
+        clamping[i] = v;
+        static_cast<void>(sv_trap.push_back(v));
+        static_cast<void>(sv_unchecked.push_back(v));
+        vec[i] = v;
+    }
+
+    std::printf("%zu elements x %zu passes, best of %d\n", kElems, kPasses, kReps);
+    std::printf("%-26s %8s %6s %8s %6s %8s %6s  (ns/element)\n", "container", "seq", "x raw",
+                "seq/n", "x raw", "gather", "x raw");
+    result base = run(raw, kElems);
+    row("int[N]", base, base);
+    row("std::array", run(std_array, kElems), base);
+    row("checked_array<unchecked>", run(unchecked, kElems), base);
+    row("checked_array<trap>", run(trapping, kElems), base);
+    row("checked_array<clamp>", run(clamping, kElems), base);
+    row("static_vector<unchecked>", run(sv_unchecked, sv_unchecked.size()), base);
+    row("static_vector<trap>", run(sv_trap, sv_trap.size()), base);
+    row("std::vector::at", run(vector_at{vec}, kElems), base);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file bstr_bench.cpp
+ * @brief Bounded copy and length scan vs strcpy/strncpy/snprintf across
+ * string lengths, for each available bstr kernel.
+ *
+ * Every copy goes into a destination large enough for the source, so the
+ * unbounded functions are safe to time; the numbers show what the bounds
+ * check and truncation report cost on top of them.
+ */
+
+#include "bench.hpp"
+#include "bstr.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kSources = 64u;
+
+template <typename F>
+double ns_per_op(std::size_t iterations, F fn) {
+    std::uint64_t t0 = bench::now_ns();
+    for (std::size_t i = 0u; i < iterations; ++i) {
+        fn(i % kSources);
+        bench::clobber_memory();
+    }
+    return static_cast<double>(bench::now_ns() - t0) / static_cast<double>(iterations);
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t lengths[] = {1u, 8u, 15u, 32u, 64u, 256u, 1024u, 4096u};
+    const bstr_impl_t impls[] = {BSTR_IMPL_SCALAR, BSTR_IMPL_SSE2, BSTR_IMPL_AVX2};
+
+    std::printf("auto-selected kernel: %s\n", bstr_impl_name());
+    std::printf("%6s %9s %9s %9s %9s | %9s %9s", "len", "strlen", "strnlen", "strcpy",
+                "strncpy", "snprintf", "memcpy");
+    for (bstr_impl_t impl : impls) {
+        if (bstr_select_impl(impl)) {
+            std::printf(" | %7s nlen %7s copy", bstr_impl_name(), bstr_impl_name());
+        }
+    }
+    std::printf("   (ns/op)\n");
+
+    for (std::size_t len : lengths) {
+        std::size_t cap = len + 64u;
+        // Sources at varying alignments so the kernels see unaligned heads
+        std::vector<std::vector<char>> src(kSources, std::vector<char>(cap + 64u, 'x'));
+        std::vector<const char *> s(kSources);
+        for (std::size_t i = 0u; i < kSources; ++i) {
+            char *p = src[i].data() + (i % 32u);
+            p[len] = '\0';
+            s[i] = p;
+        }
+        std::vector<char> dst(cap);
+        std::size_t iters = (len >= 1024u) ? 200000u : 2000000u;
+
+        double t_strlen = ns_per_op(iters, [&](std::size_t i) {
+            bench::do_not_optimize(std::strlen(s[i]));
+        });
+        double t_strnlen = ns_per_op(iters, [&](std::size_t i) {
+            bench::do_not_optimize(strnlen(s[i], cap));
+        });
+        double t_strcpy = ns_per_op(iters, [&](std::size_t i) {
+            bench::do_not_optimize(std::strcpy(dst.data(), s[i]));
+        });
+        double t_strncpy = ns_per_op(iters, [&](std::size_t i) {
+            bench::do_not_optimize(std::strncpy(dst.data(), s[i], cap));
+        });
+        double t_snprintf = ns_per_op(iters, [&](std::size_t i) {
+            bench::do_not_optimize(std::snprintf(dst.data(), cap, "%s", s[i]));
+        });
+        double t_memcpy = ns_per_op(iters, [&](std::size_t i) {
+            bench::do_not_optimize(std::memcpy(dst.data(), s[i], len + 1u));
+        });
+        std::printf("%6zu %9.2f %9.2f %9.2f %9.2f | %9.2f %9.2f", len, t_strlen, t_strnlen,
+                    t_strcpy, t_strncpy, t_snprintf, t_memcpy);
+
+        for (bstr_impl_t impl : impls) {
+            if (bstr_select_impl(impl)) {
+                double t_nlen = ns_per_op(iters, [&](std::size_t i) {
+                    bench::do_not_optimize(bstr_nlen(s[i], cap));
+                });
+                double t_copy = ns_per_op(iters, [&](std::size_t i) {
+                    bench::do_not_optimize(bstr_copy(dst.data(), cap, s[i], nullptr));
+                });
+                std::printf(" | %12.2f %12.2f", t_nlen, t_copy);
+            }
+        }
+        std::printf("\n");
+        static_cast<void>(bstr_select_impl(BSTR_IMPL_AUTO));
+    }
+    return 0;
+}
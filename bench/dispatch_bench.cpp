@@ -0,0 +1,301 @@
+/**
+ * @file dispatch_bench.cpp
+ * @brief Sixteen-way dispatch on an integer key: an if-else-if chain vs a
+ * switch vs a cs::dispatch_table, for values and for handlers.
+ *
+ *   value     key -> constant; the table is a lookup table
+ *   handler   key -> call of one of sixteen non-inlined functions; the
+ *             table is a jump table
+ *
+ * Keys 0..15 are declared, and 16..19 fall to the default (the final else
+ * of the chain, the switch's default). Each variant maps a stream of
+ * kInputs keys, in cache, in two distributions:
+ *
+ *   uniform   every key 0..19 equally likely: a data-dependent branch
+ *             mispredicts on most keys
+ *   skewed    nine keys in ten are kHotKey, the rest uniform: branches
+ *             mostly predict, and the chain still makes kHotKey + 1 tests
+ *
+ * At -O2 and above GCC turns a chain of == tests on one variable into a
+ * switch, and a switch into a lookup table (values) or jump table
+ * (handlers) with a branch for the default. The chains here are compiled
+ * with those conversions off so they run as written; the switches are
+ * left as GCC compiles them. The cs::dispatch_table lookup has no branch
+ * at all, and its jump table only the indirect call.
+ */
+
+#include "bench.hpp"
+#include "dispatch.hpp"
+#include "prng.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+constexpr std::uint32_t kInputs = 1u << 14;  // 64 KiB of keys
+constexpr std::uint32_t kKeySpan = 20u;      // 16 declared keys and 4 defaults
+constexpr std::int32_t kHotKey = 11;
+
+std::int32_t g_uniform[kInputs];
+std::int32_t g_skewed[kInputs];
+const std::int32_t *g_keys = g_uniform;
+
+/* Keeps a chain of == tests a chain of compares and branches, as it is
+ * wherever the tests are not all on one variable */
+#define CHAIN_AS_WRITTEN                                                           \
+    __attribute__((noinline,                                                       \
+                   optimize("no-jump-tables", "no-tree-switch-conversion", "no-bit-tests")))
+
+/* ---- Values ------------------------------------------------------------ */
+
+CHAIN_AS_WRITTEN std::int32_t value_chain(std::int32_t key) {
+    std::int32_t r = 0;
+    if (key == 0) {
+        r = 3;
+    } else if (key == 1) {
+        r = 41;
+    } else if (key == 2) {
+        r = 17;
+    } else if (key == 3) {
+        r = 96;
+    } else if (key == 4) {
+        r = 5;
+    } else if (key == 5) {
+        r = 250;
+    } else if (key == 6) {
+        r = 64;
+    } else if (key == 7) {
+        r = 12;
+    } else if (key == 8) {
+        r = 77;
+    } else if (key == 9) {
+        r = 1000;
+    } else if (key == 10) {
+        r = 8;
+    } else if (key == 11) {
+        r = 33;
+    } else if (key == 12) {
+        r = 420;
+    } else if (key == 13) {
+        r = 9;
+    } else if (key == 14) {
+        r = 150;
+    } else if (key == 15) {
+        r = 71;
+    } else {
+        r = -1;
+    }
+    return r;
+}
+
+__attribute__((noinline)) std::int32_t value_switch(std::int32_t key) {
+    std::int32_t r = 0;
+    switch (key) {
+        case 0: r = 3; break;
+        case 1: r = 41; break;
+        case 2: r = 17; break;
+        case 3: r = 96; break;
+        case 4: r = 5; break;
+        case 5: r = 250; break;
+        case 6: r = 64; break;
+        case 7: r = 12; break;
+        case 8: r = 77; break;
+        case 9: r = 1000; break;
+        case 10: r = 8; break;
+        case 11: r = 33; break;
+        case 12: r = 420; break;
+        case 13: r = 9; break;
+        case 14: r = 150; break;
+        case 15: r = 71; break;
+        default: r = -1; break;
+    }
+    return r;
+}
+
+constexpr auto kValues = cs::make_dispatch_table<0, 15>(
+    std::int32_t{-1}, cs::on(0, std::int32_t{3}), cs::on(1, std::int32_t{41}),
+    cs::on(2, std::int32_t{17}), cs::on(3, std::int32_t{96}), cs::on(4, std::int32_t{5}),
+    cs::on(5, std::int32_t{250}), cs::on(6, std::int32_t{64}), cs::on(7, std::int32_t{12}),
+    cs::on(8, std::int32_t{77}), cs::on(9, std::int32_t{1000}), cs::on(10, std::int32_t{8}),
+    cs::on(11, std::int32_t{33}), cs::on(12, std::int32_t{420}), cs::on(13, std::int32_t{9}),
+    cs::on(14, std::int32_t{150}), cs::on(15, std::int32_t{71}));
+
+static_assert(kValues[11] == 33, "declared key");
+static_assert(kValues[16] == -1, "default");
+
+__attribute__((noinline)) std::int32_t value_table(std::int32_t key) { return kValues[key]; }
+
+/* ---- Handlers ---------------------------------------------------------- */
+
+template <std::int32_t K>
+__attribute__((noinline)) std::int32_t handle(std::int32_t x) {
+    return (x * (K + 1)) + K;
+}
+
+__attribute__((noinline)) std::int32_t handle_other(std::int32_t x) { return -x; }
+
+using handler = std::int32_t (*)(std::int32_t);
+
+CHAIN_AS_WRITTEN std::int32_t handler_chain(std::int32_t key, std::int32_t x) {
+    std::int32_t r = 0;
+    if (key == 0) {
+        r = handle<0>(x);
+    } else if (key == 1) {
+        r = handle<1>(x);
+    } else if (key == 2) {
+        r = handle<2>(x);
+    } else if (key == 3) {
+        r = handle<3>(x);
+    } else if (key == 4) {
+        r = handle<4>(x);
+    } else if (key == 5) {
+        r = handle<5>(x);
+    } else if (key == 6) {
+        r = handle<6>(x);
+    } else if (key == 7) {
+        r = handle<7>(x);
+    } else if (key == 8) {
+        r = handle<8>(x);
+    } else if (key == 9) {
+        r = handle<9>(x);
+    } else if (key == 10) {
+        r = handle<10>(x);
+    } else if (key == 11) {
+        r = handle<11>(x);
+    } else if (key == 12) {
+        r = handle<12>(x);
+    } else if (key == 13) {
+        r = handle<13>(x);
+    } else if (key == 14) {
+        r = handle<14>(x);
+    } else if (key == 15) {
+        r = handle<15>(x);
+    } else {
+        r = handle_other(x);
+    }
+    return r;
+}
+
+__attribute__((noinline)) std::int32_t handler_switch(std::int32_t key, std::int32_t x) {
+    std::int32_t r = 0;
+    switch (key) {
+        case 0: r = handle<0>(x); break;
+        case 1: r = handle<1>(x); break;
+        case 2: r = handle<2>(x); break;
+        case 3: r = handle<3>(x); break;
+        case 4: r = handle<4>(x); break;
+        case 5: r = handle<5>(x); break;
+        case 6: r = handle<6>(x); break;
+        case 7: r = handle<7>(x); break;
+        case 8: r = handle<8>(x); break;
+        case 9: r = handle<9>(x); break;
+        case 10: r = handle<10>(x); break;
+        case 11: r = handle<11>(x); break;
+        case 12: r = handle<12>(x); break;
+        case 13: r = handle<13>(x); break;
+        case 14: r = handle<14>(x); break;
+        case 15: r = handle<15>(x); break;
+        default: r = handle_other(x); break;
+    }
+    return r;
+}
+
+constexpr auto kHandlers = cs::make_dispatch_table<0, 15>(
+    handler{&handle_other}, cs::on(0, handler{&handle<0>}), cs::on(1, handler{&handle<1>}),
+    cs::on(2, handler{&handle<2>}), cs::on(3, handler{&handle<3>}),
+    cs::on(4, handler{&handle<4>}), cs::on(5, handler{&handle<5>}),
+    cs::on(6, handler{&handle<6>}), cs::on(7, handler{&handle<7>}),
+    cs::on(8, handler{&handle<8>}), cs::on(9, handler{&handle<9>}),
+    cs::on(10, handler{&handle<10>}), cs::on(11, handler{&handle<11>}),
+    cs::on(12, handler{&handle<12>}), cs::on(13, handler{&handle<13>}),
+    cs::on(14, handler{&handle<14>}), cs::on(15, handler{&handle<15>}));
+
+__attribute__((noinline)) std::int32_t handler_table(std::int32_t key, std::int32_t x) {
+    return kHandlers(key, x);
+}
+
+/* ---- Loops ------------------------------------------------------------- */
+
+template <std::int32_t (*F)(std::int32_t)>
+void map_values(std::uint64_t n) {
+    std::uint32_t i = 0u;
+    std::int32_t sum = 0;
+    bench::repeat(n, [&i, &sum] {
+        sum += F(g_keys[i]);
+        i = (i + 1u) & (kInputs - 1u);
+    });
+    bench::do_not_optimize(sum);
+}
+
+template <std::int32_t (*F)(std::int32_t, std::int32_t)>
+void call_handlers(std::uint64_t n) {
+    std::uint32_t i = 0u;
+    std::int32_t sum = 0;
+    bench::repeat(n, [&i, &sum] {
+        sum += F(g_keys[i], static_cast<std::int32_t>(i));
+        i = (i + 1u) & (kInputs - 1u);
+    });
+    bench::do_not_optimize(sum);
+}
+
+struct bench_case {
+    const char *name;
+    void (*fn)(std::uint64_t);
+};
+
+const bench_case kCases[] = {
+    {"value if-chain", map_values<value_chain>},
+    {"value switch", map_values<value_switch>},
+    {"value table", map_values<value_table>},
+    {"handler if-chain", call_handlers<handler_chain>},
+    {"handler switch", call_handlers<handler_switch>},
+    {"handler table", call_handlers<handler_table>},
+};
+
+void fill_inputs() {
+    xoshiro256_t rng;
+    xoshiro256_seed(&rng, 42u);
+    for (std::uint32_t i = 0u; i < kInputs; ++i) {
+        g_uniform[i] = static_cast<std::int32_t>(xoshiro256_next(&rng) % kKeySpan);
+        g_skewed[i] = ((xoshiro256_next(&rng) % 10u) != 0u)
+                          ? kHotKey
+                          : static_cast<std::int32_t>(xoshiro256_next(&rng) % kKeySpan);
+    }
+}
+
+/* Every variant must agree with the table on every key before it is timed */
+bool outputs_agree() {
+    bool ok = true;
+    for (std::int32_t key = -2; key < static_cast<std::int32_t>(kKeySpan) + 2; ++key) {
+        const std::int32_t v = value_table(key);
+        const std::int32_t h = handler_table(key, 7);
+        if ((value_chain(key) != v) || (value_switch(key) != v) ||
+            (handler_chain(key, 7) != h) || (handler_switch(key, 7) != h)) {
+            std::fprintf(stderr, "dispatch_bench: variants disagree on key %d\n", key);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main() {
+    fill_inputs();
+    if (!outputs_agree()) {
+        return 1;
+    }
+    bench::cycle_counter cycles;
+    std::printf("%-18s %12s %12s %12s %12s\n", "case", "uniform ns", "uniform cyc", "skewed ns",
+                "skewed cyc");
+    for (const bench_case &c : kCases) {
+        g_keys = g_uniform;
+        const bench::measurement u = bench::measure(c.fn, cycles, 0.25, 5);
+        g_keys = g_skewed;
+        const bench::measurement s = bench::measure(c.fn, cycles, 0.25, 5);
+        std::printf("%-18s %12.2f %12.2f %12.2f %12.2f\n", c.name, u.ns_per_op, u.cycles_per_op,
+                    s.ns_per_op, s.cycles_per_op);
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file expected_bench.cpp
+ * @brief Error propagation cost: throw/catch versus returning
+ * cs::expected, across error rates and call-stack depths.
+ *
+ * Each call descends `depth` out-of-line frames; the innermost one fails
+ * according to a precomputed pattern with the given error rate. The
+ * exception version throws std::runtime_error there and catches it at the
+ * top by reference; the expected version returns the error and every frame
+ * checks and forwards it. Times are ns per top-level call, best of kReps.
+ *
+ * At a 0% error rate the exception path is the "zero-cost" happy path;
+ * the expected path still pays one test per frame. Each thrown error costs
+ * an allocation plus unwinding through every frame, so the two cross over
+ * at a low error rate. Both jump at depth 64, where the call chain outruns
+ * the CPU's return-address predictor.
+ */
+
+#include "bench.hpp"
+#include "expected.hpp"
+#include "prng.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kPattern = 4096u;
+constexpr std::size_t kCalls = 50000u;
+constexpr int kReps = 3;
+
+using result = cs::expected<std::int32_t, std::errc>;
+
+__attribute__((noinline)) std::int32_t leaf_throw(std::int32_t v, bool fail) {
+    if (fail) {
+        throw std::runtime_error("leaf failed");
+    }
+    return v + 1;
+}
+
+__attribute__((noinline)) std::int32_t frame_throw(std::int32_t depth, std::int32_t v, bool fail) {
+    std::int32_t r = 0;
+    if (depth <= 1) {
+        r = leaf_throw(v, fail);
+    } else {
+        r = frame_throw(depth - 1, v, fail) + 1;
+    }
+    return r;
+}
+
+__attribute__((noinline)) result leaf_result(std::int32_t v, bool fail) {
+    result r = v + 1;
+    if (fail) {
+        r = cs::make_unexpected(std::errc::io_error);
+    }
+    return r;
+}
+
+__attribute__((noinline)) result frame_result(std::int32_t depth, std::int32_t v, bool fail) {
+    result r = (depth <= 1) ? leaf_result(v, fail) : frame_result(depth - 1, v, fail);
+    return r.transform([](std::int32_t x) { return x + 1; });
+}
+
+std::int32_t call_throw(std::int32_t depth, std::int32_t v, bool fail) {
+    std::int32_t r = 0;
+    try {
+        r = frame_throw(depth, v, fail);
+    } catch (const std::runtime_error &e) {
+        bench::do_not_optimize(e.what());
+        r = -1;
+    }
+    return r;
+}
+
+std::int32_t call_result(std::int32_t depth, std::int32_t v, bool fail) {
+    return frame_result(depth, v, fail).value_or(-1);
+}
+
+template <typename F>
+double best_ns_per_call(const std::vector<char> &pattern, std::int32_t depth, F call) {
+    double best = 1e300;
+    for (int rep = 0; rep < kReps; ++rep) {
+        std::uint64_t t0 = bench::now_ns();
+        for (std::size_t i = 0u; i < kCalls; ++i) {
+            bool fail = pattern[i % kPattern] != 0;
+            bench::do_not_optimize(call(bench::opaque(depth), static_cast<std::int32_t>(i), fail));
+        }
+        double ns = static_cast<double>(bench::now_ns() - t0) / static_cast<double>(kCalls);
+        best = (ns < best) ? ns : best;
+    }
+    return best;
+}
+
+}  // namespace
+
+int main() {
+    const double rates[] = {0.0, 0.001, 0.01, 0.1, 0.5};
+    const std::int32_t depths[] = {1, 4, 16, 64};
+
+    std::printf("%zu calls per case, best of %d\n", kCalls, kReps);
+    std::printf("%8s %6s %12s %12s %8s  (ns/call)\n", "errors", "depth", "throw", "expected",
+                "x throw");
+    for (double rate : rates) {
+        cs::xoshiro256 rng(42u);
+        std::vector<char> pattern(kPattern);
+        for (char &p : pattern) {
+            p = ((static_cast<double>(rng() >> 11) / 9007199254740992.0) < rate) ? 1 : 0;
+        }
+        for (std::int32_t depth : depths) {
+            double t = best_ns_per_call(pattern, depth, call_throw);
+            double r = best_ns_per_call(pattern, depth, call_result);
+            std::printf("%7.1f%% %6d %12.1f %12.1f %8.2f\n", rate * 100.0, depth, t, r, r / t);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,309 @@
+/**
+ * @file file_reader_bench.cpp
+ * @brief Reading a multi-GB text file through file_reader.h (CERT C
+ * ERR33-C) vs fopen/fread and getline, cold and warm in the page cache.
+ *
+ * Writes a file of kDefaultMiB (or argv[1]) MiB of random-length lines to
+ * argv[2] (default /tmp/file_reader_bench.txt, removed afterwards), then
+ * reads it with each method, counting lines and line bytes:
+ *
+ *   fread          1 MiB buffer, memchr for '\n'
+ *   getline        one heap-grown line at a time
+ *   mmap blocks    file_reader_next over the mapping, memchr for '\n'
+ *   mmap lines     file_reader_next_line over the mapping
+ *   stream blocks  file_reader_next over a 1 MiB page-aligned buffer
+ *   stream lines   file_reader_next_line over the same buffer
+ *   cs lines       cs::file_reader::next_line (automatic mode)
+ *
+ * Each method runs once cold, after posix_fadvise(POSIX_FADV_DONTNEED)
+ * has dropped the file from the page cache (the resident fraction is
+ * printed to show it worked), and then kWarmRuns times warm, keeping the
+ * best. Every method must agree on the counts before anything is timed.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "bench.hpp"
+#include "file_reader.h"
+#include "file_reader.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kDefaultMiB = 2048u;
+constexpr std::size_t kBlock = 1u << 20;
+constexpr int kWarmRuns = 3;
+
+struct counts {
+    std::uint64_t lines;
+    std::uint64_t bytes;  // Line bytes, excluding the '\n's
+    bool ok;
+
+    bool operator==(const counts &o) const {
+        return ok && o.ok && (lines == o.lines) && (bytes == o.bytes);
+    }
+};
+
+/* Every line ends in '\n', so newlines alone give both counts */
+void count_block(counts &c, const unsigned char *p, std::size_t len) {
+    const unsigned char *end = p + len;
+    while (p < end) {
+        const void *nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+        if (nl == nullptr) {
+            c.bytes += static_cast<std::uint64_t>(end - p);
+            p = end;
+        } else {
+            const unsigned char *q = static_cast<const unsigned char *>(nl);
+            c.bytes += static_cast<std::uint64_t>(q - p);
+            c.lines += 1u;
+            p = q + 1;
+        }
+    }
+}
+
+counts read_fread(const char *path) {
+    counts c = {0u, 0u, false};
+    std::FILE *f = std::fopen(path, "rb");
+    if (f != nullptr) {
+        std::vector<unsigned char> buf(kBlock);
+        std::size_t n = 0u;
+        while ((n = std::fread(buf.data(), 1u, buf.size(), f)) > 0u) {
+            count_block(c, buf.data(), n);
+        }
+        c.ok = (std::ferror(f) == 0);
+        c.ok = (std::fclose(f) == 0) && c.ok;
+    }
+    return c;
+}
+
+counts read_getline(const char *path) {
+    counts c = {0u, 0u, false};
+    std::FILE *f = std::fopen(path, "rb");
+    if (f != nullptr) {
+        char *line = nullptr;
+        std::size_t cap = 0u;
+        ssize_t n = 0;
+        while ((n = getline(&line, &cap, f)) > 0) {
+            const bool nl = line[n - 1] == '\n';
+            c.bytes += static_cast<std::uint64_t>(n) - (nl ? 1u : 0u);
+            c.lines += 1u;
+        }
+        std::free(line);
+        c.ok = (std::ferror(f) == 0);
+        c.ok = (std::fclose(f) == 0) && c.ok;
+    }
+    return c;
+}
+
+counts read_blocks(const char *path, file_reader_mode_t mode) {
+    counts c = {0u, 0u, false};
+    file_reader_t r;
+    int err = file_reader_open(&r, path, mode, kBlock);
+    if (err == 0) {
+        const unsigned char *data = nullptr;
+        std::size_t len = 0u;
+        while (((err = file_reader_next(&r, &data, &len)) == 0) && (len > 0u)) {
+            count_block(c, data, len);
+        }
+        const int close_err = file_reader_close(&r);
+        c.ok = (err == 0) && (close_err == 0);
+    }
+    return c;
+}
+
+counts read_lines(const char *path, file_reader_mode_t mode) {
+    counts c = {0u, 0u, false};
+    file_reader_t r;
+    int err = file_reader_open(&r, path, mode, kBlock);
+    if (err == 0) {
+        const char *line = nullptr;
+        std::size_t len = 0u;
+        while (((err = file_reader_next_line(&r, &line, &len)) == 0) && (line != nullptr)) {
+            c.bytes += len;
+            c.lines += 1u;
+        }
+        const int close_err = file_reader_close(&r);
+        c.ok = (err == 0) && (close_err == 0);
+    }
+    return c;
+}
+
+counts read_cs_lines(const char *path) {
+    counts c = {0u, 0u, false};
+    cs::expected<cs::file_reader, std::errc> f = cs::file_reader::open(path);
+    if (f.has_value()) {
+        cs::string_view line;
+        cs::expected<bool, std::errc> more = f.value().next_line(line);
+        while (more.has_value() && more.value()) {
+            c.bytes += line.size();
+            c.lines += 1u;
+            more = f.value().next_line(line);
+        }
+        c.ok = more.has_value() && f.value().close().has_value();
+    }
+    return c;
+}
+
+counts mmap_blocks(const char *path) { return read_blocks(path, FILE_READER_MAP); }
+counts mmap_lines(const char *path) { return read_lines(path, FILE_READER_MAP); }
+counts stream_blocks(const char *path) { return read_blocks(path, FILE_READER_STREAM); }
+counts stream_lines(const char *path) { return read_lines(path, FILE_READER_STREAM); }
+
+/* ---- File setup -------------------------------------------------------- */
+
+bool write_input(const char *path, std::size_t bytes) {
+    std::FILE *f = std::fopen(path, "wb");
+    bool ok = f != nullptr;
+    std::vector<unsigned char> block(kBlock);
+    std::uint64_t s = 0x9E3779B97F4A7C15u;
+    std::size_t written = 0u;
+    std::size_t line_left = 0u;
+    while (ok && (written < bytes)) {
+        const std::size_t n = (bytes - written < block.size()) ? (bytes - written) : block.size();
+        for (std::size_t i = 0u; i < n; ++i) {
+            s ^= s << 13;
+            s ^= s >> 7;
+            s ^= s << 17;
+            if (line_left == 0u) {
+                block[i] = '\n';
+                line_left = 1u + static_cast<std::size_t>(s % 120u);
+            } else {
+                block[i] = static_cast<unsigned char>('a' + (s % 26u));
+                --line_left;
+            }
+        }
+        // Keep every line newline-terminated, including the last
+        if (written + n == bytes) {
+            block[n - 1u] = '\n';
+        }
+        ok = std::fwrite(block.data(), 1u, n, f) == n;
+        written += n;
+    }
+    if (f != nullptr) {
+        ok = (std::fflush(f) == 0) && (fsync(fileno(f)) == 0) && ok;
+        ok = (std::fclose(f) == 0) && ok;
+    }
+    return ok;
+}
+
+/** Drop the file's clean pages from the page cache. */
+void drop_cache(const char *path) {
+    const int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        static_cast<void>(posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED));
+        static_cast<void>(close(fd));
+    }
+}
+
+/** Fraction of the file's pages currently in the page cache. */
+double cached_fraction(const char *path) {
+    double fraction = -1.0;
+    const int fd = open(path, O_RDONLY);
+    struct stat st;
+    if ((fd >= 0) && (fstat(fd, &st) == 0) && (st.st_size > 0)) {
+        const std::size_t len = static_cast<std::size_t>(st.st_size);
+        void *p = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+        if (p != MAP_FAILED) {
+            const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            std::vector<unsigned char> vec((len + page - 1u) / page);
+            if (mincore(p, len, vec.data()) == 0) {
+                std::size_t resident = 0u;
+                for (unsigned char v : vec) {
+                    resident += v & 1u;
+                }
+                fraction = static_cast<double>(resident) / static_cast<double>(vec.size());
+            }
+            static_cast<void>(munmap(p, len));
+        }
+    }
+    if (fd >= 0) {
+        static_cast<void>(close(fd));
+    }
+    return fraction;
+}
+
+struct method {
+    const char *name;
+    counts (*read)(const char *);
+};
+
+const method kMethods[] = {
+    {"fread", read_fread},
+    {"getline", read_getline},
+    {"mmap blocks", mmap_blocks},
+    {"mmap lines", mmap_lines},
+    {"stream blocks", stream_blocks},
+    {"stream lines", stream_lines},
+    {"cs lines", read_cs_lines},
+};
+
+double run_ms(const method &m, const char *path, const counts &expect) {
+    const std::uint64_t t0 = bench::now_ns();
+    const counts c = m.read(path);
+    const double ms = static_cast<double>(bench::now_ns() - t0) / 1e6;
+    return (c == expect) ? ms : -1.0;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const std::size_t size_mib = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : kDefaultMiB;
+    const char *path = (argc > 2) ? argv[2] : "/tmp/file_reader_bench.txt";
+    const std::size_t bytes = size_mib * 1024u * 1024u;
+    if (bytes == 0u) {
+        std::fprintf(stderr, "usage: %s [MiB] [path]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!write_input(path, bytes)) {
+        std::fprintf(stderr, "cannot write %s\n", path);
+        return EXIT_FAILURE;
+    }
+
+    // Every method must agree before anything is timed (this also warms the cache)
+    const counts expect = read_fread(path);
+    bool ok = expect.ok && (expect.lines > 0u);
+    for (const method &m : kMethods) {
+        ok = ok && (m.read(path) == expect);
+    }
+    int status = EXIT_SUCCESS;
+    if (!ok) {
+        std::fprintf(stderr, "readers disagree on %s\n", path);
+        status = EXIT_FAILURE;
+    } else {
+        const double gib = static_cast<double>(bytes) / (1024.0 * 1024.0 * 1024.0);
+        std::printf("%zu MiB, %llu lines; cold = after POSIX_FADV_DONTNEED, warm = best of %d\n",
+                    size_mib, static_cast<unsigned long long>(expect.lines), kWarmRuns);
+        std::printf("%-14s %8s %10s %10s %10s %10s\n", "method", "cached", "cold ms", "cold GB/s",
+                    "warm ms", "warm GB/s");
+        for (const method &m : kMethods) {
+            drop_cache(path);
+            const double cached = cached_fraction(path);
+            const double cold = run_ms(m, path, expect);
+            double warm = 0.0;
+            for (int i = 0; i < kWarmRuns; ++i) {
+                const double ms = run_ms(m, path, expect);
+                warm = ((i == 0) || (ms < warm)) ? ms : warm;
+            }
+            if ((cold < 0.0) || (warm < 0.0)) {
+                std::printf("%-14s read failed or miscounted\n", m.name);
+                status = EXIT_FAILURE;
+            } else {
+                std::printf("%-14s %7.0f%% %10.1f %10.2f %10.1f %10.2f\n", m.name, cached * 100.0,
+                            cold, gib / (cold / 1e3), warm, gib / (warm / 1e3));
+            }
+        }
+    }
+    if (argc <= 2) {
+        static_cast<void>(std::remove(path));
+    }
+    return status;
+}
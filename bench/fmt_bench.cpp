@@ -0,0 +1,290 @@
+/**
+ * @file fmt_bench.cpp
+ * @brief snprintf/fprintf versus cs::format_to (fmt.hpp) on three
+ * log-shaped workloads.
+ *
+ *   log      timestamp, level, ids, status, a latency and a path
+ *   ints     five integers, decimal, hex and zero-padded
+ *   floats   four doubles at precisions 2..9
+ *
+ * Each workload is formatted into a 256-byte buffer (snprintf vs
+ * cs::format_to) and streamed to /dev/null (fprintf on a FILE vs a
+ * cs::fd_sink, both flushing every 4 KiB). Inputs rotate through a small
+ * table so neither side formats a constant. Before timing, every input is
+ * formatted both ways and the bytes compared; a mismatch fails the run.
+ */
+
+#include "bench.hpp"
+#include "fmt.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kInputs = 64u;
+constexpr std::size_t kLine = 256u;
+
+struct log_input {
+    const char *stamp;
+    const char *level;
+    std::uint64_t request;
+    std::int32_t status;
+    double latency_ms;
+    const char *path;
+};
+
+struct int_input {
+    std::int32_t a;
+    std::uint32_t b;
+    std::int64_t c;
+    std::uint64_t d;
+    std::uint32_t e;
+};
+
+struct float_input {
+    double a;
+    double b;
+    double c;
+    double d;
+};
+
+log_input g_log[kInputs];
+int_input g_ints[kInputs];
+float_input g_floats[kInputs];
+FILE *g_file = nullptr;
+int g_fd = -1;
+
+void make_inputs() {
+    static const char *const kLevels[] = {"INFO", "WARN", "ERROR", "DEBUG"};
+    static const char *const kPaths[] = {"/", "/index.html", "/api/v1/items/4711",
+                                         "/static/app.js"};
+    std::uint64_t x = 0x9E3779B97F4A7C15u;
+    for (std::size_t i = 0u; i < kInputs; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        g_log[i] = log_input{"2024-05-17T12:34:56Z", kLevels[i % 4u], x % 10000000000u,
+                             (i % 7u == 0u) ? 500 : 200,
+                             static_cast<double>(x % 100000u) / 997.0, kPaths[(i / 4u) % 4u]};
+        g_ints[i] = int_input{static_cast<std::int32_t>(x) / 3, static_cast<std::uint32_t>(x >> 32),
+                              -static_cast<std::int64_t>(x >> 3), x, static_cast<std::uint32_t>(x % 65536u)};
+        g_floats[i] = float_input{static_cast<double>(x % 1000000u) / 7.0,
+                                  static_cast<double>(x % 1000u) / 1e4,
+                                  -static_cast<double>(x % 100000000u) / 3.0,
+                                  static_cast<double>(x % 97u) * 1e6};
+    }
+}
+
+/* ---- The three workloads, once per output style ------------------------- */
+
+int log_printf(char *buf, const log_input &in) {
+    return std::snprintf(buf, kLine, "%s [%s] req=%llu status=%d latency=%.3f ms path=%s\n",
+                         in.stamp, in.level, static_cast<unsigned long long>(in.request),
+                         in.status, in.latency_ms, in.path);
+}
+
+template <typename Sink>
+void log_fmt(Sink &sink, const log_input &in) {
+    cs::format_to(sink, CS_FMT("{} [{}] req={} status={} latency={:.3} ms path={}\n"), in.stamp,
+                  in.level, in.request, in.status, in.latency_ms, in.path);
+}
+
+int ints_printf(char *buf, const int_input &in) {
+    return std::snprintf(buf, kLine, "a=%d b=%u c=%lld d=%llx e=%08u\n", in.a, in.b,
+                         static_cast<long long>(in.c), static_cast<unsigned long long>(in.d),
+                         in.e);
+}
+
+template <typename Sink>
+void ints_fmt(Sink &sink, const int_input &in) {
+    cs::format_to(sink, CS_FMT("a={} b={} c={} d={:x} e={:08}\n"), in.a, in.b, in.c, in.d, in.e);
+}
+
+int floats_printf(char *buf, const float_input &in) {
+    return std::snprintf(buf, kLine, "%.2f %.4f %.6f %.9f\n", in.a, in.b, in.c, in.d);
+}
+
+template <typename Sink>
+void floats_fmt(Sink &sink, const float_input &in) {
+    cs::format_to(sink, CS_FMT("{:.2} {:.4} {} {:.9}\n"), in.a, in.b, in.c, in.d);
+}
+
+/* ---- Output check ------------------------------------------------------ */
+
+template <typename In, typename P, typename F>
+bool same_output(const char *name, const In *inputs, P with_printf, F with_fmt) {
+    bool ok = true;
+    for (std::size_t i = 0u; ok && (i < kInputs); ++i) {
+        char want[kLine];
+        char got[kLine];
+        static_cast<void>(with_printf(want, inputs[i]));
+        cs::buffer_sink sink(got, sizeof(got));
+        with_fmt(sink, inputs[i]);
+        static_cast<void>(sink.finish());
+        if (std::strcmp(want, got) != 0) {
+            std::fprintf(stderr, "%s: output differs\n  printf: %s  fmt:    %s", name, want, got);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/* ---- Timed cases ------------------------------------------------------- */
+
+template <typename In, typename P>
+void to_buffer_printf(std::uint64_t n, const In *inputs, P with_printf) {
+    char buf[kLine];
+    std::size_t i = 0u;
+    bench::repeat(n, [&] {
+        bench::do_not_optimize(with_printf(buf, inputs[i]));
+        i = (i + 1u) % kInputs;
+    });
+    bench::do_not_optimize(buf);
+}
+
+template <typename In, typename F>
+void to_buffer_fmt(std::uint64_t n, const In *inputs, F with_fmt) {
+    char buf[kLine];
+    std::size_t i = 0u;
+    bench::repeat(n, [&] {
+        cs::buffer_sink sink(buf, sizeof(buf));
+        with_fmt(sink, inputs[i]);
+        bench::do_not_optimize(sink.finish());
+        i = (i + 1u) % kInputs;
+    });
+    bench::do_not_optimize(buf);
+}
+
+void log_snprintf(std::uint64_t n) { to_buffer_printf(n, g_log, log_printf); }
+void ints_snprintf(std::uint64_t n) { to_buffer_printf(n, g_ints, ints_printf); }
+void floats_snprintf(std::uint64_t n) { to_buffer_printf(n, g_floats, floats_printf); }
+
+void log_format_to(std::uint64_t n) {
+    to_buffer_fmt(n, g_log, [](cs::buffer_sink &s, const log_input &in) { log_fmt(s, in); });
+}
+void ints_format_to(std::uint64_t n) {
+    to_buffer_fmt(n, g_ints, [](cs::buffer_sink &s, const int_input &in) { ints_fmt(s, in); });
+}
+void floats_format_to(std::uint64_t n) {
+    to_buffer_fmt(n, g_floats, [](cs::buffer_sink &s, const float_input &in) { floats_fmt(s, in); });
+}
+
+void log_fprintf(std::uint64_t n) {
+    std::size_t i = 0u;
+    bench::repeat(n, [&i] {
+        const log_input &in = g_log[i];
+        std::fprintf(g_file, "%s [%s] req=%llu status=%d latency=%.3f ms path=%s\n", in.stamp,
+                     in.level, static_cast<unsigned long long>(in.request), in.status,
+                     in.latency_ms, in.path);
+        i = (i + 1u) % kInputs;
+    });
+    std::fflush(g_file);
+}
+
+void ints_fprintf(std::uint64_t n) {
+    std::size_t i = 0u;
+    bench::repeat(n, [&i] {
+        const int_input &in = g_ints[i];
+        std::fprintf(g_file, "a=%d b=%u c=%lld d=%llx e=%08u\n", in.a, in.b,
+                     static_cast<long long>(in.c), static_cast<unsigned long long>(in.d), in.e);
+        i = (i + 1u) % kInputs;
+    });
+    std::fflush(g_file);
+}
+
+void floats_fprintf(std::uint64_t n) {
+    std::size_t i = 0u;
+    bench::repeat(n, [&i] {
+        const float_input &in = g_floats[i];
+        std::fprintf(g_file, "%.2f %.4f %.6f %.9f\n", in.a, in.b, in.c, in.d);
+        i = (i + 1u) % kInputs;
+    });
+    std::fflush(g_file);
+}
+
+template <typename In, typename F>
+void to_fd(std::uint64_t n, const In *inputs, F with_fmt) {
+    cs::fd_sink sink(g_fd);
+    std::size_t i = 0u;
+    bench::repeat(n, [&] {
+        with_fmt(sink, inputs[i]);
+        i = (i + 1u) % kInputs;
+    });
+    static_cast<void>(sink.flush());
+}
+
+void log_fd_sink(std::uint64_t n) {
+    to_fd(n, g_log, [](cs::fd_sink &s, const log_input &in) { log_fmt(s, in); });
+}
+void ints_fd_sink(std::uint64_t n) {
+    to_fd(n, g_ints, [](cs::fd_sink &s, const int_input &in) { ints_fmt(s, in); });
+}
+void floats_fd_sink(std::uint64_t n) {
+    to_fd(n, g_floats, [](cs::fd_sink &s, const float_input &in) { floats_fmt(s, in); });
+}
+
+struct workload {
+    const char *name;
+    void (*snprintf_fn)(std::uint64_t);
+    void (*format_to_fn)(std::uint64_t);
+    void (*fprintf_fn)(std::uint64_t);
+    void (*fd_sink_fn)(std::uint64_t);
+};
+
+const workload kWorkloads[] = {
+    {"log", log_snprintf, log_format_to, log_fprintf, log_fd_sink},
+    {"ints", ints_snprintf, ints_format_to, ints_fprintf, ints_fd_sink},
+    {"floats", floats_snprintf, floats_format_to, floats_fprintf, floats_fd_sink},
+};
+
+void row(const char *name, const char *how, const bench::measurement &m,
+         const bench::measurement &ref) {
+    std::printf("%-8s %-16s %10.1f %10.1f %8.2f\n", name, how, m.ns_per_op, m.cycles_per_op,
+                m.ns_per_op / ref.ns_per_op);
+}
+
+}  // namespace
+
+int main() {
+    make_inputs();
+    g_fd = open("/dev/null", O_WRONLY);
+    g_file = (g_fd >= 0) ? fdopen(dup(g_fd), "w") : nullptr;
+    if (g_file == nullptr) {
+        std::perror("/dev/null");
+        return EXIT_FAILURE;
+    }
+    static char file_buf[4096];
+    static_cast<void>(std::setvbuf(g_file, file_buf, _IOFBF, sizeof(file_buf)));
+
+    const bool ok =
+        same_output("log", g_log, log_printf,
+                    [](cs::buffer_sink &s, const log_input &in) { log_fmt(s, in); }) &&
+        same_output("ints", g_ints, ints_printf,
+                    [](cs::buffer_sink &s, const int_input &in) { ints_fmt(s, in); }) &&
+        same_output("floats", g_floats, floats_printf,
+                    [](cs::buffer_sink &s, const float_input &in) { floats_fmt(s, in); });
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+
+    bench::cycle_counter cycles;
+    std::printf("%-8s %-16s %10s %10s %8s\n", "workload", "formatter", "ns/line", "cycles",
+                "x printf");
+    for (const workload &w : kWorkloads) {
+        const bench::measurement buf_ref = bench::measure(w.snprintf_fn, cycles, 0.25, 5);
+        row(w.name, "snprintf", buf_ref, buf_ref);
+        row(w.name, "cs::format_to", bench::measure(w.format_to_fn, cycles, 0.25, 5), buf_ref);
+        const bench::measurement fd_ref = bench::measure(w.fprintf_fn, cycles, 0.25, 5);
+        row(w.name, "fprintf", fd_ref, fd_ref);
+        row(w.name, "cs::fd_sink", bench::measure(w.fd_sink_fn, cycles, 0.25, 5), fd_ref);
+    }
+    std::fclose(g_file);
+    close(g_fd);
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file int_convert_bench.cpp
+ * @brief Bulk conversion kernels vs plain casts on large arrays.
+ *
+ * Inputs are mostly in range with a sprinkling of out-of-range values, the
+ * shape of real sensor/telemetry data. Reported as ns per element and
+ * GB/s of input consumed; "plain" is the unchecked static_cast loop.
+ */
+
+#include "bench.hpp"
+#include "int_convert.h"
+#include "int_convert.hpp"
+#include "prng.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElems = 16u * 1024u * 1024u;
+constexpr int kReps = 5;
+
+template <typename From, typename To>
+std::vector<From> make_input(std::size_t n) {
+    cs::xoshiro256 rng(42u);
+    std::vector<From> v(n);
+    for (std::size_t i = 0u; i < n; ++i) {
+        std::uint64_t r = rng();
+        // ~1 in 64 values lies outside To's range
+        v[i] = ((r & 63u) == 0u) ? std::numeric_limits<From>::max()
+                                 : static_cast<From>(cs::wrap_cast<To>(r >> 8));
+    }
+    return v;
+}
+
+template <typename F>
+double best_ns(F fn) {
+    double best = 1e300;
+    for (int r = 0; r < kReps; ++r) {
+        std::uint64_t t0 = bench::now_ns();
+        fn();
+        bench::clobber_memory();
+        double ns = static_cast<double>(bench::now_ns() - t0);
+        best = (ns < best) ? ns : best;
+    }
+    return best;
+}
+
+void row(const char *pair, const char *kernel, double ns, std::size_t in_bytes) {
+    std::printf("%-12s %-14s %10.3f %10.2f\n", pair, kernel, ns / static_cast<double>(kElems),
+                static_cast<double>(in_bytes) / ns);
+}
+
+template <typename From, typename To, typename CSat>
+void compare(const char *pair, CSat c_sat_n) {
+    std::vector<From> in = make_input<From, To>(kElems);
+    std::vector<To> out(kElems);
+    std::size_t bytes = kElems * sizeof(From);
+    std::size_t lossy = 0u;
+
+    row(pair, "plain cast", best_ns([&] {
+            for (std::size_t i = 0u; i < kElems; ++i) {
+                out[i] = static_cast<To>(in[i]);
+            }
+            bench::do_not_optimize(out.data());
+        }),
+        bytes);
+    row(pair, "cs::wrap_n", best_ns([&] { lossy = cs::wrap_n(in.data(), out.data(), kElems); }),
+        bytes);
+    row(pair, "cs::saturate_n",
+        best_ns([&] { lossy = cs::saturate_n(in.data(), out.data(), kElems); }), bytes);
+    row(pair, "C sat_*_n", best_ns([&] { lossy = c_sat_n(in.data(), out.data(), kElems); }),
+        bytes);
+    bench::do_not_optimize(lossy);
+}
+
+}  // namespace
+
+int main() {
+    std::printf("%zu elements, best of %d\n", kElems, kReps);
+    std::printf("%-12s %-14s %10s %10s\n", "pair", "kernel", "ns/elem", "GB/s");
+    compare<std::int32_t, std::int16_t>("i32->i16", sat_i32_to_i16_n);
+    compare<std::int32_t, std::uint8_t>("i32->u8", sat_i32_to_u8_n);
+    compare<std::uint32_t, std::int32_t>("u32->i32", sat_u32_to_i32_n);
+    compare<std::int64_t, std::int32_t>("i64->i32", sat_i64_to_i32_n);
+    compare<std::uint64_t, std::uint32_t>("u64->u32", sat_u64_to_u32_n);
+    return 0;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file lazy_init_bench.cpp
+ * @brief Startup cost of eager static initialisation versus cs::lazy
+ * globals, plus the cost of a lazy access once constructed.
+ *
+ * The program defines kGlobals lookup-table globals (a 1 KiB
+ * std::vector<std::uint32_t> each). The Makefile builds it twice: as
+ * bench/lazy_init_bench with cs::lazy globals, and with
+ * -DLAZY_BENCH_EAGER as bench/lazy_init_bench_eager, where every table is
+ * built by a dynamic initialiser before main(). The lazy build spawns both
+ * binaries repeatedly and reports:
+ *
+ *   to main    spawn to the first line of main(), median
+ *   touch      time for main() to read the first K tables
+ *
+ * It then times the constructed-object fast path against a plain global,
+ * and checks that threads racing on an untouched global run its init
+ * exactly once.
+ */
+
+#include "bench.hpp"
+#include "expected.hpp"
+#include "lazy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace {
+
+constexpr std::size_t kGlobals = 1024u;
+constexpr std::size_t kTableSize = 256u;
+constexpr int kRuns = 30;
+
+using table = std::vector<std::uint32_t>;
+
+std::atomic<std::uint32_t> g_inits{0u};
+
+/** A CRC-style table: the kind of global that is cheap to use, costly to build. */
+table make_table(std::size_t seed) {
+    table t(kTableSize);
+    std::uint32_t poly = 0xEDB88320u ^ static_cast<std::uint32_t>(seed);
+    for (std::size_t i = 0u; i < kTableSize; ++i) {
+        std::uint32_t c = static_cast<std::uint32_t>(i);
+        for (int k = 0; k < 8; ++k) {
+            c = ((c & 1u) != 0u) ? (poly ^ (c >> 1)) : (c >> 1);
+        }
+        t[i] = c;
+    }
+    return t;
+}
+
+template <std::size_t I>
+cs::expected<table, std::errc> init_table() {
+    g_inits.fetch_add(1u, std::memory_order_relaxed);
+    return make_table(I);
+}
+
+template <std::size_t I>
+struct global {
+#if defined(LAZY_BENCH_EAGER)
+    static table value;
+#else
+    static cs::lazy<table, std::errc> value;
+#endif
+};
+
+#if defined(LAZY_BENCH_EAGER)
+template <std::size_t I>
+table global<I>::value = make_table(I);
+
+template <std::size_t I>
+const table *get_table() {
+    return &global<I>::value;
+}
+#else
+template <std::size_t I>
+cs::lazy<table, std::errc> global<I>::value(init_table<I>);
+
+template <std::size_t I>
+const table *get_table() {
+    return global<I>::value.get().value();
+}
+#endif
+
+using getter = const table *(*)();
+
+template <std::size_t... Is>
+constexpr std::array<getter, sizeof...(Is)> make_getters(std::index_sequence<Is...>) {
+    return {{&get_table<Is>...}};
+}
+
+const std::array<getter, kGlobals> kTables = make_getters(std::make_index_sequence<kGlobals>{});
+
+/** Child: report when main() started and how long reading `touch` tables took. */
+int child(std::size_t touch) {
+    std::uint64_t t_main = bench::now_ns();
+    std::uint32_t sum = 0u;
+    for (std::size_t i = 0u; i < touch; ++i) {
+        sum += (*kTables[i]())[i % kTableSize];
+    }
+    std::uint64_t t_touch = bench::now_ns();
+    bench::do_not_optimize(sum);
+    std::printf("%llu %llu\n", static_cast<unsigned long long>(t_main),
+                static_cast<unsigned long long>(t_touch - t_main));
+    return 0;
+}
+
+#if !defined(LAZY_BENCH_EAGER)
+
+struct startup {
+    double to_main_us;
+    double touch_us;
+};
+
+/** Spawn `path --child touch` kRuns times; medians of the two timings. */
+startup spawn_runs(const std::string &path, std::size_t touch) {
+    std::vector<double> to_main;
+    std::vector<double> touch_time;
+    std::string touch_arg = std::to_string(touch);
+    for (int r = 0; r < kRuns; ++r) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            std::perror("pipe");
+            std::exit(EXIT_FAILURE);
+        }
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+        posix_spawn_file_actions_addclose(&actions, fds[0]);
+        char *argv[] = {const_cast<char *>(path.c_str()), const_cast<char *>("--child"),
+                        const_cast<char *>(touch_arg.c_str()), nullptr};
+        pid_t pid = 0;
+        std::uint64_t t0 = bench::now_ns();
+        int rc = posix_spawn(&pid, path.c_str(), &actions, nullptr, argv, environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(fds[1]);
+        if (rc != 0) {
+            std::fprintf(stderr, "cannot run %s\n", path.c_str());
+            std::exit(EXIT_FAILURE);
+        }
+        char buf[64] = {};
+        ssize_t got = read(fds[0], buf, sizeof(buf) - 1u);
+        close(fds[0]);
+        int status = 0;
+        waitpid(pid, &status, 0);
+        unsigned long long t_main = 0u;
+        unsigned long long t_touch = 0u;
+        if ((got <= 0) || (std::sscanf(buf, "%llu %llu", &t_main, &t_touch) != 2)) {
+            std::fprintf(stderr, "%s produced no timing\n", path.c_str());
+            std::exit(EXIT_FAILURE);
+        }
+        to_main.push_back(static_cast<double>(t_main - t0) / 1e3);
+        touch_time.push_back(static_cast<double>(t_touch) / 1e3);
+    }
+    std::sort(to_main.begin(), to_main.end());
+    std::sort(touch_time.begin(), touch_time.end());
+    return startup{to_main[to_main.size() / 2u], touch_time[touch_time.size() / 2u]};
+}
+
+table g_plain = make_table(0u);
+
+__attribute__((noinline)) std::uint32_t read_plain(std::size_t i) { return g_plain[i]; }
+
+__attribute__((noinline)) std::uint32_t read_lazy(std::size_t i) {
+    return (*global<0u>::value.get().value())[i];
+}
+
+template <typename F>
+double ns_per_read(F read) {
+    constexpr std::size_t kReads = 20000000u;
+    std::uint64_t t0 = bench::now_ns();
+    std::uint32_t sum = 0u;
+    for (std::size_t i = 0u; i < kReads; ++i) {
+        sum += read(i % kTableSize);
+    }
+    bench::do_not_optimize(sum);
+    return static_cast<double>(bench::now_ns() - t0) / static_cast<double>(kReads);
+}
+
+int parent(const char *argv0) {
+    const std::string self = "/proc/self/exe";
+    char path[4096] = {};
+    ssize_t len = readlink(self.c_str(), path, sizeof(path) - 1u);
+    const std::string lazy_bin = (len > 0) ? std::string(path, static_cast<std::size_t>(len))
+                                           : std::string(argv0);
+    const std::string eager_bin = lazy_bin + "_eager";
+
+    std::printf("%zu globals of %zu bytes, median of %d runs\n", kGlobals,
+                kTableSize * sizeof(std::uint32_t), kRuns);
+    std::printf("%-8s %8s %14s %12s\n", "build", "touched", "to main (us)", "touch (us)");
+    const std::size_t touches[] = {0u, kGlobals / 10u, kGlobals};
+    for (std::size_t touch : touches) {
+        startup eager = spawn_runs(eager_bin, touch);
+        startup lazy = spawn_runs(lazy_bin, touch);
+        std::printf("%-8s %8zu %14.1f %12.1f\n", "eager", touch, eager.to_main_us, eager.touch_us);
+        std::printf("%-8s %8zu %14.1f %12.1f\n", "lazy", touch, lazy.to_main_us, lazy.touch_us);
+    }
+
+    static_cast<void>(read_lazy(0u));
+    std::printf("\nread after construction: plain global %.2f ns, cs::lazy %.2f ns\n",
+                ns_per_read(read_plain), ns_per_read(read_lazy));
+
+    unsigned threads = std::max(4u, std::thread::hardware_concurrency());
+    std::uint32_t before = g_inits.load();
+    std::atomic<bool> go{false};
+    std::vector<std::thread> pool;
+    for (unsigned t = 0u; t < threads; ++t) {
+        pool.emplace_back([&go] {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            bench::do_not_optimize(kTables[kGlobals - 1u]());
+        });
+    }
+    go.store(true, std::memory_order_release);
+    for (std::thread &t : pool) {
+        t.join();
+    }
+    std::printf("%u threads racing on first use: init ran %u time(s)\n", threads,
+                g_inits.load() - before);
+    return 0;
+}
+
+#endif
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int rc = EXIT_FAILURE;
+    if ((argc == 3) && (std::string(argv[1]) == "--child")) {
+        rc = child(static_cast<std::size_t>(std::strtoul(argv[2], nullptr, 10)));
+    } else {
+#if defined(LAZY_BENCH_EAGER)
+        std::fprintf(stderr, "run bench/lazy_init_bench; this build is its eager baseline\n");
+#else
+        rc = parent(argv[0]);
+#endif
+    }
+    return rc;
+}
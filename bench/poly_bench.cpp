@@ -0,0 +1,253 @@
+/**
+ * @file poly_bench.cpp
+ * @brief Dispatch and storage cost of three ways to keep polymorphic
+ * objects in a large array: virtual calls through std::unique_ptr,
+ * cs::poly_value (virtual calls, inline storage) and CRTP (static calls).
+ *
+ * Each case sums area() over 1M shapes, once with a single type
+ * (homogeneous) and once with circles, squares and rectangles in random
+ * order (mixed). CRTP cannot put different types in one array, so its
+ * mixed case keeps one array per type, which is the usual way to apply
+ * it. The "shuffled" pointer row visits the same heap objects in random
+ * order, standing in for a heap that has seen real allocation churn.
+ *
+ * Reported: ns per element (best of kReps) and heap allocations to build
+ * the container.
+ */
+
+#include "alloc_count.hpp"
+#include "bench.hpp"
+#include "poly_value.hpp"
+#include "prng.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElems = 1u << 20;
+constexpr int kReps = 5;
+
+/* ---- Virtual hierarchy ----------------------------------------------- */
+
+class shape {
+public:
+    virtual ~shape() = default;
+    virtual double area() const = 0;
+};
+
+class circle final : public shape {
+public:
+    explicit circle(double r) noexcept : r_(r) {}
+    double area() const override { return 3.14159265358979 * r_ * r_; }
+
+private:
+    double r_;
+};
+
+class square final : public shape {
+public:
+    explicit square(double s) noexcept : s_(s) {}
+    double area() const override { return s_ * s_; }
+
+private:
+    double s_;
+};
+
+class rect final : public shape {
+public:
+    rect(double w, double h) noexcept : w_(w), h_(h) {}
+    double area() const override { return w_ * h_; }
+
+private:
+    double w_;
+    double h_;
+};
+
+using poly_shape = cs::poly_value<shape, sizeof(rect), alignof(rect)>;
+
+/* ---- CRTP hierarchy -------------------------------------------------- */
+
+template <typename D>
+class static_shape {
+public:
+    double area() const { return static_cast<const D &>(*this).area_impl(); }
+};
+
+class s_circle : public static_shape<s_circle> {
+public:
+    explicit s_circle(double r) noexcept : r_(r) {}
+    double area_impl() const { return 3.14159265358979 * r_ * r_; }
+
+private:
+    double r_;
+};
+
+class s_square : public static_shape<s_square> {
+public:
+    explicit s_square(double s) noexcept : s_(s) {}
+    double area_impl() const { return s_ * s_; }
+
+private:
+    double s_;
+};
+
+class s_rect : public static_shape<s_rect> {
+public:
+    s_rect(double w, double h) noexcept : w_(w), h_(h) {}
+    double area_impl() const { return w_ * h_; }
+
+private:
+    double w_;
+    double h_;
+};
+
+template <typename D>
+double static_sum(const std::vector<D> &v) {
+    double sum = 0.0;
+    for (const D &s : v) {
+        sum += s.area();
+    }
+    return sum;
+}
+
+/* ---- Harness --------------------------------------------------------- */
+
+template <typename F>
+double best_ns_per_elem(F fn) {
+    double best = 1e300;
+    for (int r = 0; r < kReps; ++r) {
+        std::uint64_t t0 = bench::now_ns();
+        bench::do_not_optimize(fn());
+        double ns = static_cast<double>(bench::now_ns() - t0) / static_cast<double>(kElems);
+        best = (ns < best) ? ns : best;
+    }
+    return best;
+}
+
+struct build_cost {
+    std::uint64_t allocs;
+    std::uint64_t bytes;
+};
+
+template <typename F>
+build_cost counted(F build) {
+    bench::alloc_stats &a = bench::alloc_counters();
+    std::uint64_t c0 = a.count.load();
+    std::uint64_t b0 = a.bytes.load();
+    build();
+    return build_cost{a.count.load() - c0, a.bytes.load() - b0};
+}
+
+void row(const char *mix, const char *how, double ns, const build_cost &cost) {
+    std::printf("%-12s %-22s %8.3f %10llu %12llu\n", mix, how, ns,
+                static_cast<unsigned long long>(cost.allocs),
+                static_cast<unsigned long long>(cost.bytes));
+}
+
+/** Shape kinds: all circles, or a random mix of the three. */
+std::vector<std::uint8_t> kinds(bool mixed) {
+    cs::xoshiro256 rng(11u);
+    std::vector<std::uint8_t> k(kElems, 0u);
+    if (mixed) {
+        for (std::uint8_t &x : k) {
+            x = static_cast<std::uint8_t>(rng() % 3u);
+        }
+    }
+    return k;
+}
+
+void run(const char *mix, bool mixed) {
+    const std::vector<std::uint8_t> k = kinds(mixed);
+
+    std::vector<std::unique_ptr<shape>> ptrs;
+    build_cost ptr_cost = counted([&] {
+        ptrs.reserve(kElems);
+        for (std::size_t i = 0u; i < kElems; ++i) {
+            double d = static_cast<double>(i & 15u);
+            if (k[i] == 0u) {
+                ptrs.emplace_back(new circle(d));
+            } else if (k[i] == 1u) {
+                ptrs.emplace_back(new square(d));
+            } else {
+                ptrs.emplace_back(new rect(d, 2.0));
+            }
+        }
+    });
+    auto ptr_sum = [&ptrs] {
+        double sum = 0.0;
+        for (const std::unique_ptr<shape> &p : ptrs) {
+            sum += p->area();
+        }
+        return sum;
+    };
+    row(mix, "unique_ptr<shape>", best_ns_per_elem(ptr_sum), ptr_cost);
+
+    std::vector<std::unique_ptr<shape>> shuffled = std::move(ptrs);
+    std::shuffle(shuffled.begin(), shuffled.end(), cs::xoshiro256(5u));
+    auto shuffled_sum = [&shuffled] {
+        double sum = 0.0;
+        for (const std::unique_ptr<shape> &p : shuffled) {
+            sum += p->area();
+        }
+        return sum;
+    };
+    row(mix, "unique_ptr, shuffled", best_ns_per_elem(shuffled_sum), ptr_cost);
+    shuffled.clear();
+
+    std::vector<poly_shape> values;
+    build_cost value_cost = counted([&] {
+        values.reserve(kElems);
+        for (std::size_t i = 0u; i < kElems; ++i) {
+            double d = static_cast<double>(i & 15u);
+            if (k[i] == 0u) {
+                values.emplace_back(circle(d));
+            } else if (k[i] == 1u) {
+                values.emplace_back(square(d));
+            } else {
+                values.emplace_back(rect(d, 2.0));
+            }
+        }
+    });
+    auto value_sum = [&values] {
+        double sum = 0.0;
+        for (const poly_shape &p : values) {
+            sum += p->area();
+        }
+        return sum;
+    };
+    row(mix, "poly_value<shape>", best_ns_per_elem(value_sum), value_cost);
+
+    std::vector<s_circle> circles;
+    std::vector<s_square> squares;
+    std::vector<s_rect> rects;
+    build_cost static_cost = counted([&] {
+        for (std::size_t i = 0u; i < kElems; ++i) {
+            double d = static_cast<double>(i & 15u);
+            if (k[i] == 0u) {
+                circles.emplace_back(d);
+            } else if (k[i] == 1u) {
+                squares.emplace_back(d);
+            } else {
+                rects.emplace_back(d, 2.0);
+            }
+        }
+    });
+    auto crtp_sum = [&] { return static_sum(circles) + static_sum(squares) + static_sum(rects); };
+    row(mix, "CRTP, array per type", best_ns_per_elem(crtp_sum), static_cost);
+}
+
+}  // namespace
+
+int main() {
+    std::printf("%zu shapes, best of %d; poly_value<shape> is %zu bytes\n", kElems, kReps,
+                sizeof(poly_shape));
+    std::printf("%-12s %-22s %8s %10s %12s\n", "shapes", "storage", "ns/elem", "allocs",
+                "bytes");
+    run("homogeneous", false);
+    run("mixed", true);
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file pool_bench.cpp
+ * @brief Allocation/free latency and jitter: fixed-block pool vs glibc malloc.
+ *
+ * Each case keeps a working set of live slots and toggles randomly chosen
+ * slots between allocated and free, so malloc sees a fragmenting pattern
+ * rather than a trivial LIFO. Every operation is timed individually and
+ * the per-op distribution (ticks) is reported, because the tail matters
+ * more than the mean on a hot path.
+ */
+
+#include "bench.hpp"
+#include "pool_alloc.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kSlots = 4096u;
+constexpr std::size_t kOps = 2000000u;
+
+std::uint64_t xorshift64(std::uint64_t &state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+struct result {
+    std::vector<std::uint64_t> alloc_ticks;
+    std::vector<std::uint64_t> free_ticks;
+};
+
+template <typename Alloc, typename Free>
+result run(std::size_t block_size, Alloc do_alloc, Free do_free) {
+    result r;
+    r.alloc_ticks.reserve(kOps);
+    r.free_ticks.reserve(kOps);
+    std::vector<void *> slots(kSlots, nullptr);
+    std::uint64_t rng = 0x9E3779B97F4A7C15ull;
+
+    for (std::size_t op = 0u; op < kOps; ++op) {
+        std::size_t i = static_cast<std::size_t>(xorshift64(rng) % kSlots);
+        if (slots[i] == nullptr) {
+            std::uint64_t t0 = bench::ticks();
+            void *p = do_alloc();
+            std::uint64_t t1 = bench::ticks();
+            if (p == nullptr) {
+                std::fprintf(stderr, "allocation failed\n");
+                std::exit(EXIT_FAILURE);
+            }
+            // Touch the block as a real user would
+            std::memset(p, 0xA5, block_size);
+            slots[i] = p;
+            r.alloc_ticks.push_back(t1 - t0);
+        } else {
+            void *p = slots[i];
+            std::uint64_t t0 = bench::ticks();
+            do_free(p);
+            std::uint64_t t1 = bench::ticks();
+            slots[i] = nullptr;
+            r.free_ticks.push_back(t1 - t0);
+        }
+    }
+    for (void *p : slots) {
+        if (p != nullptr) {
+            do_free(p);
+        }
+    }
+    return r;
+}
+
+void report(const char *label, result &r) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s alloc", label);
+    bench::print_stats(name, bench::summarize(r.alloc_ticks));
+    std::snprintf(name, sizeof(name), "%s free", label);
+    bench::print_stats(name, bench::summarize(r.free_ticks));
+}
+
+template <std::size_t BlockSize>
+void compare() {
+    static max_align_t storage[(POOL_STORAGE_SIZE(BlockSize, kSlots) + sizeof(max_align_t) - 1u) /
+                               sizeof(max_align_t)];
+    pool_t pool;
+    if (!pool_init(&pool, storage, sizeof(storage), BlockSize)) {
+        std::fprintf(stderr, "pool_init failed\n");
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::printf("\nblock size %zu bytes, %zu live slots, %zu ops\n", BlockSize, kSlots, kOps);
+    bench::print_stats_header("ticks/op");
+
+    result m = run(
+        BlockSize, [] { return std::malloc(BlockSize); }, [](void *p) { std::free(p); });
+    report("malloc", m);
+
+    result p = run(
+        BlockSize, [&pool] { return pool_alloc(&pool); },
+        [&pool](void *b) { pool_free(&pool, b); });
+    report("pool", p);
+}
+
+}  // namespace
+
+int main() {
+    compare<16u>();
+    compare<64u>();
+    compare<256u>();
+    compare<1024u>();
+    return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file prng_bench.cpp
+ * @brief Random numbers per second: rand() vs xoshiro256** (scalar and bulk
+ * fill) at 1..N threads.
+ *
+ * glibc rand() keeps its state behind a process-wide lock, so aggregate
+ * throughput stops scaling (or drops) as threads are added; per-thread
+ * xoshiro streams derived with long_jump() share nothing.
+ *
+ * Usage: prng_bench [numbers-per-thread]
+ */
+
+#include "bench.hpp"
+#include "prng.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kBuffer = 4096u;
+
+double run_threads(unsigned threads, std::size_t per_thread,
+                   const std::function<void(unsigned, std::size_t)> &body) {
+    std::vector<std::thread> pool;
+    std::uint64_t t0 = bench::now_ns();
+    for (unsigned t = 0u; t < threads; ++t) {
+        pool.emplace_back(body, t, per_thread);
+    }
+    for (std::thread &th : pool) {
+        th.join();
+    }
+    double seconds = static_cast<double>(bench::now_ns() - t0) / 1e9;
+    return static_cast<double>(per_thread) * static_cast<double>(threads) / seconds;
+}
+
+void rand_body(unsigned, std::size_t n) {
+    std::uint64_t acc = 0u;
+    for (std::size_t i = 0u; i < n; ++i) {
+        acc += static_cast<std::uint64_t>(std::rand());
+    }
+    bench::do_not_optimize(acc);
+}
+
+void scalar_body(unsigned t, std::size_t n) {
+    cs::xoshiro256 rng = cs::xoshiro256(0x5EEDu).stream(t);
+    std::uint64_t acc = 0u;
+    for (std::size_t i = 0u; i < n; ++i) {
+        acc += rng();
+    }
+    bench::do_not_optimize(acc);
+}
+
+void fill_body(unsigned t, std::size_t n) {
+    cs::xoshiro256 base = cs::xoshiro256(0x5EEDu).stream(t);
+    cs::xoshiro256_bulk bulk(base);
+    std::vector<std::uint64_t> buf(kBuffer);
+    for (std::size_t done = 0u; done < n; done += kBuffer) {
+        bulk.fill(buf.data(), std::min(kBuffer, n - done));  // Exactly n in total
+        bench::do_not_optimize(buf.data());
+        bench::clobber_memory();
+    }
+}
+
+/* 1, 2, 4, ... below max_threads, then max_threads itself */
+std::vector<unsigned> thread_counts(unsigned max_threads) {
+    std::vector<unsigned> counts;
+    for (unsigned t = 1u; t < max_threads; t *= 2u) {
+        counts.push_back(t);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::size_t per_thread = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 20000000u;
+    unsigned hw = std::thread::hardware_concurrency();
+    unsigned max_threads = (hw > 4u) ? hw : 4u;
+
+    std::srand(1u);
+    std::printf("%zu numbers per thread, %u hardware thread(s)\n", per_thread, hw);
+    std::printf("%8s %16s %16s %16s %10s\n", "threads", "rand() M/s", "xoshiro M/s",
+                "xoshiro fill M/s", "fill/rand");
+    for (unsigned threads : thread_counts(max_threads)) {
+        double r = run_threads(threads, per_thread, rand_body);
+        double s = run_threads(threads, per_thread, scalar_body);
+        double f = run_threads(threads, per_thread, fill_body);
+        std::printf("%8u %16.1f %16.1f %16.1f %9.1fx\n", threads, r / 1e6, s / 1e6, f / 1e6, f / r);
+    }
+    return 0;
+}
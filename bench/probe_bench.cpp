@@ -0,0 +1,99 @@
+/**
+ * @file probe_bench.cpp
+ * @brief Cost of a timing probe (probe.h) per pass, on one thread and
+ * with several threads recording at once.
+ *
+ *   plain call     a non-inlined empty function: what `make` builds, where
+ *                  PROBE_CALL is the bare call
+ *   PROBE_CALL     the same call timed by a probe (two TSC reads and one
+ *                  update of the thread's counters)
+ *   probe_record   the counter update alone
+ *
+ * The threaded run starts 1..kMaxThreads threads that each pass a shared
+ * probe site kThreadPasses times, and reports wall-clock ns per pass over
+ * all threads. Per-thread buffers share no cache lines, so with a core
+ * per thread this should fall in proportion to the thread count; with
+ * fewer cores it stays flat. The exit report is switched off.
+ */
+
+#define PROBE_ENABLE
+
+#include "bench.hpp"
+#include "probe.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr unsigned kMaxThreads = 4u;
+constexpr std::uint64_t kThreadPasses = 1u << 22;
+
+probe_site_t g_site = {"probe_bench", 0u};
+
+__attribute__((noinline)) void empty_rule() { bench::clobber_memory(); }
+
+void plain_call(std::uint64_t n) {
+    bench::repeat(n, [] { empty_rule(); });
+}
+
+void probed_call(std::uint64_t n) {
+    bench::repeat(n, [] { PROBE_CALL(empty_rule, ()); });
+}
+
+void record_only(std::uint64_t n) {
+    bench::repeat(n, [] { probe_record(&g_site, 100u); });
+}
+
+struct bench_case {
+    const char *name;
+    void (*fn)(std::uint64_t);
+};
+
+const bench_case kCases[] = {
+    {"plain call", plain_call},
+    {"PROBE_CALL", probed_call},
+    {"probe_record", record_only},
+};
+
+double threaded_ns_per_pass(unsigned threads) {
+    std::vector<std::thread> pool;
+    const std::uint64_t t0 = bench::now_ns();
+    for (unsigned t = 0u; t < threads; ++t) {
+        pool.emplace_back([] {
+            for (std::uint64_t i = 0u; i < kThreadPasses; ++i) {
+                PROBE_SCOPE("probe_bench threaded");
+                bench::clobber_memory();
+            }
+        });
+    }
+    for (std::thread &t : pool) {
+        t.join();
+    }
+    return static_cast<double>(bench::now_ns() - t0) /
+           static_cast<double>(kThreadPasses * threads);
+}
+
+}  // namespace
+
+int main() {
+    probe_set_output(nullptr);
+    bench::cycle_counter cycles;
+    std::printf("%-14s %10s %12s\n", "case", "ns/op", "cycles/op");
+    for (const bench_case &c : kCases) {
+        const bench::measurement m = bench::measure(c.fn, cycles, 0.25, 5);
+        std::printf("%-14s %10.2f %12.2f\n", c.name, m.ns_per_op, m.cycles_per_op);
+    }
+
+    const unsigned cores = std::thread::hardware_concurrency();
+    std::printf("\n%u hardware threads; %llu passes per thread\n", cores,
+                static_cast<unsigned long long>(kThreadPasses));
+    std::printf("%-8s %14s\n", "threads", "wall ns/pass");
+    for (unsigned threads = 1u; threads <= kMaxThreads; threads *= 2u) {
+        std::printf("%-8u %14.2f\n", threads, threaded_ns_per_pass(threads));
+    }
+    return 0;
+}
@@ -0,0 +1,398 @@
+/**
+ * @file rule_stress.cpp
+ * @brief Multi-threaded stress driver: throughput of rule patterns and their
+ * compliant twins from 1 to N threads.
+ *
+ * The examples in src/ call each rule function once on one thread, so any
+ * state the functions share behind the caller's back never shows. Here each
+ * pattern that touches such state runs on a work-stealing pool for a fixed
+ * time per thread count, next to its compliant rewrite:
+ *
+ *   misra_rule_21_3   malloc/free and the allocator's shared arenas vs a
+ *                     per-thread pool_alloc pool
+ *   cert_msc32_c      rand(), one generator behind a lock (also
+ *                     cert_msc50_cpp) vs a per-thread xoshiro256
+ *   misra_rule_8_7    an object with external linkage updated by every
+ *                     call vs a count kept local and published per batch
+ *   autosar_a2_10_1   file-scope ints laid out side by side like
+ *                     shadow_var and outer_var, one per thread, so writes
+ *                     still share cache lines vs padded per-thread slots
+ *   misra_rule_21_6   fprintf into one FILE and its lock vs fmt.h into a
+ *                     per-thread buffer written with write()
+ *
+ * As in rule_suite, the patterns are re-created here rather than called
+ * in src/, whose functions run once and some of which crash. The shared
+ * counters are atomics with relaxed ordering, which costs the same plain
+ * moves as the racy originals without the undefined behaviour.
+ *
+ * Each worker owns a deque of batches (kBatchOps calls each) behind its own
+ * mutex. It pops from the back of its deque and, when that is empty,
+ * steals from the front of another worker's. All batches start on worker
+ * 0, so every other worker begins by stealing; a finished batch goes back
+ * on the deque of the worker that ran it.
+ *
+ * The table gives Mops/s per thread count and the scaling efficiency at
+ * the largest count: throughput / (threads x single-thread throughput). A
+ * pattern that serialises on shared state falls well below 1 while its
+ * twin stays near it. With fewer cores than threads every case falls, so
+ * run it with --threads no higher than the core count.
+ *
+ * Usage: rule_stress [--threads N] [--seconds S] [--filter SUBSTRING]
+ */
+
+#include "bench.hpp"
+
+#include "fmt.h"
+#include "pool_alloc.h"
+#include "prng.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr unsigned kMaxThreads = 64u;
+constexpr std::uint64_t kBatchOps = 512u;
+constexpr unsigned kBatchesPerThread = 4u;
+constexpr std::size_t kCacheLine = 64u;
+
+using stress_fn = void (*)(std::uint64_t n, unsigned worker);
+
+struct stress_case {
+    const char *rule;  // Example function in src/
+    stress_fn violation;
+    stress_fn compliant;
+};
+
+int g_devnull = -1;
+FILE *g_devnull_file = nullptr;
+
+/* ---- Patterns ---------------------------------------------------------- */
+
+constexpr std::size_t kPoolObject = sizeof(std::int32_t) * 10u;
+constexpr std::size_t kPoolBlocks = 16u;
+
+/* A pool over storage owned by one thread */
+struct local_pool {
+    max_align_t storage[(POOL_STORAGE_SIZE(kPoolObject, kPoolBlocks) + sizeof(max_align_t) - 1u) /
+                        sizeof(max_align_t)];
+    pool_t pool;
+
+    local_pool() { static_cast<void>(pool_init(&pool, storage, sizeof(storage), kPoolObject)); }
+};
+
+void misra_rule_21_3_violation(std::uint64_t n, unsigned /*worker*/) {
+    bench::repeat(n, [] {
+        void *p = std::malloc(kPoolObject);
+        bench::do_not_optimize(p);
+        std::free(p);
+    });
+}
+
+void misra_rule_21_3_compliant(std::uint64_t n, unsigned /*worker*/) {
+    thread_local local_pool tl_pool;
+    pool_t *pool = &tl_pool.pool;
+    bench::repeat(n, [pool] {
+        void *p = pool_alloc(pool);
+        bench::do_not_optimize(p);
+        pool_free(pool, p);
+    });
+}
+
+struct local_rng {
+    xoshiro256_t rng;
+
+    local_rng() {
+        if (!xoshiro256_seed_from_entropy(&rng)) {
+            xoshiro256_seed(&rng, bench::ticks());
+        }
+    }
+};
+
+void cert_msc32_c_violation(std::uint64_t n, unsigned /*worker*/) {
+    bench::repeat(n, [] { bench::do_not_optimize(std::rand()); });
+}
+
+void cert_msc32_c_compliant(std::uint64_t n, unsigned /*worker*/) {
+    thread_local local_rng tl_rng;
+    xoshiro256_t *rng = &tl_rng.rng;
+    bench::repeat(n, [rng] { bench::do_not_optimize(xoshiro256_next(rng)); });
+}
+
+std::atomic<std::uint32_t> misra_rule_8_7_global{42u};
+
+void misra_rule_8_7_violation(std::uint64_t n, unsigned /*worker*/) {
+    bench::repeat(n, [] {
+        const std::uint32_t v = misra_rule_8_7_global.load(std::memory_order_relaxed);
+        misra_rule_8_7_global.store(v + 1u, std::memory_order_relaxed);
+    });
+}
+
+void misra_rule_8_7_compliant(std::uint64_t n, unsigned /*worker*/) {
+    std::uint32_t count = 0u;
+    bench::repeat(n, [&count] { count = bench::opaque(count + 1u); });
+    static_cast<void>(misra_rule_8_7_global.fetch_add(count, std::memory_order_relaxed));
+}
+
+/* Consecutive file-scope ints, 16 to a cache line */
+std::atomic<std::int32_t> g_file_scope_ints[kMaxThreads];
+
+struct alignas(kCacheLine) padded_int {
+    std::atomic<std::int32_t> value;
+};
+
+padded_int g_padded_ints[kMaxThreads];
+
+void bump(std::atomic<std::int32_t> &v) {
+    v.store(v.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void autosar_a2_10_1_violation(std::uint64_t n, unsigned worker) {
+    std::atomic<std::int32_t> &v = g_file_scope_ints[worker];
+    bench::repeat(n, [&v] { bump(v); });
+}
+
+void autosar_a2_10_1_compliant(std::uint64_t n, unsigned worker) {
+    std::atomic<std::int32_t> &v = g_padded_ints[worker].value;
+    bench::repeat(n, [&v] { bump(v); });
+}
+
+/* The same line size as the default FILE buffer, so both write 4 KiB at a time */
+constexpr std::size_t kLineBuffer = 4096u;
+constexpr std::size_t kLineMax = 64u;
+
+struct local_buffer {
+    char data[kLineBuffer];
+    fmt_buf_t buf;
+
+    local_buffer() { fmt_buf_init(&buf, data, sizeof(data)); }
+};
+
+void misra_rule_21_6_violation(std::uint64_t n, unsigned /*worker*/) {
+    bench::repeat(n, [] {
+        static_cast<void>(std::fprintf(g_devnull_file, "value %d\n", bench::opaque(42)));
+    });
+}
+
+void misra_rule_21_6_compliant(std::uint64_t n, unsigned /*worker*/) {
+    thread_local local_buffer tl_out;
+    local_buffer *out = &tl_out;
+    bench::repeat(n, [out] {
+        fmt_put_str(&out->buf, "value ");
+        fmt_put_i64(&out->buf, bench::opaque(42));
+        fmt_put_char(&out->buf, '\n');
+        const std::size_t stored = fmt_buf_stored(&out->buf);
+        if (stored > (sizeof(out->data) - kLineMax)) {
+            static_cast<void>(fmt_write_all(g_devnull, out->data, stored));
+            fmt_buf_init(&out->buf, out->data, sizeof(out->data));
+        }
+    });
+}
+
+const stress_case kCases[] = {
+    {"misra_rule_21_3", misra_rule_21_3_violation, misra_rule_21_3_compliant},
+    {"cert_msc32_c", cert_msc32_c_violation, cert_msc32_c_compliant},
+    {"misra_rule_8_7", misra_rule_8_7_violation, misra_rule_8_7_compliant},
+    {"autosar_a2_10_1", autosar_a2_10_1_violation, autosar_a2_10_1_compliant},
+    {"misra_rule_21_6", misra_rule_21_6_violation, misra_rule_21_6_compliant},
+};
+
+/* ---- Work-stealing pool ------------------------------------------------ */
+
+struct alignas(kCacheLine) worker_queue {
+    std::mutex lock;
+    std::deque<std::uint64_t> batches;  // Calls per batch
+};
+
+struct alignas(kCacheLine) worker_stats {
+    std::uint64_t ops;
+    std::uint64_t steals;
+};
+
+worker_queue g_queues[kMaxThreads];
+worker_stats g_stats[kMaxThreads];
+std::atomic<bool> g_stop{false};
+
+bool pop_own(unsigned self, std::uint64_t &batch) {
+    worker_queue &q = g_queues[self];
+    std::lock_guard<std::mutex> guard(q.lock);
+    const bool found = !q.batches.empty();
+    if (found) {
+        batch = q.batches.back();
+        q.batches.pop_back();
+    }
+    return found;
+}
+
+void push_own(unsigned self, std::uint64_t batch) {
+    worker_queue &q = g_queues[self];
+    std::lock_guard<std::mutex> guard(q.lock);
+    q.batches.push_back(batch);
+}
+
+/* Take the oldest batch of the first other worker that has one; a victim
+ * whose lock is busy is skipped rather than waited for. */
+bool steal(unsigned self, unsigned threads, std::uint64_t &batch) {
+    bool found = false;
+    for (unsigned i = 1u; !found && (i < threads); ++i) {
+        worker_queue &victim = g_queues[(self + i) % threads];
+        std::unique_lock<std::mutex> guard(victim.lock, std::try_to_lock);
+        if (guard.owns_lock() && !victim.batches.empty()) {
+            batch = victim.batches.front();
+            victim.batches.pop_front();
+            found = true;
+        }
+    }
+    return found;
+}
+
+void worker_loop(unsigned self, unsigned threads, stress_fn fn) {
+    worker_stats &stats = g_stats[self];
+    std::uint64_t batch = 0u;
+    while (!g_stop.load(std::memory_order_relaxed)) {
+        bool have = pop_own(self, batch);
+        if (!have && steal(self, threads, batch)) {
+            have = true;
+            ++stats.steals;
+        }
+        if (have) {
+            fn(batch, self);
+            stats.ops += batch;
+            push_own(self, batch);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+struct run_result {
+    double mops;
+    std::uint64_t steals;
+};
+
+run_result run_pool(stress_fn fn, unsigned threads, double seconds) {
+    for (unsigned t = 0u; t < threads; ++t) {
+        g_queues[t].batches.clear();
+        g_stats[t].ops = 0u;
+        g_stats[t].steals = 0u;
+    }
+    for (unsigned i = 0u; i < (threads * kBatchesPerThread); ++i) {
+        g_queues[0].batches.push_back(kBatchOps);
+    }
+    g_stop.store(false);
+
+    std::vector<std::thread> pool;
+    const std::uint64_t t0 = bench::now_ns();
+    for (unsigned t = 0u; t < threads; ++t) {
+        pool.emplace_back(worker_loop, t, threads, fn);
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    g_stop.store(true);
+    for (std::thread &t : pool) {
+        t.join();
+    }
+    const std::uint64_t elapsed = bench::now_ns() - t0;
+
+    run_result r = {0.0, 0u};
+    std::uint64_t ops = 0u;
+    for (unsigned t = 0u; t < threads; ++t) {
+        ops += g_stats[t].ops;
+        r.steals += g_stats[t].steals;
+    }
+    r.mops = (elapsed > 0u) ? (static_cast<double>(ops) * 1e3 / static_cast<double>(elapsed)) : 0.0;
+    return r;
+}
+
+/* 1, 2, 4, ... below max_threads, then max_threads itself */
+std::vector<unsigned> thread_counts(unsigned max_threads) {
+    std::vector<unsigned> counts;
+    for (unsigned t = 1u; t < max_threads; t *= 2u) {
+        counts.push_back(t);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+void print_curve(const char *rule, const char *variant, stress_fn fn,
+                 const std::vector<unsigned> &counts, double seconds) {
+    std::printf("%-16s %-10s", rule, variant);
+    double single = 0.0;
+    run_result last = {0.0, 0u};
+    for (unsigned threads : counts) {
+        last = run_pool(fn, threads, seconds);
+        single = (threads == 1u) ? last.mops : single;
+        std::printf(" %9.2f", last.mops);
+    }
+    const double efficiency =
+        (single > 0.0) ? (last.mops / (single * static_cast<double>(counts.back()))) : 0.0;
+    std::printf(" %8.2f %9llu\n", efficiency, static_cast<unsigned long long>(last.steals));
+    static_cast<void>(std::fflush(stdout));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const unsigned cores = std::thread::hardware_concurrency();
+    unsigned max_threads = (cores > 0u) ? cores : 1u;
+    double seconds = 0.2;
+    const char *filter = nullptr;
+    bool ok = true;
+    for (int i = 1; ok && (i < argc); ++i) {
+        if ((std::strcmp(argv[i], "--threads") == 0) && (i + 1 < argc)) {
+            max_threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if ((std::strcmp(argv[i], "--seconds") == 0) && (i + 1 < argc)) {
+            seconds = std::atof(argv[++i]);
+        } else if ((std::strcmp(argv[i], "--filter") == 0) && (i + 1 < argc)) {
+            filter = argv[++i];
+        } else {
+            ok = false;
+        }
+    }
+    if (!ok || (max_threads == 0u) || (max_threads > kMaxThreads) || !(seconds > 0.0)) {
+        std::fprintf(stderr, "usage: %s [--threads 1..%u] [--seconds S] [--filter SUBSTRING]\n",
+                     argv[0], kMaxThreads);
+        return EXIT_FAILURE;
+    }
+
+    g_devnull = open("/dev/null", O_WRONLY);
+    g_devnull_file = fdopen(dup(g_devnull), "w");
+    if ((g_devnull < 0) || (g_devnull_file == nullptr)) {
+        std::perror("/dev/null");
+        return EXIT_FAILURE;
+    }
+    std::srand(1u);
+
+    const std::vector<unsigned> counts = thread_counts(max_threads);
+    std::printf("%u hardware threads; %.2f s per point; %llu calls per batch\n\n", cores, seconds,
+                static_cast<unsigned long long>(kBatchOps));
+    std::printf("%-16s %-10s", "rule", "variant");
+    for (unsigned threads : counts) {
+        std::printf(" %6u thr", threads);
+    }
+    std::printf(" %8s %9s\n", "scaling", "steals");
+    for (const stress_case &c : kCases) {
+        if ((filter == nullptr) || (std::strstr(c.rule, filter) != nullptr)) {
+            print_curve(c.rule, "violation", c.violation, counts, seconds);
+            print_curve(c.rule, "compliant", c.compliant, counts, seconds);
+        }
+    }
+    std::printf("\nMops/s per thread count; scaling = Mops/s at %u thread(s) / "
+                "(%u x Mops/s at 1)\n",
+                counts.back(), counts.back());
+
+    static_cast<void>(std::fclose(g_devnull_file));
+    static_cast<void>(close(g_devnull));
+    return 0;
+}
@@ -0,0 +1,896 @@
+/**
+ * @file rule_suite.cpp
+ * @brief Paired violation/compliant microbenchmarks for the example rules.
+ *
+ * Each entry pairs the pattern used by a rule function in src/ (e.g.
+ * autosar_a8_4_7) with its compliant rewrite and measures both for ns/op,
+ * cycles/op and heap allocations/op. Patterns whose example is undefined
+ * behaviour (reading freed or uninitialised memory, overflowing a buffer)
+ * are timed in their nearest well-defined form, e.g. strcpy into a buffer
+ * that happens to be large enough.
+ *
+ * Rules left out, because src/ has no compliant twin to pair them with or
+ * the pair would time the same instructions twice:
+ *
+ *   no run-time pattern    misra_rule_2_2, misra_rule_8_4, misra_rule_8_7,
+ *                          misra_rule_11_3, misra_rule_14_4, misra_rule_15_6,
+ *                          autosar_a0_1_1, autosar_a0_1_2, autosar_a2_10_1,
+ *                          autosar_a5_2_2, autosar_a7_1_5, autosar_a11_0_2,
+ *                          misra_cpp_0_1_1, misra_cpp_2_10_2, misra_cpp_5_2_4:
+ *                          dead code, declarations, scopes and cast
+ *                          spellings, with no twin and nothing to time
+ *   types only             misra_dir_4_6, autosar_a3_9_1: the twin spells the
+ *                          same integers with fixed-width types
+ *   no twin, UB only       cert_exp30_c, cert_exp33_c, cert_mem35_c,
+ *                          cert_exp55_cpp: unsequenced side effects, an
+ *                          uninitialised read, an undersized allocation and
+ *                          a write to a const object have no well-defined
+ *                          form to time
+ *   terminates             cert_err50_cpp: abort() ends the process
+ *
+ * Usage: rule_suite [--json FILE] [--filter SUBSTRING] [--min-time SECONDS]
+ */
+
+#include "alloc_count.hpp"
+#include "bench.hpp"
+
+#include "big_array.hpp"
+#include "bits.h"
+#include "bounds.h"
+#include "bounds.hpp"
+#include "bstr.h"
+#include "bstr.hpp"
+#include "dispatch.hpp"
+#include "expected.hpp"
+#include "file_reader.h"
+#include "fmt.h"
+#include "fmt.hpp"
+#include "int_convert.h"
+#include "int_convert.hpp"
+#include "lazy.hpp"
+#include "pool_alloc.h"
+#include "pool_alloc.hpp"
+#include "poly_value.hpp"
+#include "prng.h"
+#include "prng.hpp"
+#include "sig_ring.h"
+#include "slot_map.h"
+#include "static_vector.hpp"
+#include "units.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+using case_fn = void (*)(std::uint64_t);
+
+struct rule_pair {
+    const char *rule;       // Example function in src/
+    const char *standard;
+    case_fn violation;
+    case_fn compliant;
+};
+
+int g_devnull = -1;
+FILE *g_devnull_file = nullptr;
+
+/* ---- MISRA C 2012 ---------------------------------------------------- */
+
+POOL_DEFINE_STORAGE(g_pool_storage, sizeof(std::int32_t) * 10u, 16u);
+pool_t g_pool;
+
+void misra_rule_21_3_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int *p = static_cast<int *>(std::malloc(sizeof(int) * 10u));
+        bench::do_not_optimize(p);
+        std::free(p);
+    });
+}
+
+void misra_rule_21_3_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        void *p = pool_alloc(&g_pool);
+        bench::do_not_optimize(p);
+        pool_free(&g_pool, p);
+    });
+}
+
+void misra_rule_10_3_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int i = bench::opaque(42);
+        short s = static_cast<short>(i);
+        bench::do_not_optimize(s);
+    });
+}
+
+void misra_rule_10_3_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::int32_t i = bench::opaque(std::int32_t{42});
+        std::int16_t s = sat_i32_to_i16(i);
+        bench::do_not_optimize(s);
+    });
+}
+
+void misra_rule_17_7_violation(std::uint64_t n) {
+    char buf[64] = "request-line";
+    bench::repeat(n, [&buf] { bench::do_not_optimize(std::strlen(bench::opaque(buf))); });
+}
+
+void misra_rule_17_7_compliant(std::uint64_t n) {
+    char buf[64] = "request-line";
+    bench::repeat(n, [&buf] {
+        bench::do_not_optimize(bstr_nlen(bench::opaque(buf), sizeof(buf)));
+    });
+}
+
+void misra_rule_10_1_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        char c = bench::opaque('A');
+        int result = c << 2;
+        bench::do_not_optimize(result);
+    });
+}
+
+void misra_rule_10_1_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::uint8_t c = bench::opaque(std::uint8_t{0x41u});
+        bench::do_not_optimize(bits_shl_u32(static_cast<std::uint32_t>(c), 2u));
+    });
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wparentheses"
+void misra_rule_12_1_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int a = bench::opaque(1);
+        int result = a + 2 << bench::opaque(3);  // The implicit precedence being measured
+        bench::do_not_optimize(result);
+    });
+}
+#pragma GCC diagnostic pop
+
+void misra_rule_12_1_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::uint32_t a = bench::opaque(std::uint32_t{1u});
+        bench::do_not_optimize(bits_shl_u32(a + 2u, bench::opaque(std::uint32_t{3u})));
+    });
+}
+
+void misra_rule_21_6_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::fprintf(g_devnull_file, "Formatted without stdio: %d %.2f\n", bench::opaque(-42), 2.5);
+    });
+    std::fflush(g_devnull_file);
+}
+
+void misra_rule_21_6_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        char line[64];
+        fmt_buf_t b;
+        fmt_buf_init(&b, line, sizeof(line));
+        fmt_put_str(&b, "Formatted without stdio: ");
+        fmt_put_i64(&b, bench::opaque(-42));
+        fmt_put_char(&b, ' ');
+        fmt_put_f64(&b, 2.5, 2u);
+        fmt_put_char(&b, '\n');
+        static_cast<void>(fmt_buf_finish(&b));
+        static_cast<void>(fmt_write_all(g_devnull, line, fmt_buf_stored(&b)));
+    });
+}
+
+/* ---- CERT C ------------------------------------------------------------ */
+
+void cert_str31_c_violation(std::uint64_t n) {
+    char buf[64];
+    bench::repeat(n, [&buf] {
+        std::strcpy(buf, bench::opaque("GET /index.html HTTP/1.1"));
+        bench::do_not_optimize(buf);
+    });
+}
+
+void cert_str31_c_compliant(std::uint64_t n) {
+    char buf[64];
+    bench::repeat(n, [&buf] {
+        bstr_status_t st = bstr_copy(buf, sizeof(buf), bench::opaque("GET /index.html HTTP/1.1"),
+                                     nullptr);
+        bench::do_not_optimize(st);
+        bench::do_not_optimize(buf);
+    });
+}
+
+void cert_sig30_c_violation(std::uint64_t n) {
+    bench::repeat(n, [] { std::fprintf(g_devnull_file, "Signal %d caught\n", bench::opaque(2)); });
+    std::fflush(g_devnull_file);
+}
+
+void cert_sig30_c_compliant(std::uint64_t n) {
+    std::uint64_t pending = 0u;
+    bench::repeat(n, [&pending] {
+        static_cast<void>(sig_ring_record(sig_ring_default(), bench::opaque(2), 0, 0u, 0u));
+        // The drain thread's batched write(), amortised over the events
+        if (++pending == (SIG_RING_CAPACITY / 2u)) {
+            static_cast<void>(sig_ring_drain(sig_ring_default(), g_devnull, SIG_RING_CAPACITY));
+            pending = 0u;
+        }
+    });
+    static_cast<void>(sig_ring_drain(sig_ring_default(), g_devnull, SIG_RING_CAPACITY));
+}
+
+void cert_arr30_c_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int arr[10] = {0};
+        int val = arr[bench::opaque(std::size_t{9})];
+        bench::do_not_optimize(val);
+    });
+}
+
+void cert_arr30_c_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::int32_t arr[10] = {0};
+        std::size_t index = bench::opaque(std::size_t{9});
+        std::int32_t val = 0;
+        if (bounds_ok(index, BOUNDS_COUNT(arr))) {
+            val = arr[index];
+        }
+        bench::do_not_optimize(val);
+    });
+}
+
+void cert_msc32_c_violation(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(std::rand()); });
+}
+
+void cert_msc32_c_compliant(std::uint64_t n) {
+    xoshiro256_t rng;
+    xoshiro256_seed(&rng, 0x5EEDu);
+    bench::repeat(n, [&rng] { bench::do_not_optimize(xoshiro256_next(&rng)); });
+}
+
+void cert_int31_c_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        unsigned int u = bench::opaque(4294967295u);
+        bench::do_not_optimize(static_cast<int>(u));
+    });
+}
+
+void cert_int31_c_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::int32_t s = 0;
+        bool ok = checked_u32_to_i32(bench::opaque(std::uint32_t{4294967295u}), &s);
+        bench::do_not_optimize(ok);
+        bench::do_not_optimize(s);
+    });
+}
+
+SLOT_MAP_DEFINE_STORAGE(g_slot_storage, sizeof(std::int32_t), 8u);
+slot_map_t g_slots;
+
+/* Read before the free: the example reads after it */
+void cert_mem30_c_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int *p = static_cast<int *>(std::malloc(sizeof(int)));
+        *p = bench::opaque(42);
+        bench::do_not_optimize(*p);
+        std::free(p);
+    });
+}
+
+void cert_mem30_c_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::int32_t value = bench::opaque(std::int32_t{42});
+        slot_handle_t h = slot_map_insert(&g_slots, &value);
+        static_cast<void>(slot_map_erase(&g_slots, h));
+        const void *p = slot_map_get(&g_slots, h);
+        bench::do_not_optimize(p);
+    });
+}
+
+/* fclose only when fopen succeeded: the example passes it NULL */
+void cert_err33_c_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        FILE *f = std::fopen(bench::opaque("nonexistent.txt"), "r");
+        bench::do_not_optimize(f);
+        if (f != nullptr) {
+            std::fclose(f);
+        }
+    });
+}
+
+void cert_err33_c_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        file_reader_t reader;
+        int err = file_reader_open(&reader, bench::opaque("nonexistent.txt"), FILE_READER_AUTO, 0u);
+        if (err == 0) {
+            err = file_reader_close(&reader);
+        }
+        bench::do_not_optimize(err);
+    });
+}
+
+/* A pointer to static storage: the example returns one to a dead local */
+__attribute__((noinline)) int *dcl30_address(int v) {
+    static int object = 0;
+    object = v;
+    return &object;
+}
+
+__attribute__((noinline)) slot_handle_t dcl30_handle(std::int32_t v) {
+    return slot_map_insert(&g_slots, &v);
+}
+
+void cert_dcl30_c_violation(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(*dcl30_address(bench::opaque(42))); });
+}
+
+void cert_dcl30_c_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        slot_handle_t h = dcl30_handle(bench::opaque(std::int32_t{42}));
+        const std::int32_t *p = static_cast<const std::int32_t *>(slot_map_get(&g_slots, h));
+        bench::do_not_optimize((p != nullptr) ? *p : 0);
+        static_cast<void>(slot_map_erase(&g_slots, h));
+    });
+}
+
+/* ---- AUTOSAR C++14 ----------------------------------------------------- */
+
+void autosar_a18_5_1_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int *p = static_cast<int *>(std::malloc(sizeof(int) * 10u));
+        bench::do_not_optimize(p);
+        std::free(p);
+    });
+}
+
+void autosar_a18_5_1_compliant(std::uint64_t n) {
+    static cs::typed_pool<std::array<std::int32_t, 10>, 4> pool;
+    bench::repeat(n, [] {
+        cs::typed_pool<std::array<std::int32_t, 10>, 4>::handle p = pool.make();
+        bench::do_not_optimize(p.get());
+    });
+}
+
+void autosar_m5_0_3_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int i = bench::opaque(42);
+        double d = i;
+        bench::do_not_optimize(d);
+    });
+}
+
+void autosar_m5_0_3_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::int32_t i = bench::opaque(std::int32_t{42});
+        bench::do_not_optimize(cs::widen<double>(i));
+    });
+}
+
+void autosar_a5_1_1_violation(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(bench::opaque(10) * 3600); });
+}
+
+void autosar_a5_1_1_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        cs::expected<cs::units::seconds32, std::errc> s =
+            cs::units::checked_cast<cs::units::seconds32>(cs::units::hours32(bench::opaque(10)));
+        bench::do_not_optimize(s.has_value() ? s->count() : 0);
+    });
+}
+
+void autosar_a18_1_1_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int arr[10] = {0};
+        arr[bench::opaque(3)] = 1;
+        bench::do_not_optimize(&arr[0]);
+        bench::clobber_memory();
+    });
+}
+
+void autosar_a18_1_1_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        cs::checked_array<std::int32_t, 10> arr{};
+        arr[bench::opaque(std::size_t{3})] = 1;
+        bench::do_not_optimize(arr.data());
+        bench::clobber_memory();
+    });
+}
+
+void autosar_a15_1_2_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        try {
+            throw new std::runtime_error("oops");
+        } catch (std::runtime_error *e) {
+            delete e;
+        }
+    });
+}
+
+__attribute__((noinline)) cs::expected<std::int32_t, std::errc> fails(std::int32_t v) {
+    cs::expected<std::int32_t, std::errc> result = v;
+    if (v >= 0) {
+        result = cs::make_unexpected(std::errc::invalid_argument);
+    }
+    return result;
+}
+
+void autosar_a15_1_2_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        cs::expected<std::int32_t, std::errc> r = fails(bench::opaque(1));
+        bench::do_not_optimize(r.has_value());
+    });
+}
+
+std::vector<int> g_data(1000u, 1);
+
+__attribute__((noinline)) std::size_t by_value(std::vector<int> data) { return data.size(); }
+__attribute__((noinline)) std::size_t by_const_ref(const std::vector<int> &data) {
+    return data.size();
+}
+
+void autosar_a8_4_7_violation(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(by_value(g_data)); });
+}
+
+void autosar_a8_4_7_compliant(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(by_const_ref(g_data)); });
+}
+
+void autosar_m6_4_1_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int val = bench::opaque(3);
+        int r = 0;
+        if (val == 1) {
+            r = 10;
+        } else if (val == 2) {
+            r = 20;
+        }
+        bench::do_not_optimize(r);
+    });
+}
+
+constexpr auto kM641 = cs::make_dispatch_table<1, 2>(std::int32_t{0}, cs::on(1, std::int32_t{10}),
+                                                     cs::on(2, std::int32_t{20}));
+
+void autosar_m6_4_1_compliant(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(kM641[bench::opaque(std::int32_t{3})]); });
+}
+
+/* ---- CERT C++ ---------------------------------------------------------- */
+
+int variadic_sum(int count, ...) {
+    va_list ap;
+    va_start(ap, count);
+    int total = 0;
+    for (int i = 0; i < count; ++i) {
+        total += va_arg(ap, int);
+    }
+    va_end(ap);
+    return total;
+}
+
+std::int32_t template_sum() { return 0; }
+
+template <typename... Rest>
+std::int32_t template_sum(std::int32_t first, Rest... rest) {
+    return first + template_sum(rest...);
+}
+
+void cert_dcl50_cpp_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        bench::do_not_optimize(variadic_sum(3, bench::opaque(1), 2, 3));
+    });
+}
+
+void cert_dcl50_cpp_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        bench::do_not_optimize(template_sum(bench::opaque(std::int32_t{1}), 2, 3));
+    });
+}
+
+struct SimpleData {
+    int x;
+    int y;
+};
+
+void cert_oop57_cpp_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        SimpleData a = {bench::opaque(1), 2};
+        SimpleData b;
+        std::memcpy(&b, &a, sizeof(SimpleData));
+        bench::do_not_optimize(b);
+    });
+}
+
+void cert_oop57_cpp_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        SimpleData a = {bench::opaque(1), 2};
+        SimpleData b = a;
+        bench::do_not_optimize(b);
+    });
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcatch-value"
+void cert_err61_cpp_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        try {
+            throw std::runtime_error("error");
+        } catch (std::exception e) {  // The sliced catch being measured
+            bench::do_not_optimize(e.what());
+        }
+    });
+}
+#pragma GCC diagnostic pop
+
+struct op_error {
+    std::errc code;
+    const char *what;
+};
+
+__attribute__((noinline)) cs::expected<std::int32_t, op_error> fails_with_message(bool fail) {
+    cs::expected<std::int32_t, op_error> result = 0;
+    if (fail) {
+        result = cs::make_unexpected(op_error{std::errc::io_error, "error"});
+    }
+    return result;
+}
+
+void cert_err61_cpp_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        cs::expected<std::int32_t, op_error> r = fails_with_message(bench::opaque(true));
+        bench::do_not_optimize(r.error().what);
+    });
+}
+
+std::string g_eager_str = "ok";
+
+cs::expected<std::string, std::errc> lazy_str_init() { return std::string("ok"); }
+
+cs::lazy<std::string, std::errc> g_lazy_str(lazy_str_init);
+
+void cert_err58_cpp_violation(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(bench::opaque(&g_eager_str)->size()); });
+}
+
+void cert_err58_cpp_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        cs::expected<std::string *, std::errc> s = bench::opaque(&g_lazy_str)->get();
+        bench::do_not_optimize(s ? (*s)->size() : 0u);
+    });
+}
+
+void cert_msc50_cpp_violation(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(std::rand() % 100); });
+}
+
+void cert_msc50_cpp_compliant(std::uint64_t n) {
+    cs::xoshiro256 rng(0x5EEDu);
+    std::uniform_int_distribution<std::int32_t> dist(0, 99);
+    bench::repeat(n, [&] { bench::do_not_optimize(dist(rng)); });
+}
+
+class Base {
+public:
+    virtual ~Base() = default;
+    virtual int value() const { return 0; }
+};
+
+class Derived : public Base {
+    int extra_ = 42;
+
+public:
+    int value() const override { return extra_; }
+};
+
+__attribute__((noinline)) int process_by_value(Base b) { return b.value(); }
+__attribute__((noinline)) int process_by_poly_value(const cs::poly_value<Base> &b) {
+    return b->value();
+}
+
+void cert_oop51_cpp_violation(std::uint64_t n) {
+    Derived d;
+    bench::repeat(n, [&d] { bench::do_not_optimize(process_by_value(d)); });
+}
+
+void cert_oop51_cpp_compliant(std::uint64_t n) {
+    Derived d;
+    bench::repeat(n, [&d] { bench::do_not_optimize(process_by_poly_value(d)); });
+}
+
+void cert_ctr50_cpp_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::vector<int> vec = {1, 2, 3};
+        int val = vec[bench::opaque(std::size_t{2})];
+        bench::do_not_optimize(val);
+    });
+}
+
+void cert_ctr50_cpp_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        cs::static_vector<std::int32_t, 8> vec = {1, 2, 3};
+        std::size_t index = bench::opaque(std::size_t{2});
+        std::int32_t val = 0;
+        if (index < vec.size()) {
+            val = vec[index];
+        }
+        bench::do_not_optimize(val);
+    });
+}
+
+void cert_mem52_cpp_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int *p = new (std::nothrow) int[bench::opaque(std::size_t{1000})];
+        *p = 42;
+        bench::do_not_optimize(p);
+        delete[] p;
+    });
+}
+
+/* The twin's reserve and commit, sized like the violation's array */
+void cert_mem52_cpp_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        cs::expected<cs::big_array<std::int32_t>, std::errc> a =
+            cs::big_array<std::int32_t>::reserve(bench::opaque(std::size_t{1000}));
+        if (a.has_value() && a.value().resize(1u).has_value()) {
+            a.value()[0] = 42;
+            bench::do_not_optimize(a.value().data());
+        }
+    });
+}
+
+/* ---- MISRA C++ --------------------------------------------------------- */
+
+void misra_cpp_18_4_1_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        int *p = new int(bench::opaque(42));
+        bench::do_not_optimize(p);
+        delete p;
+    });
+}
+
+void misra_cpp_18_4_1_compliant(std::uint64_t n) {
+    static cs::typed_pool<std::int32_t, 8> pool;
+    bench::repeat(n, [] {
+        std::int32_t *p = pool.create(bench::opaque(std::int32_t{42}));
+        bench::do_not_optimize(p);
+        pool.destroy(p);
+    });
+}
+
+void misra_cpp_18_0_1_violation(std::uint64_t n) {
+    char dst[10];
+    bench::repeat(n, [&dst] {
+        std::strcpy(dst, bench::opaque("hello"));
+        bench::do_not_optimize(dst);
+    });
+}
+
+void misra_cpp_18_0_1_compliant(std::uint64_t n) {
+    std::array<char, 10> dst{};
+    bench::repeat(n, [&dst] {
+        bench::do_not_optimize(cs::bounded_copy(dst, bench::opaque("hello")));
+        bench::do_not_optimize(dst);
+    });
+}
+
+void misra_cpp_15_3_5_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        try {
+            throw bench::opaque(42);
+        } catch (int e) {
+            bench::do_not_optimize(e);
+        }
+    });
+}
+
+void misra_cpp_15_3_5_compliant(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::int32_t v = fails(bench::opaque(42))
+                             .or_else([](std::errc) { return cs::expected<std::int32_t, std::errc>(0); })
+                             .value();
+        bench::do_not_optimize(v);
+    });
+}
+
+void misra_cpp_5_0_3_violation(std::uint64_t n) { autosar_m5_0_3_violation(n); }
+void misra_cpp_5_0_3_compliant(std::uint64_t n) { autosar_m5_0_3_compliant(n); }
+
+__attribute__((noinline)) int multi_exit(int x) {
+    if (x > 0) {
+        return 1;
+    }
+    if (x < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+__attribute__((noinline)) std::int32_t single_exit(std::int32_t x) {
+    return std::min(std::max(x, -1), 1);
+}
+
+void misra_cpp_6_6_5_violation(std::uint64_t n) {
+    std::int32_t x = -2;
+    bench::repeat(n, [&x] { bench::do_not_optimize(multi_exit(x = (x == 2) ? -2 : x + 1)); });
+}
+
+void misra_cpp_6_6_5_compliant(std::uint64_t n) {
+    std::int32_t x = -2;
+    bench::repeat(n, [&x] { bench::do_not_optimize(single_exit(x = (x == 2) ? -2 : x + 1)); });
+}
+
+__attribute__((noinline)) int case_chain(int x) {
+    int r = 0;
+    if (x == 1) {
+        r = 1;
+    } else if (x == 2) {
+        r = 2;
+    }
+    return r;
+}
+
+__attribute__((noinline)) std::int32_t case_table(std::int32_t x) {
+    static constexpr auto kCaseOf = cs::make_dispatch_table<1, 2>(
+        std::int32_t{0}, cs::on(1, std::int32_t{1}), cs::on(2, std::int32_t{2}));
+    return kCaseOf[x];
+}
+
+void misra_cpp_6_4_2_violation(std::uint64_t n) {
+    std::int32_t x = 0;
+    bench::repeat(n, [&x] { bench::do_not_optimize(case_chain(x = (x + 1) & 3)); });
+}
+
+void misra_cpp_6_4_2_compliant(std::uint64_t n) {
+    std::int32_t x = 0;
+    bench::repeat(n, [&x] { bench::do_not_optimize(case_table(x = (x + 1) & 3)); });
+}
+
+void misra_cpp_27_0_1_violation(std::uint64_t n) {
+    bench::repeat(n, [] {
+        std::fprintf(g_devnull_file, "Formatted without cstdio: %d %.2f\n", bench::opaque(-42),
+                     2.5);
+    });
+    std::fflush(g_devnull_file);
+}
+
+void misra_cpp_27_0_1_compliant(std::uint64_t n) {
+    cs::fd_sink sink(g_devnull);
+    bench::repeat(n, [&sink] {
+        cs::format_to(sink, CS_FMT("Formatted without cstdio: {} {:.2}\n"), bench::opaque(-42), 2.5);
+    });
+}
+
+const rule_pair kPairs[] = {
+    {"misra_rule_21_3", "MISRA C 2012", misra_rule_21_3_violation, misra_rule_21_3_compliant},
+    {"misra_rule_10_3", "MISRA C 2012", misra_rule_10_3_violation, misra_rule_10_3_compliant},
+    {"misra_rule_17_7", "MISRA C 2012", misra_rule_17_7_violation, misra_rule_17_7_compliant},
+    {"misra_rule_10_1", "MISRA C 2012", misra_rule_10_1_violation, misra_rule_10_1_compliant},
+    {"misra_rule_12_1", "MISRA C 2012", misra_rule_12_1_violation, misra_rule_12_1_compliant},
+    {"misra_rule_21_6", "MISRA C 2012", misra_rule_21_6_violation, misra_rule_21_6_compliant},
+    {"cert_str31_c", "CERT C", cert_str31_c_violation, cert_str31_c_compliant},
+    {"cert_sig30_c", "CERT C", cert_sig30_c_violation, cert_sig30_c_compliant},
+    {"cert_arr30_c", "CERT C", cert_arr30_c_violation, cert_arr30_c_compliant},
+    {"cert_msc32_c", "CERT C", cert_msc32_c_violation, cert_msc32_c_compliant},
+    {"cert_int31_c", "CERT C", cert_int31_c_violation, cert_int31_c_compliant},
+    {"cert_mem30_c", "CERT C", cert_mem30_c_violation, cert_mem30_c_compliant},
+    {"cert_err33_c", "CERT C", cert_err33_c_violation, cert_err33_c_compliant},
+    {"cert_dcl30_c", "CERT C", cert_dcl30_c_violation, cert_dcl30_c_compliant},
+    {"autosar_a18_5_1", "AUTOSAR C++14", autosar_a18_5_1_violation, autosar_a18_5_1_compliant},
+    {"autosar_m5_0_3", "AUTOSAR C++14", autosar_m5_0_3_violation, autosar_m5_0_3_compliant},
+    {"autosar_a18_1_1", "AUTOSAR C++14", autosar_a18_1_1_violation, autosar_a18_1_1_compliant},
+    {"autosar_a15_1_2", "AUTOSAR C++14", autosar_a15_1_2_violation, autosar_a15_1_2_compliant},
+    {"autosar_a8_4_7", "AUTOSAR C++14", autosar_a8_4_7_violation, autosar_a8_4_7_compliant},
+    {"autosar_m6_4_1", "AUTOSAR C++14", autosar_m6_4_1_violation, autosar_m6_4_1_compliant},
+    {"autosar_a5_1_1", "AUTOSAR C++14", autosar_a5_1_1_violation, autosar_a5_1_1_compliant},
+    {"cert_dcl50_cpp", "CERT C++", cert_dcl50_cpp_violation, cert_dcl50_cpp_compliant},
+    {"cert_oop57_cpp", "CERT C++", cert_oop57_cpp_violation, cert_oop57_cpp_compliant},
+    {"cert_err61_cpp", "CERT C++", cert_err61_cpp_violation, cert_err61_cpp_compliant},
+    {"cert_msc50_cpp", "CERT C++", cert_msc50_cpp_violation, cert_msc50_cpp_compliant},
+    {"cert_oop51_cpp", "CERT C++", cert_oop51_cpp_violation, cert_oop51_cpp_compliant},
+    {"cert_ctr50_cpp", "CERT C++", cert_ctr50_cpp_violation, cert_ctr50_cpp_compliant},
+    {"cert_mem52_cpp", "CERT C++", cert_mem52_cpp_violation, cert_mem52_cpp_compliant},
+    {"cert_err58_cpp", "CERT C++", cert_err58_cpp_violation, cert_err58_cpp_compliant},
+    {"misra_cpp_18_4_1", "MISRA C++", misra_cpp_18_4_1_violation, misra_cpp_18_4_1_compliant},
+    {"misra_cpp_18_0_1", "MISRA C++", misra_cpp_18_0_1_violation, misra_cpp_18_0_1_compliant},
+    {"misra_cpp_15_3_5", "MISRA C++", misra_cpp_15_3_5_violation, misra_cpp_15_3_5_compliant},
+    {"misra_cpp_5_0_3", "MISRA C++", misra_cpp_5_0_3_violation, misra_cpp_5_0_3_compliant},
+    {"misra_cpp_6_6_5", "MISRA C++", misra_cpp_6_6_5_violation, misra_cpp_6_6_5_compliant},
+    {"misra_cpp_6_4_2", "MISRA C++", misra_cpp_6_4_2_violation, misra_cpp_6_4_2_compliant},
+    {"misra_cpp_27_0_1", "MISRA C++", misra_cpp_27_0_1_violation, misra_cpp_27_0_1_compliant},
+};
+
+void json_measurement(FILE *out, const char *key, const bench::measurement &m) {
+    std::fprintf(out,
+                 "      \"%s\": {\"ns_per_op\": %.4f, \"cycles_per_op\": %.3f, "
+                 "\"allocs_per_op\": %.4f, \"bytes_per_op\": %.2f, \"iterations\": %llu}",
+                 key, m.ns_per_op, m.cycles_per_op, m.allocs_per_op, m.bytes_per_op,
+                 static_cast<unsigned long long>(m.iterations));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const char *json_path = nullptr;
+    const char *filter = nullptr;
+    double min_time = 0.25;
+    for (int i = 1; i < argc; ++i) {
+        if ((std::strcmp(argv[i], "--json") == 0) && (i + 1 < argc)) {
+            json_path = argv[++i];
+        } else if ((std::strcmp(argv[i], "--filter") == 0) && (i + 1 < argc)) {
+            filter = argv[++i];
+        } else if ((std::strcmp(argv[i], "--min-time") == 0) && (i + 1 < argc)) {
+            min_time = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--json FILE] [--filter SUBSTRING] [--min-time S]\n",
+                         argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    g_devnull = open("/dev/null", O_WRONLY);
+    g_devnull_file = fdopen(dup(g_devnull), "w");
+    if ((g_devnull < 0) || (g_devnull_file == nullptr) ||
+        !pool_init(&g_pool, g_pool_storage, sizeof(g_pool_storage), sizeof(std::int32_t) * 10u) ||
+        !slot_map_init(&g_slots, g_slot_storage, sizeof(g_slot_storage), sizeof(std::int32_t),
+                       8u)) {
+        std::perror("setup");
+        return EXIT_FAILURE;
+    }
+    std::srand(1u);
+
+    FILE *json = stdout;
+    if (json_path != nullptr) {
+        json = std::fopen(json_path, "w");
+        if (json == nullptr) {
+            std::perror(json_path);
+            return EXIT_FAILURE;
+        }
+    }
+
+    bench::cycle_counter cycles;
+    std::fprintf(stderr, "%-18s %12s %12s %9s %12s %12s %9s %8s\n", "rule", "viol ns/op",
+                 "comp ns/op", "ratio", "viol allocs", "comp allocs", "comp cyc", "src");
+    std::fprintf(json, "{\n  \"cycles_source\": \"%s\",\n  \"results\": [", cycles.source());
+    bool first = true;
+    for (const rule_pair &p : kPairs) {
+        if ((filter != nullptr) && (std::strstr(p.rule, filter) == nullptr)) {
+            continue;
+        }
+        bench::measurement v = bench::measure(p.violation, cycles, min_time);
+        bench::measurement c = bench::measure(p.compliant, cycles, min_time);
+        double ratio = (v.ns_per_op > 0.0) ? (c.ns_per_op / v.ns_per_op) : 0.0;
+        std::fprintf(stderr, "%-18s %12.2f %12.2f %8.2fx %12.3f %12.3f %9.1f %8s\n", p.rule,
+                     v.ns_per_op, c.ns_per_op, ratio, v.allocs_per_op, c.allocs_per_op,
+                     c.cycles_per_op, cycles.source());
+
+        std::fprintf(json, "%s\n    {\n      \"rule\": \"%s\",\n      \"standard\": \"%s\",\n",
+                     first ? "" : ",", p.rule, p.standard);
+        json_measurement(json, "violation", v);
+        std::fprintf(json, ",\n");
+        json_measurement(json, "compliant", c);
+        std::fprintf(json, ",\n      \"compliant_over_violation\": %.4f\n    }", ratio);
+        first = false;
+    }
+    std::fprintf(json, "\n  ]\n}\n");
+
+    if (json != stdout) {
+        std::fclose(json);
+    }
+    std::fclose(g_devnull_file);
+    close(g_devnull);
+    return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file sig_ring_stress.cpp
+ * @brief Signal-storm stress test for the async-signal-safe event ring.
+ *
+ * Sender threads fire a real-time signal at a set of spinning target
+ * threads as fast as pthread_kill() allows; the handler records an event
+ * into the ring and
+ * a drain thread writes batches to /dev/null. The sweep over drain periods
+ * shows the drop rate once the consumer falls behind, and the drain
+ * throughput the batched write() path sustains.
+ *
+ * Usage: sig_ring_stress [seconds-per-case]
+ */
+
+#include "bench.hpp"
+#include "sig_ring.h"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+namespace {
+
+// Real-time signals queue instead of coalescing, so every send is delivered
+const int kStressSignal = SIGRTMIN;
+
+std::atomic<bool> g_running{false};
+std::atomic<std::uint64_t> g_handled{0u};
+
+void on_signal(int sig) {
+    std::uint64_t n = g_handled.fetch_add(1u, std::memory_order_relaxed);
+    static_cast<void>(sig_ring_record(sig_ring_default(), sig, 0, n, 0u));
+}
+
+void block_signal(int how) {
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, kStressSignal);
+    pthread_sigmask(how, &set, nullptr);
+}
+
+struct case_result {
+    double seconds;
+    std::uint64_t sent;
+    std::uint64_t handled;
+    sig_ring_stats_t ring;
+    std::uint64_t drain_calls;
+    double drain_busy_s;
+};
+
+case_result run_case(double seconds, unsigned senders, unsigned targets, unsigned drain_period_us,
+                     int sink_fd) {
+    sig_ring_t *ring = sig_ring_default();
+    sig_ring_stats_t before = sig_ring_get_stats(ring);
+    std::uint64_t handled_before = g_handled.load();
+
+    g_running.store(true);
+    std::vector<std::thread> target_threads;
+    std::vector<pthread_t> target_ids(targets);
+    std::atomic<unsigned> ready{0u};
+    for (unsigned i = 0u; i < targets; ++i) {
+        target_threads.emplace_back([&, i] {
+            target_ids[i] = pthread_self();
+            block_signal(SIG_UNBLOCK);
+            ready.fetch_add(1u);
+            while (g_running.load(std::memory_order_relaxed)) {
+                bench::clobber_memory();
+            }
+            block_signal(SIG_BLOCK);
+        });
+    }
+    while (ready.load() != targets) {
+        std::this_thread::yield();
+    }
+
+    std::atomic<std::uint64_t> sent{0u};
+    std::vector<std::thread> sender_threads;
+    for (unsigned s = 0u; s < senders; ++s) {
+        sender_threads.emplace_back([&, s] {
+            std::uint64_t local = 0u;
+            unsigned t = s;
+            while (g_running.load(std::memory_order_relaxed)) {
+                if (pthread_kill(target_ids[t % targets], kStressSignal) == 0) {
+                    ++local;
+                }
+                ++t;
+            }
+            sent.fetch_add(local);
+        });
+    }
+
+    std::uint64_t drain_calls = 0u;
+    std::uint64_t drain_busy_ns = 0u;
+    std::uint64_t start = bench::now_ns();
+    std::uint64_t stop = start + static_cast<std::uint64_t>(seconds * 1e9);
+    while (bench::now_ns() < stop) {
+        std::uint64_t t0 = bench::now_ns();
+        long n = sig_ring_drain(ring, sink_fd, SIG_RING_CAPACITY);
+        drain_busy_ns += bench::now_ns() - t0;
+        ++drain_calls;
+        if (n < 0) {
+            std::perror("sig_ring_drain");
+            std::exit(EXIT_FAILURE);
+        }
+        if (drain_period_us > 0u) {
+            usleep(drain_period_us);
+        }
+    }
+    g_running.store(false);
+    for (std::thread &th : sender_threads) {
+        th.join();
+    }
+    for (std::thread &th : target_threads) {
+        th.join();
+    }
+    double elapsed = static_cast<double>(bench::now_ns() - start) / 1e9;
+
+    // Empty the ring so the next case starts from the same state
+    while (sig_ring_drain(ring, sink_fd, SIG_RING_CAPACITY) > 0) {
+    }
+
+    sig_ring_stats_t after = sig_ring_get_stats(ring);
+    case_result r{};
+    r.seconds = elapsed;
+    r.sent = sent.load();
+    r.handled = g_handled.load() - handled_before;
+    r.ring.pushed = after.pushed - before.pushed;
+    r.ring.dropped = after.dropped - before.dropped;
+    r.ring.drained = after.drained - before.drained;
+    r.drain_calls = drain_calls;
+    r.drain_busy_s = static_cast<double>(drain_busy_ns) / 1e9;
+    return r;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    double seconds = (argc > 1) ? std::atof(argv[1]) : 1.0;
+    if (seconds <= 0.0) {
+        std::fprintf(stderr, "usage: %s [seconds-per-case]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Only the target threads take the signal
+    block_signal(SIG_BLOCK);
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(kStressSignal, &sa, nullptr) != 0) {
+        std::perror("sigaction");
+        return EXIT_FAILURE;
+    }
+
+    int sink = open("/dev/null", O_WRONLY);
+    if (sink < 0) {
+        std::perror("open /dev/null");
+        return EXIT_FAILURE;
+    }
+
+    unsigned hw = std::thread::hardware_concurrency();
+    unsigned targets = (hw > 2u) ? (hw / 2u) : 1u;
+    unsigned senders = targets;
+    std::printf("ring capacity %u, %u sender(s), %u target(s), %.1f s per case\n",
+                static_cast<unsigned>(SIG_RING_CAPACITY), senders, targets, seconds);
+    std::printf("%10s %12s %12s %10s %10s %8s %12s %9s %12s\n", "drain_us", "sent/s",
+                "handled/s", "pushed", "dropped", "drop%", "drained/s", "rec/call", "rec/drain_s");
+
+    const unsigned periods[] = {0u, 100u, 1000u, 10000u};
+    for (unsigned period : periods) {
+        case_result r = run_case(seconds, senders, targets, period, sink);
+        std::uint64_t offered = r.ring.pushed + r.ring.dropped;
+        double drop_pct = (offered > 0u)
+                              ? (100.0 * static_cast<double>(r.ring.dropped) / static_cast<double>(offered))
+                              : 0.0;
+        double busy_rate = (r.drain_busy_s > 0.0)
+                               ? (static_cast<double>(r.ring.drained) / r.drain_busy_s)
+                               : 0.0;
+        double per_call = (r.drain_calls > 0u) ? (static_cast<double>(r.ring.drained) /
+                                                  static_cast<double>(r.drain_calls))
+                                               : 0.0;
+        std::printf("%10u %12.0f %12.0f %10zu %10zu %7.2f%% %12.0f %9.1f %12.0f\n", period,
+                    static_cast<double>(r.sent) / r.seconds,
+                    static_cast<double>(r.handled) / r.seconds, r.ring.pushed, r.ring.dropped,
+                    drop_pct, static_cast<double>(r.ring.drained) / r.seconds, per_call,
+                    busy_rate);
+    }
+
+    close(sink);
+    return 0;
+}
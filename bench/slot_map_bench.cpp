@@ -0,0 +1,242 @@
+/**
+ * @file slot_map_bench.cpp
+ * @brief Generational handles (slot_map.h / slot_map.hpp, CERT C MEM30-C
+ * and DCL30-C) vs std::shared_ptr/std::weak_ptr and raw pointers.
+ *
+ * kLive 32-byte objects are referenced three ways: cs::slot_map handles
+ * (and the same through the C API), weak_ptrs to shared_ptr-owned objects,
+ * and raw pointers to unique_ptr-owned objects, the last being the unsafe
+ * baseline that cannot tell a dangling reference from a live one.
+ *
+ *   lookup   resolve a random reference and read the object
+ *   iterate  visit every live object once
+ *   churn    erase a random object and insert a replacement
+ *
+ * Reported: ns per operation (per object for iterate) and heap
+ * allocations per operation, with raw pointers as the reference.
+ */
+
+#include "alloc_count.hpp"
+#include "bench.hpp"
+#include "slot_map.h"
+#include "slot_map.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+
+struct entity {
+    double x;
+    double y;
+    double vx;
+    double vy;
+};
+
+constexpr std::size_t kCapacity = 1u << 16;
+constexpr std::size_t kLive = 50000u;
+constexpr std::size_t kPicks = 1u << 12;  // Power of two: the cursor wraps with a mask
+
+using entity_map = cs::slot_map<entity, kCapacity>;
+
+std::unique_ptr<entity_map> g_map;
+std::vector<slot_handle_t> g_handles;
+
+SLOT_MAP_DEFINE_STORAGE(g_c_storage, sizeof(entity), kCapacity);
+slot_map_t g_c_map;
+std::vector<slot_handle_t> g_c_handles;
+
+std::vector<std::shared_ptr<entity>> g_shared;
+std::vector<std::weak_ptr<entity>> g_weak;
+
+std::vector<std::unique_ptr<entity>> g_owned;
+std::vector<entity *> g_raw;
+
+std::vector<std::uint32_t> g_picks;  // Random reference indices in [0, kLive)
+std::size_t g_cursor = 0u;
+
+std::uint32_t next_pick() noexcept {
+    g_cursor = (g_cursor + 1u) & (kPicks - 1u);
+    return g_picks[g_cursor];
+}
+
+entity make_entity(std::uint32_t i) noexcept {
+    const double v = static_cast<double>(i);
+    return entity{v, -v, 1.0, 0.5};
+}
+
+/* ---- lookup ------------------------------------------------------------ */
+
+void lookup_slot(std::uint64_t n) {
+    bench::repeat(n, [] {
+        const entity *e = g_map->get(g_handles[next_pick()]);
+        bench::do_not_optimize((e != nullptr) ? e->x : 0.0);
+    });
+}
+
+void lookup_slot_c(std::uint64_t n) {
+    bench::repeat(n, [] {
+        const entity *e =
+            static_cast<const entity *>(slot_map_get(&g_c_map, g_c_handles[next_pick()]));
+        bench::do_not_optimize((e != nullptr) ? e->x : 0.0);
+    });
+}
+
+void lookup_weak(std::uint64_t n) {
+    bench::repeat(n, [] {
+        const std::shared_ptr<entity> e = g_weak[next_pick()].lock();
+        bench::do_not_optimize((e != nullptr) ? e->x : 0.0);
+    });
+}
+
+void lookup_raw(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(g_raw[next_pick()]->x); });
+}
+
+/* ---- iterate (one call visits kLive objects) --------------------------- */
+
+void iterate_slot(std::uint64_t n) {
+    bench::repeat(n, [] {
+        double s = 0.0;
+        for (const entity &e : *g_map) {
+            s += e.x;
+        }
+        bench::do_not_optimize(s);
+    });
+}
+
+void iterate_shared(std::uint64_t n) {
+    bench::repeat(n, [] {
+        double s = 0.0;
+        for (const std::shared_ptr<entity> &e : g_shared) {
+            s += e->x;
+        }
+        bench::do_not_optimize(s);
+    });
+}
+
+void iterate_raw(std::uint64_t n) {
+    bench::repeat(n, [] {
+        double s = 0.0;
+        for (const entity *e : g_raw) {
+            s += e->x;
+        }
+        bench::do_not_optimize(s);
+    });
+}
+
+/* ---- churn ------------------------------------------------------------- */
+
+void churn_slot(std::uint64_t n) {
+    bench::repeat(n, [] {
+        const std::uint32_t i = next_pick();
+        static_cast<void>(g_map->erase(g_handles[i]));
+        g_handles[i] = g_map->insert(make_entity(i));
+    });
+}
+
+void churn_slot_c(std::uint64_t n) {
+    bench::repeat(n, [] {
+        const std::uint32_t i = next_pick();
+        const entity e = make_entity(i);
+        static_cast<void>(slot_map_erase(&g_c_map, g_c_handles[i]));
+        g_c_handles[i] = slot_map_insert(&g_c_map, &e);
+    });
+}
+
+void churn_shared(std::uint64_t n) {
+    bench::repeat(n, [] {
+        const std::uint32_t i = next_pick();
+        g_shared[i] = std::make_shared<entity>(make_entity(i));
+        g_weak[i] = g_shared[i];
+    });
+}
+
+void churn_raw(std::uint64_t n) {
+    bench::repeat(n, [] {
+        const std::uint32_t i = next_pick();
+        g_owned[i].reset(new entity(make_entity(i)));
+        g_raw[i] = g_owned[i].get();
+    });
+}
+
+/* ---- Harness ----------------------------------------------------------- */
+
+bool setup() {
+    g_map.reset(new (std::nothrow) entity_map);
+    bool ok = (g_map != nullptr) && slot_map_init(&g_c_map, g_c_storage, sizeof(g_c_storage),
+                                                  sizeof(entity), kCapacity);
+    for (std::uint32_t i = 0u; ok && (i < kLive); ++i) {
+        const entity e = make_entity(i);
+        g_handles.push_back(g_map->insert(e));
+        g_c_handles.push_back(slot_map_insert(&g_c_map, &e));
+        g_shared.push_back(std::make_shared<entity>(e));
+        g_weak.push_back(g_shared.back());
+        g_owned.emplace_back(new entity(e));
+        g_raw.push_back(g_owned.back().get());
+    }
+    std::uint32_t s = 2463534242u;
+    for (std::size_t i = 0u; i < kPicks; ++i) {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        g_picks.push_back(s % static_cast<std::uint32_t>(kLive));
+    }
+    // Stale handles must miss, and every live one must hit the right object
+    const slot_handle_t stale = g_handles[0];
+    ok = ok && g_map->erase(stale) && (g_map->get(stale) == nullptr);
+    g_handles[0] = g_map->insert(make_entity(0u));
+    for (std::uint32_t i = 0u; ok && (i < kLive); ++i) {
+        const entity *a = g_map->get(g_handles[i]);
+        const entity *b = static_cast<const entity *>(slot_map_get(&g_c_map, g_c_handles[i]));
+        ok = (a != nullptr) && (b != nullptr) && (a->x == g_raw[i]->x) && (b->x == a->x);
+    }
+    return ok;
+}
+
+struct bench_case {
+    const char *group;
+    const char *how;
+    void (*fn)(std::uint64_t);
+    double per;  // Operations per call
+    bool reference;
+};
+
+const bench_case kCases[] = {
+    {"lookup", "raw pointer", lookup_raw, 1.0, true},
+    {"lookup", "slot_map", lookup_slot, 1.0, false},
+    {"lookup", "slot_map (C)", lookup_slot_c, 1.0, false},
+    {"lookup", "weak_ptr::lock", lookup_weak, 1.0, false},
+    {"iterate", "raw pointer", iterate_raw, static_cast<double>(kLive), true},
+    {"iterate", "slot_map", iterate_slot, static_cast<double>(kLive), false},
+    {"iterate", "shared_ptr", iterate_shared, static_cast<double>(kLive), false},
+    {"churn", "new/delete", churn_raw, 1.0, true},
+    {"churn", "slot_map", churn_slot, 1.0, false},
+    {"churn", "slot_map (C)", churn_slot_c, 1.0, false},
+    {"churn", "make_shared", churn_shared, 1.0, false},
+};
+
+}  // namespace
+
+int main() {
+    if (!setup()) {
+        std::fprintf(stderr, "slot map setup or handle check failed\n");
+        return EXIT_FAILURE;
+    }
+    bench::cycle_counter cycles;
+    std::printf("%zu live objects of %zu bytes\n", kLive, sizeof(entity));
+    std::printf("%-8s %-16s %10s %10s %8s\n", "op", "how", "ns/op", "allocs/op", "x ref");
+    double ref_ns = 1.0;
+    for (const bench_case &c : kCases) {
+        const bench::measurement m = bench::measure(c.fn, cycles, 0.25, 5);
+        const double ns = m.ns_per_op / c.per;
+        ref_ns = c.reference ? ns : ref_ns;
+        std::printf("%-8s %-16s %10.2f %10.2f %8.2f\n", c.group, c.how, ns,
+                    m.allocs_per_op / c.per, ns / ref_ns);
+    }
+    return 0;
+}
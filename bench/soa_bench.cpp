@@ -0,0 +1,263 @@
+/**
+ * @file soa_bench.cpp
+ * @brief Bulk copy and memory layout costs for SimpleData-style {x, y}
+ * point records (CERT C++ OOP57-CPP).
+ *
+ * Copy: one pass over kPoints records, as an element-wise assignment loop
+ * and through cs::copy_assign_n / cs::relocate_n (relocate.hpp). The
+ * labelled type has a user-provided copy constructor and assignment, so
+ * it is not trivially copyable and takes the element-wise path of the
+ * same helpers.
+ *
+ * Layout: the same points as an array of structs and as a cs::soa_xy
+ * (soa_xy.hpp), reduced three ways: x only, sum of x and y, and a
+ * bounding box; plus the cost of converting between the two layouts.
+ *
+ * Both parts run at an in-cache size and a DRAM-sized one. Reported:
+ * ns and GB/s per pass, with the AoS/element-wise row as the reference.
+ */
+
+#include "bench.hpp"
+#include "relocate.hpp"
+#include "soa_xy.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kMaxPoints = 1u << 21;
+
+struct SimpleData {
+    std::int32_t x;
+    std::int32_t y;
+};
+
+/** Same bytes as SimpleData, but its copy operations are user-provided. */
+struct labelled {
+    labelled() noexcept : x(0), y(0) {}
+    labelled(std::int32_t x0, std::int32_t y0) noexcept : x(x0), y(y0) {}
+    labelled(const labelled &other) noexcept : x(other.x), y(other.y) {}
+    labelled &operator=(const labelled &other) noexcept {
+        x = other.x;
+        y = other.y;
+        return *this;
+    }
+    std::int32_t x;
+    std::int32_t y;
+};
+
+using points = cs::soa_xy<std::int32_t, kMaxPoints, cs::bounds::unchecked>;
+
+std::size_t g_n = 0u;
+std::vector<SimpleData> g_aos_src;
+std::vector<SimpleData> g_aos_dst;
+std::vector<labelled> g_lab_src;
+std::vector<labelled> g_lab_dst;
+SimpleData *g_raw = nullptr;
+std::unique_ptr<points> g_soa;
+
+/* ---- Copy -------------------------------------------------------------- */
+
+__attribute__((noinline)) void assign_loop(const SimpleData *src, std::size_t n, SimpleData *dst) {
+    for (std::size_t i = 0u; i < n; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+__attribute__((noinline)) void assign_loop_labelled(const labelled *src, std::size_t n,
+                                                    labelled *dst) {
+    for (std::size_t i = 0u; i < n; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+void copy_simple_loop(std::uint64_t n) {
+    bench::repeat(n, [] { assign_loop(g_aos_src.data(), g_n, g_aos_dst.data()); });
+    bench::clobber_memory();
+}
+
+void copy_simple_helper(std::uint64_t n) {
+    bench::repeat(n, [] { cs::copy_assign_n(g_aos_src.data(), g_n, g_aos_dst.data()); });
+    bench::clobber_memory();
+}
+
+void copy_labelled_loop(std::uint64_t n) {
+    bench::repeat(n, [] { assign_loop_labelled(g_lab_src.data(), g_n, g_lab_dst.data()); });
+    bench::clobber_memory();
+}
+
+void copy_labelled_helper(std::uint64_t n) {
+    bench::repeat(n, [] { cs::copy_assign_n(g_lab_src.data(), g_n, g_lab_dst.data()); });
+    bench::clobber_memory();
+}
+
+/** Relocate into raw storage and back, so every pass starts from live sources. */
+void relocate_simple(std::uint64_t n) {
+    bench::repeat(n, [] {
+        cs::relocate_n(g_aos_src.data(), g_n, g_raw);
+        cs::relocate_n(g_raw, g_n, g_aos_src.data());
+    });
+    bench::clobber_memory();
+}
+
+/* ---- Layout ------------------------------------------------------------ */
+
+__attribute__((noinline)) std::int64_t aos_sum_x(const SimpleData *p, std::size_t n) {
+    std::int64_t s = 0;
+    for (std::size_t i = 0u; i < n; ++i) {
+        s += p[i].x;
+    }
+    return s;
+}
+
+__attribute__((noinline)) std::int64_t soa_sum_x(cs::span<const std::int32_t> xs) {
+    std::int64_t s = 0;
+    for (std::int32_t x : xs) {
+        s += x;
+    }
+    return s;
+}
+
+__attribute__((noinline)) points::sums aos_sum(const SimpleData *p, std::size_t n) {
+    points::sums s{0, 0};
+    for (std::size_t i = 0u; i < n; ++i) {
+        s.x += p[i].x;
+        s.y += p[i].y;
+    }
+    return s;
+}
+
+__attribute__((noinline)) points::box aos_bounds(const SimpleData *p, std::size_t n) {
+    points::box b{p[0].x, p[0].y, p[0].x, p[0].y};
+    for (std::size_t i = 1u; i < n; ++i) {
+        b.min_x = (p[i].x < b.min_x) ? p[i].x : b.min_x;
+        b.min_y = (p[i].y < b.min_y) ? p[i].y : b.min_y;
+        b.max_x = (p[i].x > b.max_x) ? p[i].x : b.max_x;
+        b.max_y = (p[i].y > b.max_y) ? p[i].y : b.max_y;
+    }
+    return b;
+}
+
+void sum_x_aos(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(aos_sum_x(g_aos_src.data(), g_n)); });
+}
+
+void sum_x_soa(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(soa_sum_x(g_soa->xs())); });
+}
+
+void sum_xy_aos(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(aos_sum(g_aos_src.data(), g_n)); });
+}
+
+void sum_xy_soa(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(g_soa->sum()); });
+}
+
+void bounds_aos(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(aos_bounds(g_aos_src.data(), g_n)); });
+}
+
+void bounds_soa(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(g_soa->bounds()); });
+}
+
+void to_soa(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(g_soa->assign(g_aos_src.data(), g_n)); });
+    bench::clobber_memory();
+}
+
+void to_aos(std::uint64_t n) {
+    bench::repeat(n, [] { g_soa->store(g_aos_dst.data()); });
+    bench::clobber_memory();
+}
+
+/* ---- Harness ----------------------------------------------------------- */
+
+void setup(std::size_t n) {
+    g_n = n;
+    g_aos_src.assign(n, SimpleData{0, 0});
+    g_aos_dst.assign(n, SimpleData{0, 0});
+    g_lab_src.assign(n, labelled{});
+    g_lab_dst.assign(n, labelled{});
+    std::uint32_t s = 12345u;
+    for (std::size_t i = 0u; i < n; ++i) {
+        s = (s * 1664525u) + 1013904223u;
+        const std::int32_t x = static_cast<std::int32_t>(s >> 8) - (1 << 23);
+        const std::int32_t y = static_cast<std::int32_t>(s & 0xFFFFu) - (1 << 15);
+        g_aos_src[i] = SimpleData{x, y};
+        g_lab_src[i] = labelled{x, y};
+    }
+    static_cast<void>(g_soa->assign(g_aos_src.data(), n));
+}
+
+bool check() {
+    const points::sums soa = g_soa->sum();
+    const points::sums aos = aos_sum(g_aos_src.data(), g_n);
+    const points::box sb = g_soa->bounds();
+    const points::box ab = aos_bounds(g_aos_src.data(), g_n);
+    return (soa.x == aos.x) && (soa.y == aos.y) && (soa.x == soa_sum_x(g_soa->xs())) &&
+           (sb.min_x == ab.min_x) && (sb.min_y == ab.min_y) && (sb.max_x == ab.max_x) &&
+           (sb.max_y == ab.max_y);
+}
+
+struct bench_case {
+    const char *group;
+    const char *how;
+    void (*fn)(std::uint64_t);
+    double bytes_per_point;  // Bytes each pass moves, for GB/s
+    bool reference;
+};
+
+const bench_case kCases[] = {
+    {"copy SimpleData", "assignment loop", copy_simple_loop, 16.0, true},
+    {"copy SimpleData", "copy_assign_n", copy_simple_helper, 16.0, false},
+    {"copy SimpleData", "relocate_n x2", relocate_simple, 32.0, false},
+    {"copy labelled", "assignment loop", copy_labelled_loop, 16.0, true},
+    {"copy labelled", "copy_assign_n", copy_labelled_helper, 16.0, false},
+    {"sum x", "AoS", sum_x_aos, 8.0, true},
+    {"sum x", "SoA", sum_x_soa, 4.0, false},
+    {"sum x, y", "AoS", sum_xy_aos, 8.0, true},
+    {"sum x, y", "SoA", sum_xy_soa, 8.0, false},
+    {"bounds", "AoS", bounds_aos, 8.0, true},
+    {"bounds", "SoA", bounds_soa, 8.0, false},
+    {"convert", "AoS -> SoA", to_soa, 16.0, true},
+    {"convert", "SoA -> AoS", to_aos, 16.0, false},
+};
+
+}  // namespace
+
+int main() {
+    g_soa.reset(new (std::nothrow) points);
+    g_raw = static_cast<SimpleData *>(std::malloc(kMaxPoints * sizeof(SimpleData)));
+    if ((g_soa == nullptr) || (g_raw == nullptr)) {
+        std::fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+    bench::cycle_counter cycles;
+    const std::size_t sizes[] = {4096u, kMaxPoints};
+    for (std::size_t n : sizes) {
+        setup(n);
+        if (!check()) {
+            std::fprintf(stderr, "AoS and SoA reductions disagree at %zu points\n", n);
+            return EXIT_FAILURE;
+        }
+        std::printf("\n%zu points (%zu KiB as AoS)\n", n, (n * sizeof(SimpleData)) / 1024u);
+        std::printf("%-16s %-16s %12s %8s %8s\n", "operation", "how", "ns/pass", "GB/s", "x ref");
+        double ref_ns = 1.0;
+        for (const bench_case &c : kCases) {
+            const bench::measurement m = bench::measure(c.fn, cycles, 0.25, 5);
+            ref_ns = c.reference ? m.ns_per_op : ref_ns;
+            const double gbs = (c.bytes_per_point * static_cast<double>(n)) / m.ns_per_op;
+            std::printf("%-16s %-16s %12.0f %8.2f %8.2f\n", c.group, c.how, m.ns_per_op, gbs,
+                        m.ns_per_op / ref_ns);
+        }
+    }
+    std::free(g_raw);
+    return 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file span_bench.cpp
+ * @brief What AUTOSAR A8-4-7 costs: passing a std::vector<int> by value
+ * versus by reference to const versus as a cs::span<const int>.
+ *
+ * The callee is out of line and reads only the first and last elements,
+ * so the numbers are the parameter-passing cost and nothing else. The
+ * vector size sweeps 1..10M elements; the by-value column grows with the
+ * size (one heap allocation plus a full copy per call), the other two do
+ * not. Allocations are counted through alloc_count.hpp.
+ */
+
+#include "alloc_count.hpp"
+#include "bench.hpp"
+#include "span.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const std::vector<int> *g_data = nullptr;
+
+__attribute__((noinline)) int by_value(std::vector<int> data) {
+    return data.front() + data.back();
+}
+
+__attribute__((noinline)) int by_const_ref(const std::vector<int> &data) {
+    return data.front() + data.back();
+}
+
+__attribute__((noinline)) int by_span(cs::span<const int> data) {
+    return data.front() + data.back();
+}
+
+void run_by_value(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(by_value(*bench::opaque(g_data))); });
+}
+
+void run_by_const_ref(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(by_const_ref(*bench::opaque(g_data))); });
+}
+
+void run_by_span(std::uint64_t n) {
+    bench::repeat(n, [] { bench::do_not_optimize(by_span(*bench::opaque(g_data))); });
+}
+
+void row(std::size_t elems, const char *how, const bench::measurement &m,
+         const bench::measurement &ref) {
+    std::printf("%10zu  %-10s %12.1f %10.1f %8.2f %12.0f\n", elems, how, m.ns_per_op,
+                m.ns_per_op / ref.ns_per_op, m.allocs_per_op, m.bytes_per_op);
+}
+
+}  // namespace
+
+int main() {
+    bench::cycle_counter cycles;
+    std::printf("%10s  %-10s %12s %10s %8s %12s\n", "elements", "passing", "ns/call", "x ref",
+                "allocs", "bytes/call");
+    for (std::size_t elems = 1u; elems <= 10000000u; elems *= 10u) {
+        std::vector<int> data(elems, 1);
+        g_data = &data;
+        bench::measurement ref = bench::measure(run_by_const_ref, cycles, 0.05, 3);
+        row(elems, "by value", bench::measure(run_by_value, cycles, 0.05, 3), ref);
+        row(elems, "const &", ref, ref);
+        row(elems, "span", bench::measure(run_by_span, cycles, 0.05, 3), ref);
+    }
+    return 0;
+}
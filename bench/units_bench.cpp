@@ -0,0 +1,270 @@
+/**
+ * @file units_bench.cpp
+ * @brief Batch timestamp conversion with cs::units (AUTOSAR A5-1-1) vs a
+ * bare multiply or divide and std::chrono::duration_cast.
+ *
+ * Three conversions over arrays of counts: nanoseconds to microseconds and
+ * seconds to 32-bit hours (down-scaling), and 32-bit hours to nanoseconds
+ * (up-scaling, where large inputs overflow). Each runs as the unchecked
+ * `v / 1000` / `v * 3600` loop the rule flags, a duration_cast loop (also
+ * unchecked), checked_cast per element, and one saturate_n call per batch.
+ * The timed inputs all convert without overflow, since overflowing the
+ * unchecked rows would be undefined; the checks cost the same either way,
+ * and the start-up check covers the out-of-range results. Reported: ns per
+ * element at an in-cache and a DRAM-sized batch, with the unchecked loop
+ * as the reference.
+ */
+
+#include "bench.hpp"
+#include "units.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+namespace u = cs::units;
+
+constexpr std::size_t kMaxCount = 1u << 20;
+
+std::size_t g_n = 0u;
+std::vector<std::int64_t> g_ns;
+std::vector<std::int64_t> g_sec;
+std::vector<std::int32_t> g_hours;
+std::vector<std::int64_t> g_out64;
+std::vector<std::int32_t> g_out32;
+
+/* ---- ns -> us ---------------------------------------------------------- */
+
+__attribute__((noinline)) void ns_to_us_raw(const std::int64_t *in, std::int64_t *out,
+                                            std::size_t n) {
+    for (std::size_t i = 0u; i < n; ++i) {
+        out[i] = in[i] / 1000;
+    }
+}
+
+__attribute__((noinline)) void ns_to_us_chrono(const std::int64_t *in, std::int64_t *out,
+                                               std::size_t n) {
+    for (std::size_t i = 0u; i < n; ++i) {
+        out[i] = std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::nanoseconds(in[i]))
+                     .count();
+    }
+}
+
+/* ---- s -> h (int32) ---------------------------------------------------- */
+
+__attribute__((noinline)) void s_to_h_raw(const std::int64_t *in, std::int32_t *out,
+                                          std::size_t n) {
+    for (std::size_t i = 0u; i < n; ++i) {
+        out[i] = static_cast<std::int32_t>(in[i] / 3600);
+    }
+}
+
+__attribute__((noinline)) void s_to_h_chrono(const std::int64_t *in, std::int32_t *out,
+                                             std::size_t n) {
+    using hours32 = std::chrono::duration<std::int32_t, std::ratio<3600>>;
+    for (std::size_t i = 0u; i < n; ++i) {
+        out[i] = std::chrono::duration_cast<hours32>(std::chrono::seconds(in[i])).count();
+    }
+}
+
+/* ---- h (int32) -> ns --------------------------------------------------- */
+
+__attribute__((noinline)) void h_to_ns_raw(const std::int32_t *in, std::int64_t *out,
+                                           std::size_t n) {
+    for (std::size_t i = 0u; i < n; ++i) {
+        out[i] = in[i] * 3600000000000;
+    }
+}
+
+__attribute__((noinline)) void h_to_ns_chrono(const std::int32_t *in, std::int64_t *out,
+                                              std::size_t n) {
+    using hours32 = std::chrono::duration<std::int32_t, std::ratio<3600>>;
+    for (std::size_t i = 0u; i < n; ++i) {
+        out[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(hours32(in[i])).count();
+    }
+}
+
+/* ---- cs::units, generic over the conversion ---------------------------- */
+
+template <typename To, typename From>
+__attribute__((noinline)) std::size_t checked_loop(const typename From::rep *in,
+                                                   typename To::rep *out, std::size_t n) {
+    std::size_t failed = 0u;
+    for (std::size_t i = 0u; i < n; ++i) {
+        const cs::expected<To, std::errc> r = u::checked_cast<To>(From(in[i]));
+        if (r.has_value()) {
+            out[i] = r.value().count();
+        } else {
+            out[i] = 0;
+            ++failed;
+        }
+    }
+    return failed;
+}
+
+template <typename To, typename From>
+__attribute__((noinline)) std::size_t batch(const typename From::rep *in, typename To::rep *out,
+                                            std::size_t n) {
+    return u::saturate_n<To, From>(in, out, n);
+}
+
+void a_raw(std::uint64_t n) {
+    bench::repeat(n, [] { ns_to_us_raw(g_ns.data(), g_out64.data(), g_n); });
+    bench::clobber_memory();
+}
+void a_chrono(std::uint64_t n) {
+    bench::repeat(n, [] { ns_to_us_chrono(g_ns.data(), g_out64.data(), g_n); });
+    bench::clobber_memory();
+}
+void a_checked(std::uint64_t n) {
+    bench::repeat(n, [] {
+        bench::do_not_optimize(
+            checked_loop<u::microseconds, u::nanoseconds>(g_ns.data(), g_out64.data(), g_n));
+    });
+}
+void a_batch(std::uint64_t n) {
+    bench::repeat(n, [] {
+        bench::do_not_optimize(
+            batch<u::microseconds, u::nanoseconds>(g_ns.data(), g_out64.data(), g_n));
+    });
+}
+
+void b_raw(std::uint64_t n) {
+    bench::repeat(n, [] { s_to_h_raw(g_sec.data(), g_out32.data(), g_n); });
+    bench::clobber_memory();
+}
+void b_chrono(std::uint64_t n) {
+    bench::repeat(n, [] { s_to_h_chrono(g_sec.data(), g_out32.data(), g_n); });
+    bench::clobber_memory();
+}
+void b_checked(std::uint64_t n) {
+    bench::repeat(n, [] {
+        bench::do_not_optimize(
+            checked_loop<u::hours32, u::seconds>(g_sec.data(), g_out32.data(), g_n));
+    });
+}
+void b_batch(std::uint64_t n) {
+    bench::repeat(n, [] {
+        bench::do_not_optimize(batch<u::hours32, u::seconds>(g_sec.data(), g_out32.data(), g_n));
+    });
+}
+
+void c_raw(std::uint64_t n) {
+    bench::repeat(n, [] { h_to_ns_raw(g_hours.data(), g_out64.data(), g_n); });
+    bench::clobber_memory();
+}
+void c_chrono(std::uint64_t n) {
+    bench::repeat(n, [] { h_to_ns_chrono(g_hours.data(), g_out64.data(), g_n); });
+    bench::clobber_memory();
+}
+void c_checked(std::uint64_t n) {
+    bench::repeat(n, [] {
+        bench::do_not_optimize(
+            checked_loop<u::nanoseconds, u::hours32>(g_hours.data(), g_out64.data(), g_n));
+    });
+}
+void c_batch(std::uint64_t n) {
+    bench::repeat(n, [] {
+        bench::do_not_optimize(
+            batch<u::nanoseconds, u::hours32>(g_hours.data(), g_out64.data(), g_n));
+    });
+}
+
+/* ---- Harness ----------------------------------------------------------- */
+
+void setup() {
+    g_ns.resize(kMaxCount);
+    g_sec.resize(kMaxCount);
+    g_hours.resize(kMaxCount);
+    g_out64.resize(kMaxCount);
+    g_out32.resize(kMaxCount);
+    std::uint64_t s = 88172645463325252u;
+    for (std::size_t i = 0u; i < kMaxCount; ++i) {
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        // Nanosecond timestamps around now, and a mix of signs for the rest
+        g_ns[i] = static_cast<std::int64_t>(1700000000000000000u + (s >> 4));
+        g_sec[i] = static_cast<std::int64_t>(s >> 24) - (INT64_C(1) << 39);
+        g_hours[i] = static_cast<std::int32_t>(s & 0xFFFFFu) - (1 << 19);
+    }
+}
+
+/** saturate_n agrees with the unchecked loops, and clamps what they would overflow. */
+bool check() {
+    std::vector<std::int64_t> ref(kMaxCount);
+    std::vector<std::int32_t> ref32(kMaxCount);
+    ns_to_us_raw(g_ns.data(), ref.data(), kMaxCount);
+    bool ok = batch<u::microseconds, u::nanoseconds>(g_ns.data(), g_out64.data(), kMaxCount) == 0u;
+    ok = ok && (ref == g_out64);
+    s_to_h_raw(g_sec.data(), ref32.data(), kMaxCount);
+    ok = ok && (batch<u::hours32, u::seconds>(g_sec.data(), g_out32.data(), kMaxCount) == 0u);
+    ok = ok && (ref32 == g_out32);
+    h_to_ns_raw(g_hours.data(), ref.data(), kMaxCount);
+    ok = ok && (batch<u::nanoseconds, u::hours32>(g_hours.data(), g_out64.data(), kMaxCount) == 0u);
+    ok = ok && (ref == g_out64);
+    // About 2.56 million hours is the most an int64_t of nanoseconds holds
+    const std::int32_t edge[] = {2562047, 2562048, -2562047, -2562048, INT32_MAX, INT32_MIN};
+    const std::int64_t want[] = {INT64_C(2562047) * INT64_C(3600000000000), INT64_MAX,
+                                 INT64_C(-2562047) * INT64_C(3600000000000), INT64_MIN,
+                                 INT64_MAX, INT64_MIN};
+    std::int64_t got[6] = {};
+    ok = ok && (batch<u::nanoseconds, u::hours32>(edge, got, 6u) == 4u);
+    ok = ok && (checked_loop<u::nanoseconds, u::hours32>(edge, ref.data(), 6u) == 4u);
+    for (std::size_t i = 0u; i < 6u; ++i) {
+        ok = ok && (got[i] == want[i]);
+    }
+    return ok;
+}
+
+struct bench_case {
+    const char *group;
+    const char *how;
+    void (*fn)(std::uint64_t);
+    bool reference;
+};
+
+const bench_case kCases[] = {
+    {"ns -> us", "v / 1000", a_raw, true},
+    {"ns -> us", "duration_cast", a_chrono, false},
+    {"ns -> us", "checked_cast", a_checked, false},
+    {"ns -> us", "saturate_n", a_batch, false},
+    {"s -> h32", "v / 3600", b_raw, true},
+    {"s -> h32", "duration_cast", b_chrono, false},
+    {"s -> h32", "checked_cast", b_checked, false},
+    {"s -> h32", "saturate_n", b_batch, false},
+    {"h32 -> ns", "v * 3600e9", c_raw, true},
+    {"h32 -> ns", "duration_cast", c_chrono, false},
+    {"h32 -> ns", "checked_cast", c_checked, false},
+    {"h32 -> ns", "saturate_n", c_batch, false},
+};
+
+}  // namespace
+
+int main() {
+    setup();
+    if (!check()) {
+        std::fprintf(stderr, "cs::units conversions disagree with the reference\n");
+        return EXIT_FAILURE;
+    }
+    bench::cycle_counter cycles;
+    const std::size_t sizes[] = {4096u, kMaxCount};
+    for (std::size_t n : sizes) {
+        g_n = n;
+        std::printf("\n%zu counts\n", n);
+        std::printf("%-10s %-14s %10s %8s\n", "convert", "how", "ns/elem", "x ref");
+        double ref_ns = 1.0;
+        for (const bench_case &c : kCases) {
+            const bench::measurement m = bench::measure(c.fn, cycles, 0.25, 5);
+            const double per = m.ns_per_op / static_cast<double>(n);
+            ref_ns = c.reference ? per : ref_ns;
+            std::printf("%-10s %-14s %10.3f %8.2f\n", c.group, c.how, per, per / ref_ns);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file big_array.hpp
+ * @brief C++14 array of up to billions of trivial elements, backed by a
+ * reserve-then-commit vm_region (vm_region.h).
+ *
+ * Compliant alternative for CERT C++ MEM52-CPP. `new (std::nothrow)
+ * int[1000000000]` fails, when it fails at all, by returning a null
+ * pointer that is easy to dereference. cs::big_array reports every failure
+ * as a cs::expected error carrying the errno, and the array only becomes
+ * usable after that check has been made:
+ *
+ *   auto a = cs::big_array<std::int32_t>::reserve(1000000000u);
+ *   if (a && a.value().resize(n)) { a.value()[0] = 42; }
+ *
+ * reserve() takes address space for the maximum size without committing
+ * memory; resize() commits the prefix that covers size() elements, in
+ * chunks, so growing never copies or moves elements and pointers into the
+ * array stay valid. New elements are zero. Shrinking returns the pages
+ * beyond the new size, and the commit charge for them, to the kernel.
+ * Element access goes through the
+ * bounds policy of bounds.hpp.
+ */
+
+#ifndef BIG_ARRAY_HPP
+#define BIG_ARRAY_HPP
+
+#include "bounds.hpp"
+#include "expected.hpp"
+#include "span.hpp"
+#include "vm_region.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace cs {
+
+struct big_array_options {
+    std::size_t chunk_bytes = VM_DEFAULT_CHUNK;  // Commit granularity
+    bool huge_pages = false;                     // Transparent huge pages (madvise)
+    bool populate = false;                       // Pre-fault each committed chunk
+};
+
+template <typename T, typename Policy = bounds::standard>
+class big_array {
+public:
+    static_assert(std::is_trivial<T>::value,
+                  "big_array elements start as zero bytes and are never constructed");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    /** Reserve room for max_elements; nothing is committed yet. */
+    static expected<big_array, std::errc> reserve(size_type max_elements,
+                                                  big_array_options options = {}) noexcept {
+        expected<big_array, std::errc> result = make_unexpected(std::errc::value_too_large);
+        if (max_elements <= (std::numeric_limits<size_type>::max() / sizeof(T))) {
+            big_array a;
+            const std::uint32_t flags = (options.huge_pages ? VM_HUGE_PAGES : 0u) |
+                                        (options.populate ? VM_POPULATE : 0u);
+            const int err = vm_reserve(&a.region_, max_elements * sizeof(T), options.chunk_bytes,
+                                       flags);
+            if (err == 0) {
+                a.max_ = max_elements;
+                result = std::move(a);
+            } else {
+                result = make_unexpected(static_cast<std::errc>(err));
+            }
+        }
+        return result;
+    }
+
+    big_array() noexcept : region_{} {}
+
+    big_array(big_array &&other) noexcept : region_(other.region_), size_(other.size_),
+                                            max_(other.max_) {
+        other.forget();
+    }
+
+    big_array &operator=(big_array &&other) noexcept {
+        if (this != &other) {
+            vm_release(&region_);
+            region_ = other.region_;
+            size_ = other.size_;
+            max_ = other.max_;
+            other.forget();
+        }
+        return *this;
+    }
+
+    big_array(const big_array &) = delete;
+    big_array &operator=(const big_array &) = delete;
+
+    ~big_array() { vm_release(&region_); }
+
+    /**
+     * Set the size to n elements, committing or returning memory as
+     * needed; on error the size is unchanged. std::errc::result_out_of_range
+     * if n exceeds the reservation, otherwise the errno from the kernel
+     * (ENOMEM when the commit is refused).
+     */
+    expected<void, std::errc> resize(size_type n) noexcept {
+        expected<void, std::errc> result;
+        const int err = (n > max_) ? ERANGE
+                        : (n >= size_) ? vm_commit(&region_, n * sizeof(T))
+                                       : vm_decommit(&region_, n * sizeof(T));
+        if (err == 0) {
+            if (n < size_) {
+                // Elements cut off inside a still-committed chunk must read as zero again
+                const size_type kept = region_.committed / sizeof(T);
+                const size_type dirty_end = (size_ < kept) ? size_ : kept;
+                if (dirty_end > n) {
+                    std::memset(static_cast<void *>(data() + n), 0, (dirty_end - n) * sizeof(T));
+                }
+            }
+            size_ = n;
+        } else {
+            result = make_unexpected(static_cast<std::errc>(err));
+        }
+        return result;
+    }
+
+    T &operator[](size_type i) noexcept { return data()[Policy::index(i, size_)]; }
+    const T &operator[](size_type i) const noexcept { return data()[Policy::index(i, size_)]; }
+
+    T *data() noexcept { return reinterpret_cast<T *>(region_.base); }
+    const T *data() const noexcept { return reinterpret_cast<const T *>(region_.base); }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size_; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size_; }
+
+    operator span<T>() noexcept { return span<T>(data(), size_); }
+    operator span<const T>() const noexcept { return span<const T>(data(), size_); }
+
+    size_type size() const noexcept { return size_; }
+    /** Elements the reservation can hold. */
+    size_type max_size() const noexcept { return max_; }
+    /** Elements already committed: resize() up to here cannot fail. */
+    size_type capacity() const noexcept {
+        return (region_.committed / sizeof(T) < max_) ? (region_.committed / sizeof(T)) : max_;
+    }
+    bool empty() const noexcept { return size_ == 0u; }
+
+private:
+    void forget() noexcept {
+        region_ = vm_region_t{};
+        size_ = 0u;
+        max_ = 0u;
+    }
+
+    vm_region_t region_;
+    size_type size_ = 0u;
+    size_type max_ = 0u;
+};
+
+}  // namespace cs
+
+#endif  // BIG_ARRAY_HPP
@@ -0,0 +1,148 @@
+/**
+ * @file bits.h
+ * @brief Shifts, rotates, popcount, byte access and bitfields on uint8_t ..
+ * uint64_t without integer promotion, plus bulk buffer kernels (C11).
+ *
+ * Compliant alternative for MISRA C 2012 Rules 10.1 and 12.1 and
+ * Directive 4.6. `c << 2` on a uint8_t silently becomes a signed int
+ * shift; here each operand is converted explicitly to an unsigned type at
+ * least as wide as int, the result is narrowed back explicitly, and every
+ * operation is a named function, so precedence is never in question.
+ * Out-of-range counts are defined: shifts by >= the width give 0,
+ * rotates take the count modulo the width, and fields or bytes outside
+ * the value read as 0 and are not written.
+ *
+ * For each width W in 8, 16, 32, 64 this header defines (static inline):
+ *   bits_shl_uW(v, n), bits_shr_uW(v, n)     logical shifts
+ *   bits_rotl_uW(v, n), bits_rotr_uW(v, n)   rotates (compile to rol/ror)
+ *   bits_popcount_uW(v)                      number of set bits
+ *   bits_byte_uW(v, i)                       byte i, 0 = least significant
+ *   bits_get_uW(v, lsb, width)               unpack a bitfield
+ *   bits_set_uW(v, lsb, width, field)        pack a bitfield
+ * and bits_load_be16/32/64 / bits_store_be16/32/64 for network byte order.
+ *
+ * The buffer kernels in lib/bits.c (popcount, byte swapping, the Internet
+ * checksum) run on an AVX2 kernel selected at run time from the CPU's
+ * capabilities, with a portable scalar fallback.
+ */
+
+#ifndef BITS_H
+#define BITS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* `wide_t` is the type the operation runs in: unsigned int or wider, so
+ * the operand is never promoted to signed int. */
+#define BITS_DEFINE(W, uint_t, wide_t)                                          \
+    static inline uint_t bits_shl_u##W(uint_t v, uint32_t n) {                  \
+        return (uint_t)((n < (W)) ? ((wide_t)v << n) : (wide_t)0u);             \
+    }                                                                           \
+    static inline uint_t bits_shr_u##W(uint_t v, uint32_t n) {                  \
+        return (uint_t)((n < (W)) ? ((wide_t)v >> n) : (wide_t)0u);             \
+    }                                                                           \
+    static inline uint_t bits_rotl_u##W(uint_t v, uint32_t n) {                 \
+        uint32_t s = n & ((W) - 1u);                                            \
+        return (uint_t)(((wide_t)v << s) | ((wide_t)v >> (((W) - s) & ((W) - 1u)))); \
+    }                                                                           \
+    static inline uint_t bits_rotr_u##W(uint_t v, uint32_t n) {                 \
+        uint32_t s = n & ((W) - 1u);                                            \
+        return (uint_t)(((wide_t)v >> s) | ((wide_t)v << (((W) - s) & ((W) - 1u)))); \
+    }                                                                           \
+    static inline uint8_t bits_byte_u##W(uint_t v, uint32_t i) {                \
+        return (uint8_t)((i < ((W) / 8u)) ? (((wide_t)v >> (i * 8u)) & 0xFFu) : 0u); \
+    }                                                                           \
+    static inline uint_t bits_mask_u##W(uint32_t width) {                       \
+        return (uint_t)((width >= (W)) ? ~(wide_t)0u                            \
+                                       : (((wide_t)1u << width) - 1u));         \
+    }                                                                           \
+    static inline uint_t bits_get_u##W(uint_t v, uint32_t lsb, uint32_t width) { \
+        return (uint_t)((wide_t)bits_shr_u##W(v, lsb) & (wide_t)bits_mask_u##W(width)); \
+    }                                                                           \
+    static inline uint_t bits_set_u##W(uint_t v, uint32_t lsb, uint32_t width,  \
+                                       uint_t field) {                          \
+        uint_t mask = bits_shl_u##W(bits_mask_u##W(width), lsb);                \
+        return (uint_t)(((wide_t)v & ~(wide_t)mask) |                          \
+                        ((wide_t)bits_shl_u##W(field, lsb) & (wide_t)mask));  \
+    }
+
+BITS_DEFINE(8, uint8_t, uint32_t)
+BITS_DEFINE(16, uint16_t, uint32_t)
+BITS_DEFINE(32, uint32_t, uint32_t)
+BITS_DEFINE(64, uint64_t, uint64_t)
+
+static inline uint32_t bits_popcount_u64(uint64_t v) {
+    return (uint32_t)__builtin_popcountll(v);
+}
+static inline uint32_t bits_popcount_u32(uint32_t v) {
+    return (uint32_t)__builtin_popcount(v);
+}
+static inline uint32_t bits_popcount_u16(uint16_t v) {
+    return bits_popcount_u32((uint32_t)v);
+}
+static inline uint32_t bits_popcount_u8(uint8_t v) {
+    return bits_popcount_u32((uint32_t)v);
+}
+
+static inline uint16_t bits_load_be16(const uint8_t *p) {
+    return (uint16_t)(((uint32_t)p[0] << 8u) | (uint32_t)p[1]);
+}
+static inline uint32_t bits_load_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24u) | ((uint32_t)p[1] << 16u) | ((uint32_t)p[2] << 8u) |
+           (uint32_t)p[3];
+}
+static inline uint64_t bits_load_be64(const uint8_t *p) {
+    return ((uint64_t)bits_load_be32(p) << 32u) | (uint64_t)bits_load_be32(p + 4);
+}
+
+static inline void bits_store_be16(uint8_t *p, uint16_t v) {
+    p[0] = bits_byte_u16(v, 1u);
+    p[1] = bits_byte_u16(v, 0u);
+}
+static inline void bits_store_be32(uint8_t *p, uint32_t v) {
+    p[0] = bits_byte_u32(v, 3u);
+    p[1] = bits_byte_u32(v, 2u);
+    p[2] = bits_byte_u32(v, 1u);
+    p[3] = bits_byte_u32(v, 0u);
+}
+static inline void bits_store_be64(uint8_t *p, uint64_t v) {
+    bits_store_be32(p, (uint32_t)(v >> 32u));
+    bits_store_be32(p + 4, (uint32_t)v);
+}
+
+typedef enum bits_impl {
+    BITS_IMPL_AUTO = 0, /* Best kernel the CPU supports */
+    BITS_IMPL_SCALAR,
+    BITS_IMPL_AVX2
+} bits_impl_t;
+
+/** Set bits in buf[0..n). */
+uint64_t bits_popcount_buf(const uint8_t *buf, size_t n);
+
+/** Reverse the bytes of each element in place (host <-> network order). */
+void bits_bswap16_buf(uint16_t *v, size_t n);
+void bits_bswap32_buf(uint32_t *v, size_t n);
+
+/**
+ * RFC 1071 Internet checksum of buf[0..n): the ones' complement of the
+ * ones' complement sum of big-endian 16-bit words, an odd trailing byte
+ * padded with zero. Store the result with bits_store_be16().
+ */
+uint16_t bits_inet_checksum(const uint8_t *buf, size_t n);
+
+/** Force a kernel (for benchmarking); false if the CPU lacks it. */
+bool bits_select_impl(bits_impl_t impl);
+
+/** Name of the kernel currently in use: "scalar" or "avx2". */
+const char *bits_impl_name(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BITS_H */
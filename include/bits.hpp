@@ -0,0 +1,163 @@
+/**
+ * @file bits.hpp
+ * @brief C++14 promotion-free bit operations on std::uint8_t ..
+ * std::uint64_t, and span wrappers over the bits.h buffer kernels.
+ *
+ * Compliant alternative for AUTOSAR A3-9-1 and MISRA C++ 5-0-10 /
+ * 5-0-21: the operations only accept the fixed-width unsigned types, run
+ * in an unsigned type at least as wide as int, and return the operand's
+ * own type, so `cs::bits::shl(std::uint8_t{0x41}, 2u)` is a uint8_t and
+ * never a signed int. Counts and field positions follow bits.h: shifts
+ * past the width give 0 and rotates reduce the count modulo the width.
+ * Where the position is a compile-time constant (byte<I>, field<T, Lsb,
+ * Width>) an out-of-range value is a compile error instead.
+ *
+ *   using version = cs::bits::field<std::uint8_t, 4, 4>;
+ *   std::uint8_t ihl = cs::bits::field<std::uint8_t, 0, 4>::get(hdr[0]);
+ *   hdr[0] = version::set(hdr[0], 4u);
+ */
+
+#ifndef BITS_HPP
+#define BITS_HPP
+
+#include "bits.h"
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace cs {
+namespace bits {
+
+namespace detail {
+
+template <typename T>
+using is_fixed_unsigned = std::integral_constant<
+    bool, std::is_same<T, std::uint8_t>::value || std::is_same<T, std::uint16_t>::value ||
+              std::is_same<T, std::uint32_t>::value || std::is_same<T, std::uint64_t>::value>;
+
+/** The type an operation on T runs in: T itself unless T would promote to int. */
+template <typename T>
+using wide_t = typename std::conditional<(sizeof(T) < sizeof(unsigned int)), unsigned int,
+                                         T>::type;
+
+template <typename T>
+using enable_t = typename std::enable_if<is_fixed_unsigned<T>::value, T>::type;
+
+}  // namespace detail
+
+/** Number of value bits in T. */
+template <typename T>
+constexpr std::uint32_t width() noexcept {
+    return static_cast<std::uint32_t>(std::numeric_limits<T>::digits);
+}
+
+template <typename T>
+constexpr detail::enable_t<T> shl(T v, std::uint32_t n) noexcept {
+    return static_cast<T>((n < width<T>()) ? (static_cast<detail::wide_t<T>>(v) << n)
+                                           : detail::wide_t<T>{0u});
+}
+
+template <typename T>
+constexpr detail::enable_t<T> shr(T v, std::uint32_t n) noexcept {
+    return static_cast<T>((n < width<T>()) ? (static_cast<detail::wide_t<T>>(v) >> n)
+                                           : detail::wide_t<T>{0u});
+}
+
+template <typename T>
+constexpr detail::enable_t<T> rotl(T v, std::uint32_t n) noexcept {
+    return static_cast<T>(shl(v, n & (width<T>() - 1u)) |
+                          shr(v, (width<T>() - (n & (width<T>() - 1u))) & (width<T>() - 1u)));
+}
+
+template <typename T>
+constexpr detail::enable_t<T> rotr(T v, std::uint32_t n) noexcept {
+    return static_cast<T>(shr(v, n & (width<T>() - 1u)) |
+                          shl(v, (width<T>() - (n & (width<T>() - 1u))) & (width<T>() - 1u)));
+}
+
+template <typename T>
+constexpr typename std::enable_if<detail::is_fixed_unsigned<T>::value, std::uint32_t>::type
+popcount(T v) noexcept {
+    return (sizeof(T) <= sizeof(unsigned int))
+               ? static_cast<std::uint32_t>(__builtin_popcount(static_cast<unsigned int>(v)))
+               : static_cast<std::uint32_t>(
+                     __builtin_popcountll(static_cast<unsigned long long>(v)));
+}
+
+/** Byte I of v, 0 being the least significant. */
+template <std::uint32_t I, typename T>
+constexpr std::uint8_t byte(T v) noexcept {
+    static_assert(detail::is_fixed_unsigned<T>::value, "byte takes a fixed-width unsigned");
+    static_assert(I < sizeof(T), "byte index past the end of the value");
+    return static_cast<std::uint8_t>(shr(v, I * 8u) & T{0xFFu});
+}
+
+/** The low `bits` bits set; all of them when bits >= the width. */
+template <typename T>
+constexpr detail::enable_t<T> mask(std::uint32_t bits) noexcept {
+    return (bits >= width<T>()) ? std::numeric_limits<T>::max()
+                                : static_cast<T>(shl(T{1u}, bits) - 1u);
+}
+
+/** A Width-bit field starting at bit Lsb of a T, checked at compile time. */
+template <typename T, std::uint32_t Lsb, std::uint32_t Width>
+struct field {
+    static_assert(detail::is_fixed_unsigned<T>::value, "field lives in a fixed-width unsigned");
+    static_assert((Width > 0u) && (Width <= width<T>()) && (Lsb <= (width<T>() - Width)),
+                  "field does not fit in its type");
+
+    static constexpr T kMask = static_cast<T>(shl(mask<T>(Width), Lsb));
+
+    static constexpr T get(T v) noexcept { return static_cast<T>(shr(v, Lsb) & mask<T>(Width)); }
+
+    /** v with the field replaced by the low Width bits of x. */
+    static constexpr T set(T v, T x) noexcept {
+        return static_cast<T>((v & static_cast<T>(~static_cast<detail::wide_t<T>>(kMask))) |
+                              (shl(x, Lsb) & kMask));
+    }
+};
+
+template <typename T, std::uint32_t Lsb, std::uint32_t Width>
+constexpr T field<T, Lsb, Width>::kMask;
+
+/** Read a big-endian (network order) T from p[0..sizeof(T)). */
+template <typename T>
+detail::enable_t<T> load_be(const std::uint8_t *p) noexcept {
+    detail::wide_t<T> v = 0u;
+    for (std::size_t i = 0u; i < sizeof(T); ++i) {
+        v = static_cast<detail::wide_t<T>>((v << 8u) | p[i]);
+    }
+    return static_cast<T>(v);
+}
+
+/** Write v big-endian to p[0..sizeof(T)). */
+template <typename T>
+void store_be(std::uint8_t *p, T v) noexcept {
+    static_assert(detail::is_fixed_unsigned<T>::value, "store_be takes a fixed-width unsigned");
+    for (std::size_t i = 0u; i < sizeof(T); ++i) {
+        p[i] = static_cast<std::uint8_t>(shr(v, static_cast<std::uint32_t>(
+                                                    (sizeof(T) - 1u - i) * 8u)));
+    }
+}
+
+/* ---- Buffer kernels (lib/bits.c) --------------------------------------- */
+
+inline std::uint64_t popcount(span<const std::uint8_t> buf) noexcept {
+    return bits_popcount_buf(buf.data(), buf.size());
+}
+
+inline void bswap(span<std::uint16_t> v) noexcept { bits_bswap16_buf(v.data(), v.size()); }
+inline void bswap(span<std::uint32_t> v) noexcept { bits_bswap32_buf(v.data(), v.size()); }
+
+/** RFC 1071 checksum of buf; store it with store_be. */
+inline std::uint16_t inet_checksum(span<const std::uint8_t> buf) noexcept {
+    return bits_inet_checksum(buf.data(), buf.size());
+}
+
+}  // namespace bits
+}  // namespace cs
+
+#endif  // BITS_HPP
@@ -0,0 +1,85 @@
+/**
+ * @file bounds.h
+ * @brief Bounds-checked indexing of fixed-size arrays (C11).
+ *
+ * Compliant alternative for CERT C ARR30-C. BOUNDS_COUNT() takes the
+ * element count from the array's type, and bounds_index() applies the
+ * build's bounds policy to an index:
+ *
+ *   BOUNDS_POLICY_TRAP       out-of-range indices trap (default)
+ *   BOUNDS_POLICY_CLAMP      out-of-range indices read the last element
+ *   BOUNDS_POLICY_UNCHECKED  no check, identical code to plain indexing
+ *
+ * Select one with -DBOUNDS_POLICY=<policy>. bounds.hpp uses the same
+ * setting for its default policy.
+ */
+
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOUNDS_POLICY_UNCHECKED 0
+#define BOUNDS_POLICY_TRAP 1
+#define BOUNDS_POLICY_CLAMP 2
+
+#ifndef BOUNDS_POLICY
+#define BOUNDS_POLICY BOUNDS_POLICY_TRAP
+#endif
+
+/** Element count of an array object (not a pointer). */
+#define BOUNDS_COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+/* A single trapping instruction keeps the check off the hot path's footprint */
+#if defined(__GNUC__)
+#define BOUNDS_TRAP() __builtin_trap()
+#else
+#define BOUNDS_TRAP() abort()
+#endif
+
+static inline bool bounds_ok(size_t index, size_t count) {
+    return index < count;
+}
+
+/** `index`, or the process traps if it is not below `count`. */
+static inline size_t bounds_trap(size_t index, size_t count) {
+    if (index >= count) {
+        BOUNDS_TRAP();
+    }
+    return index;
+}
+
+/** `index` limited to the last element; an empty range traps. */
+static inline size_t bounds_clamp(size_t index, size_t count) {
+    if (count == 0u) {
+        BOUNDS_TRAP();
+    }
+    return (index < count) ? index : (count - 1u);
+}
+
+/** Apply BOUNDS_POLICY to `index` for a range of `count` elements. */
+static inline size_t bounds_index(size_t index, size_t count) {
+#if BOUNDS_POLICY == BOUNDS_POLICY_TRAP
+    return bounds_trap(index, count);
+#elif BOUNDS_POLICY == BOUNDS_POLICY_CLAMP
+    return bounds_clamp(index, count);
+#else
+    (void)count;
+    return index;
+#endif
+}
+
+/** Element `index` of `array` under the build's bounds policy. */
+#define BOUNDS_AT(array, index) ((array)[bounds_index((index), BOUNDS_COUNT(array))])
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOUNDS_H */
@@ -0,0 +1,86 @@
+/**
+ * @file bounds.hpp
+ * @brief C++14 bounds policies and a fixed-size array that applies one on
+ * every index, built on bounds.h.
+ *
+ * Compliant alternative for AUTOSAR A18-1-1 (C-style arrays) and CERT C++
+ * CTR50-CPP. The policy is a template parameter:
+ *
+ *   cs::bounds::trap       out-of-range indices trap
+ *   cs::bounds::clamp      out-of-range indices use the last element
+ *   cs::bounds::unchecked  no check; compiles to plain indexing
+ *
+ * cs::bounds::standard follows the build's BOUNDS_POLICY (trap by default),
+ * so a release build can compile the checks out without touching call sites.
+ */
+
+#ifndef BOUNDS_HPP
+#define BOUNDS_HPP
+
+#include "bounds.h"
+
+#include <array>
+#include <cstddef>
+
+namespace cs {
+namespace bounds {
+
+struct trap {
+    static std::size_t index(std::size_t i, std::size_t count) noexcept {
+        return bounds_trap(i, count);
+    }
+};
+
+struct clamp {
+    static std::size_t index(std::size_t i, std::size_t count) noexcept {
+        return bounds_clamp(i, count);
+    }
+};
+
+struct unchecked {
+    static constexpr std::size_t index(std::size_t i, std::size_t) noexcept { return i; }
+};
+
+#if BOUNDS_POLICY == BOUNDS_POLICY_TRAP
+using standard = trap;
+#elif BOUNDS_POLICY == BOUNDS_POLICY_CLAMP
+using standard = clamp;
+#else
+using standard = unchecked;
+#endif
+
+}  // namespace bounds
+
+/**
+ * std::array with a bounds policy on operator[]. It is an aggregate, so it
+ * is initialised like std::array: `checked_array<int, 3> a = {1, 2, 3};`.
+ */
+template <typename T, std::size_t N, typename Policy = bounds::standard>
+struct checked_array {
+    static_assert(N > 0u, "checked_array needs at least one element");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = typename std::array<T, N>::iterator;
+    using const_iterator = typename std::array<T, N>::const_iterator;
+
+    T &operator[](size_type i) noexcept { return elems[Policy::index(i, N)]; }
+    const T &operator[](size_type i) const noexcept { return elems[Policy::index(i, N)]; }
+
+    T *data() noexcept { return elems.data(); }
+    const T *data() const noexcept { return elems.data(); }
+    static constexpr size_type size() noexcept { return N; }
+
+    iterator begin() noexcept { return elems.begin(); }
+    iterator end() noexcept { return elems.end(); }
+    const_iterator begin() const noexcept { return elems.begin(); }
+    const_iterator end() const noexcept { return elems.end(); }
+
+    void fill(const T &value) { elems.fill(value); }
+
+    std::array<T, N> elems;  // Public for aggregate initialisation
+};
+
+}  // namespace cs
+
+#endif  // BOUNDS_HPP
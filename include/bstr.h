@@ -0,0 +1,66 @@
+/**
+ * @file bstr.h
+ * @brief Bounded string routines with explicit truncation reporting (C11).
+ *
+ * Compliant alternative for CERT C STR31-C, MISRA C++ 18-0-1 (strcpy) and
+ * MISRA C 2012 Rule 17.7 (discarded strlen). Every routine takes the size
+ * of the destination, never writes past it, always NUL-terminates a
+ * non-empty destination and returns a status the caller has to look at.
+ *
+ * The length scan runs on an SSE2 or AVX2 kernel selected at run time from
+ * the CPU's capabilities, with a portable scalar fallback.
+ */
+
+#ifndef BSTR_H
+#define BSTR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum bstr_status {
+    BSTR_OK = 0,        /* Whole source fitted */
+    BSTR_TRUNCATED = 1, /* Destination holds a NUL-terminated prefix */
+    BSTR_INVALID = 2    /* NULL pointer, zero-sized or unterminated destination */
+} bstr_status_t;
+
+typedef enum bstr_impl {
+    BSTR_IMPL_AUTO = 0, /* Best kernel the CPU supports */
+    BSTR_IMPL_SCALAR,
+    BSTR_IMPL_SSE2,
+    BSTR_IMPL_AVX2
+} bstr_impl_t;
+
+/**
+ * Length of `s`, examining at most `max` bytes: returns `max` if there is
+ * no NUL among them. `s` must be NUL-terminated or have `max` readable bytes.
+ */
+size_t bstr_nlen(const char *s, size_t max);
+
+/**
+ * Copy `src` into `dst` (capacity `dst_size` bytes including the NUL).
+ * On BSTR_OK and BSTR_TRUNCATED `*out_len` (if non-NULL) receives the
+ * length of the string now in `dst`.
+ */
+bstr_status_t bstr_copy(char *dst, size_t dst_size, const char *src, size_t *out_len);
+
+/**
+ * Append `src` to the NUL-terminated string in `dst`. A `dst` without a
+ * NUL inside `dst_size` bytes is BSTR_INVALID and is left untouched.
+ */
+bstr_status_t bstr_cat(char *dst, size_t dst_size, const char *src, size_t *out_len);
+
+/** Force a kernel (for benchmarking); false if the CPU lacks it. */
+bool bstr_select_impl(bstr_impl_t impl);
+
+/** Name of the kernel currently in use: "scalar", "sse2" or "avx2". */
+const char *bstr_impl_name(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BSTR_H */
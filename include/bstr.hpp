@@ -0,0 +1,36 @@
+/**
+ * @file bstr.hpp
+ * @brief C++14 overloads of the bounded string routines that take the
+ * destination capacity from the array type, so it cannot be misstated.
+ */
+
+#ifndef BSTR_HPP
+#define BSTR_HPP
+
+#include "bstr.h"
+
+#include <array>
+#include <cstddef>
+
+namespace cs {
+
+template <std::size_t N>
+bstr_status_t bounded_copy(std::array<char, N> &dst, const char *src,
+                           std::size_t *out_len = nullptr) noexcept {
+    return bstr_copy(dst.data(), N, src, out_len);
+}
+
+template <std::size_t N>
+bstr_status_t bounded_cat(std::array<char, N> &dst, const char *src,
+                          std::size_t *out_len = nullptr) noexcept {
+    return bstr_cat(dst.data(), N, src, out_len);
+}
+
+template <std::size_t N>
+std::size_t bounded_length(const std::array<char, N> &s) noexcept {
+    return bstr_nlen(s.data(), N);
+}
+
+}  // namespace cs
+
+#endif  // BSTR_HPP
@@ -0,0 +1,139 @@
+/**
+ * @file dispatch.hpp
+ * @brief C++14 compile-time dispatch tables: a declared mapping from a
+ * range of integer keys to values or handlers, with a mandatory default
+ * and a single exit.
+ *
+ * Compliant alternative for AUTOSAR M6-4-1 / MISRA C++ 6-4-2 (if-else-if
+ * without a final else) and MISRA C++ 6-6-5 (several returns) where a
+ * function branches many ways on one integer. The mapping is declared once,
+ * as data:
+ *
+ *   constexpr auto kCode = cs::make_dispatch_table<1, 4>(
+ *       std::int32_t{0},                       // Default: every other key
+ *       cs::on(1, std::int32_t{10}), cs::on(2, std::int32_t{20}),
+ *       cs::on(4, std::int32_t{40}));
+ *   const std::int32_t code = kCode[key];
+ *
+ *   constexpr auto kHandlers = cs::make_dispatch_table<1, 2>(
+ *       &handle_other, cs::on(1, &handle_one), cs::on(2, &handle_two));
+ *   kHandlers(key, payload);                  // One indirect call
+ *
+ * The default is the first argument and cannot be left out, so every key
+ * has a result, which is the role of the final else. A lookup is one
+ * range compare whose result masks the index (slot 0 holds the default)
+ * and one load, with no branch, so its cost does not depend on the key
+ * distribution. With function pointers as values the table is a jump
+ * table whose only branch is the indirect call.
+ *
+ * Keys are std::int32_t in [First, Last], a span of at most
+ * kMaxDispatchSpan. Keys between the declared ones map to the default.
+ * A declared key outside the range, or declared twice, does not compile
+ * when the table is a constexpr variable; in a table built at run time the
+ * later declaration of a key is ignored.
+ */
+
+#ifndef DISPATCH_HPP
+#define DISPATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+
+constexpr std::size_t kMaxDispatchSpan = 4096u;
+
+/** One declared key and its value or handler. */
+template <typename T>
+struct dispatch_case {
+    std::int32_t key;
+    T value;
+};
+
+template <typename T>
+constexpr dispatch_case<T> on(std::int32_t key, T value) noexcept {
+    return dispatch_case<T>{key, value};
+}
+
+namespace detail {
+
+/* Not constexpr: reaching it while a constexpr table is built stops compilation. */
+inline void dispatch_key_not_allowed() noexcept {}
+
+}  // namespace detail
+
+template <typename T, std::int32_t First, std::int32_t Last>
+class dispatch_table {
+public:
+    static_assert(First <= Last, "the key range is empty");
+    static_assert((static_cast<std::int64_t>(Last) - First) <
+                      static_cast<std::int64_t>(kMaxDispatchSpan),
+                  "the key range is too sparse for a table");
+    static_assert(std::is_trivially_copyable<T>::value, "values are returned by copy");
+
+    static constexpr std::size_t span =
+        static_cast<std::size_t>(static_cast<std::int64_t>(Last) - First + 1);
+
+    template <typename... Cases>
+    constexpr explicit dispatch_table(T default_value, Cases... cases) noexcept : slots_{} {
+        static_assert(sizeof...(Cases) > 0u, "a table needs at least one case");
+        const dispatch_case<T> declared[] = {cases...};
+        bool taken[span + 1u] = {};
+        for (std::size_t i = 0u; i <= span; ++i) {
+            slots_[i] = default_value;
+        }
+        for (const dispatch_case<T> &c : declared) {
+            const std::size_t slot = slot_of(c.key);
+            if ((slot == 0u) || taken[slot]) {
+                detail::dispatch_key_not_allowed();
+            } else {
+                taken[slot] = true;
+                slots_[slot] = c.value;
+            }
+        }
+    }
+
+    /** The value declared for `key`, or the default. */
+    constexpr T operator[](std::int32_t key) const noexcept { return slots_[slot_of(key)]; }
+
+    /** Call the handler declared for `key`, or the default handler. */
+    template <typename... Args, typename U = T>
+    auto operator()(std::int32_t key, Args &&... args) const
+        -> decltype((*std::declval<U>())(std::forward<Args>(args)...)) {
+        return (*slots_[slot_of(key)])(std::forward<Args>(args)...);
+    }
+
+    constexpr const T &default_value() const noexcept { return slots_[0]; }
+
+private:
+    /* 1 + offset from First, or 0 (the default) outside the range. Keys
+     * below First wrap to large unsigned offsets, so one compare covers both
+     * ends, and its result masks the index rather than choosing a branch. */
+    static constexpr std::size_t slot_of(std::int32_t key) noexcept {
+        const std::uint32_t offset =
+            static_cast<std::uint32_t>(key) - static_cast<std::uint32_t>(First);
+        const std::uint32_t in_range = static_cast<std::uint32_t>(offset < span);
+        return static_cast<std::size_t>((offset + 1u) & (0u - in_range));
+    }
+
+    T slots_[span + 1u];
+};
+
+template <typename T, std::int32_t First, std::int32_t Last>
+constexpr std::size_t dispatch_table<T, First, Last>::span;
+
+/**
+ * Build a table over keys [First, Last]. The default comes first and is
+ * required; each case is a cs::on(key, value) with the default's type.
+ */
+template <std::int32_t First, std::int32_t Last, typename T, typename... Cases>
+constexpr dispatch_table<T, First, Last> make_dispatch_table(T default_value,
+                                                             Cases... cases) noexcept {
+    return dispatch_table<T, First, Last>(default_value, cases...);
+}
+
+}  // namespace cs
+
+#endif  // DISPATCH_HPP
@@ -0,0 +1,355 @@
+/**
+ * @file expected.hpp
+ * @brief C++14 result type holding either a value or an error, in the
+ * style of C++23 std::expected.
+ *
+ * Compliant alternative for AUTOSAR A15-1-2, CERT C++ ERR61-CPP and MISRA
+ * C++ 15-3-5 on paths where unwinding is not acceptable: failures travel
+ * back as ordinary return values, nothing is thrown or heap-allocated, and
+ * the header works unchanged under -fno-exceptions. Steps chain with
+ * and_then / transform / or_else / transform_error, and an error skips the
+ * remaining value steps.
+ *
+ * Reading value() of an error (or error() of a value) is a programming
+ * error and traps, whatever BOUNDS_POLICY says.
+ */
+
+#ifndef EXPECTED_HPP
+#define EXPECTED_HPP
+
+#include "bounds.h"
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+
+/** An error on its way into an expected: `return cs::make_unexpected(e);`. */
+template <typename E>
+class unexpected {
+public:
+    constexpr explicit unexpected(const E &error) : error_(error) {}
+    constexpr explicit unexpected(E &&error) : error_(std::move(error)) {}
+
+    constexpr const E &error() const & noexcept { return error_; }
+    E &error() & noexcept { return error_; }
+    E &&error() && noexcept { return std::move(error_); }
+
+private:
+    E error_;
+};
+
+template <typename E>
+constexpr unexpected<typename std::decay<E>::type> make_unexpected(E &&error) {
+    return unexpected<typename std::decay<E>::type>(std::forward<E>(error));
+}
+
+template <typename T, typename E>
+class expected;
+
+namespace detail {
+
+struct value_tag {};
+struct error_tag {};
+
+/** Stand-in value for expected<void, E>. */
+struct unit {};
+
+inline void expected_check(bool ok) noexcept {
+    if (!ok) {
+        BOUNDS_TRAP();
+    }
+}
+
+template <typename X>
+struct is_expected : std::false_type {};
+
+template <typename T, typename E>
+struct is_expected<expected<T, E>> : std::true_type {};
+
+/**
+ * Value-or-error union. Trivially copyable T and E keep the whole object
+ * trivially copyable, so small results come back in registers. expected
+ * holds it as a member: as a base class GCC builds the result in memory
+ * and reloads it, a store-forwarding stall on every return.
+ */
+template <typename T, typename E,
+          bool Trivial = std::is_trivially_copyable<T>::value &&
+                         std::is_trivially_copyable<E>::value>
+struct expected_storage {
+    template <typename... Args>
+    constexpr explicit expected_storage(value_tag, Args &&...args)
+        : val(std::forward<Args>(args)...), has(true) {}
+
+    template <typename... Args>
+    constexpr explicit expected_storage(error_tag, Args &&...args)
+        : err(std::forward<Args>(args)...), has(false) {}
+
+    union {
+        T val;
+        E err;
+    };
+    bool has;
+};
+
+template <typename T, typename E>
+struct expected_storage<T, E, false> {
+    static_assert(std::is_nothrow_move_constructible<T>::value &&
+                      std::is_nothrow_move_constructible<E>::value,
+                  "expected needs value and error types that move without throwing");
+
+    template <typename... Args>
+    explicit expected_storage(value_tag, Args &&...args)
+        : val(std::forward<Args>(args)...), has(true) {}
+
+    template <typename... Args>
+    explicit expected_storage(error_tag, Args &&...args)
+        : err(std::forward<Args>(args)...), has(false) {}
+
+    expected_storage(const expected_storage &other) : has(other.has) {
+        if (has) {
+            ::new (static_cast<void *>(&val)) T(other.val);
+        } else {
+            ::new (static_cast<void *>(&err)) E(other.err);
+        }
+    }
+
+    expected_storage(expected_storage &&other) noexcept : has(other.has) { take(other); }
+
+    /** Copy first, then move into place: a throwing copy leaves *this untouched. */
+    expected_storage &operator=(const expected_storage &other) {
+        if (this != &other) {
+            expected_storage copy(other);
+            destroy();
+            has = copy.has;
+            take(copy);
+        }
+        return *this;
+    }
+
+    expected_storage &operator=(expected_storage &&other) noexcept {
+        if (this != &other) {
+            destroy();
+            has = other.has;
+            take(other);
+        }
+        return *this;
+    }
+
+    ~expected_storage() { destroy(); }
+
+    /** Move-construct from `other`, whose `has` already matches ours. */
+    void take(expected_storage &other) noexcept {
+        if (has) {
+            ::new (static_cast<void *>(&val)) T(std::move(other.val));
+        } else {
+            ::new (static_cast<void *>(&err)) E(std::move(other.err));
+        }
+    }
+
+    void destroy() noexcept {
+        if (has) {
+            val.~T();
+        } else {
+            err.~E();
+        }
+    }
+
+    union {
+        T val;
+        E err;
+    };
+    bool has;
+};
+
+}  // namespace detail
+
+template <typename T, typename E>
+class expected {
+    template <typename U>
+    using not_self = std::integral_constant<
+        bool, !std::is_same<typename std::decay<U>::type, expected>::value &&
+                  !std::is_same<typename std::decay<U>::type, unexpected<E>>::value>;
+
+public:
+    using value_type = T;
+    using error_type = E;
+
+    constexpr expected() : s_(detail::value_tag{}) {}
+
+    template <typename U = T,
+              typename = typename std::enable_if<not_self<U>::value &&
+                                                 std::is_constructible<T, U &&>::value>::type>
+    constexpr expected(U &&value) : s_(detail::value_tag{}, std::forward<U>(value)) {}
+
+    template <typename G>
+    constexpr expected(const unexpected<G> &e) : s_(detail::error_tag{}, e.error()) {}
+
+    template <typename G>
+    constexpr expected(unexpected<G> &&e) : s_(detail::error_tag{}, std::move(e).error()) {}
+
+    constexpr bool has_value() const noexcept { return s_.has; }
+    constexpr explicit operator bool() const noexcept { return s_.has; }
+
+    T &value() & {
+        detail::expected_check(s_.has);
+        return s_.val;
+    }
+    const T &value() const & {
+        detail::expected_check(s_.has);
+        return s_.val;
+    }
+    T &&value() && {
+        detail::expected_check(s_.has);
+        return std::move(s_.val);
+    }
+
+    E &error() & {
+        detail::expected_check(!s_.has);
+        return s_.err;
+    }
+    const E &error() const & {
+        detail::expected_check(!s_.has);
+        return s_.err;
+    }
+    E &&error() && {
+        detail::expected_check(!s_.has);
+        return std::move(s_.err);
+    }
+
+    T &operator*() & { return value(); }
+    const T &operator*() const & { return value(); }
+    T *operator->() { return &value(); }
+    const T *operator->() const { return &value(); }
+
+    template <typename U>
+    T value_or(U &&fallback) const & {
+        return s_.has ? s_.val : static_cast<T>(std::forward<U>(fallback));
+    }
+    template <typename U>
+    T value_or(U &&fallback) && {
+        return s_.has ? std::move(s_.val) : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    /** f(value) -> expected<U, E>; an error passes through untouched. */
+    template <typename F>
+    auto and_then(F &&f) const & -> decltype(f(std::declval<const T &>())) {
+        using result = decltype(f(std::declval<const T &>()));
+        static_assert(detail::is_expected<result>::value, "and_then needs f to return an expected");
+        return s_.has ? f(s_.val) : result(make_unexpected(s_.err));
+    }
+    template <typename F>
+    auto and_then(F &&f) && -> decltype(f(std::declval<T &&>())) {
+        using result = decltype(f(std::declval<T &&>()));
+        static_assert(detail::is_expected<result>::value, "and_then needs f to return an expected");
+        return s_.has ? f(std::move(s_.val)) : result(make_unexpected(std::move(s_.err)));
+    }
+
+    /** f(value) -> U (not void), wrapped as expected<U, E>. */
+    template <typename F>
+    auto transform(F &&f) const & -> expected<decltype(f(std::declval<const T &>())), E> {
+        using result = expected<decltype(f(std::declval<const T &>())), E>;
+        return s_.has ? result(f(s_.val)) : result(make_unexpected(s_.err));
+    }
+    template <typename F>
+    auto transform(F &&f) && -> expected<decltype(f(std::declval<T &&>())), E> {
+        using result = expected<decltype(f(std::declval<T &&>())), E>;
+        return s_.has ? result(f(std::move(s_.val)))
+                         : result(make_unexpected(std::move(s_.err)));
+    }
+
+    /** f(error) -> expected<T, G>, e.g. to recover; a value passes through. */
+    template <typename F>
+    auto or_else(F &&f) const & -> decltype(f(std::declval<const E &>())) {
+        using result = decltype(f(std::declval<const E &>()));
+        static_assert(detail::is_expected<result>::value, "or_else needs f to return an expected");
+        return s_.has ? result(s_.val) : f(s_.err);
+    }
+    template <typename F>
+    auto or_else(F &&f) && -> decltype(f(std::declval<E &&>())) {
+        using result = decltype(f(std::declval<E &&>()));
+        static_assert(detail::is_expected<result>::value, "or_else needs f to return an expected");
+        return s_.has ? result(std::move(s_.val)) : f(std::move(s_.err));
+    }
+
+    /** f(error) -> G, giving expected<T, G>. */
+    template <typename F>
+    auto transform_error(F &&f) const & -> expected<T, decltype(f(std::declval<const E &>()))> {
+        using result = expected<T, decltype(f(std::declval<const E &>()))>;
+        return s_.has ? result(s_.val) : result(make_unexpected(f(s_.err)));
+    }
+
+private:
+    detail::expected_storage<T, E> s_;
+};
+
+/**
+ * expected<void, E>: success carries no value. transform() and and_then()
+ * take functions of no arguments; transform()'s must return a value.
+ */
+template <typename E>
+class expected<void, E> {
+public:
+    using value_type = void;
+    using error_type = E;
+
+    constexpr expected() : s_(detail::value_tag{}) {}
+
+    template <typename G>
+    constexpr expected(const unexpected<G> &e) : s_(detail::error_tag{}, e.error()) {}
+
+    template <typename G>
+    constexpr expected(unexpected<G> &&e) : s_(detail::error_tag{}, std::move(e).error()) {}
+
+    constexpr bool has_value() const noexcept { return s_.has; }
+    constexpr explicit operator bool() const noexcept { return s_.has; }
+
+    void value() const { detail::expected_check(s_.has); }
+
+    E &error() & {
+        detail::expected_check(!s_.has);
+        return s_.err;
+    }
+    const E &error() const & {
+        detail::expected_check(!s_.has);
+        return s_.err;
+    }
+    E &&error() && {
+        detail::expected_check(!s_.has);
+        return std::move(s_.err);
+    }
+
+    template <typename F>
+    auto and_then(F &&f) const -> decltype(f()) {
+        using result = decltype(f());
+        static_assert(detail::is_expected<result>::value, "and_then needs f to return an expected");
+        return s_.has ? f() : result(make_unexpected(s_.err));
+    }
+
+    template <typename F>
+    auto transform(F &&f) const -> expected<decltype(f()), E> {
+        using result = expected<decltype(f()), E>;
+        return s_.has ? result(f()) : result(make_unexpected(s_.err));
+    }
+
+    template <typename F>
+    auto or_else(F &&f) const -> decltype(f(std::declval<const E &>())) {
+        using result = decltype(f(std::declval<const E &>()));
+        static_assert(detail::is_expected<result>::value, "or_else needs f to return an expected");
+        return s_.has ? result() : f(s_.err);
+    }
+
+    template <typename F>
+    auto transform_error(F &&f) const -> expected<void, decltype(f(std::declval<const E &>()))> {
+        using result = expected<void, decltype(f(std::declval<const E &>()))>;
+        return s_.has ? result() : result(make_unexpected(f(s_.err)));
+    }
+
+private:
+    detail::expected_storage<detail::unit, E> s_;
+};
+
+}  // namespace cs
+
+#endif  // EXPECTED_HPP
@@ -0,0 +1,90 @@
+/**
+ * @file file_reader.h
+ * @brief Read-only file access by mmap or large-buffer streaming (C11 API).
+ *
+ * Compliant alternative for CERT C ERR33-C. Opening, mapping, reading and
+ * closing each report failure as an errno value that the caller has to
+ * look at; a reader that failed to open holds nothing and is safe to close.
+ *
+ * Two modes serve the same block and line interface:
+ *
+ *   FILE_READER_MAP     the whole file is mapped read-only with
+ *                       MADV_SEQUENTIAL; blocks and lines point straight
+ *                       into the mapping, so nothing is copied
+ *   FILE_READER_STREAM  read(2) into one page-aligned buffer of
+ *                       `buffer_size` bytes, with POSIX_FADV_SEQUENTIAL
+ *
+ * FILE_READER_AUTO maps non-empty regular files and streams everything
+ * else (pipes, terminals, /proc files that report size 0) or when mmap
+ * fails. FILE_READER_MAP refuses non-regular files with ENODEV and reads
+ * a zero-size file as empty. A mapping is a snapshot of the size at open;
+ * shrinking the file underneath it raises SIGBUS on access, so use
+ * FILE_READER_STREAM for files that other processes may truncate.
+ */
+
+#ifndef FILE_READER_H
+#define FILE_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FILE_READER_DEFAULT_BUFFER ((size_t)1u << 20)
+
+typedef enum file_reader_mode {
+    FILE_READER_AUTO = 0,
+    FILE_READER_MAP,
+    FILE_READER_STREAM
+} file_reader_mode_t;
+
+typedef struct file_reader {
+    int fd;                   /* -1 when closed */
+    bool mapped;              /* true: data is the mapping; false: the stream buffer */
+    bool eof;                 /* Stream mode: read(2) has returned 0 */
+    unsigned char *data;      /* Mapping or stream buffer */
+    size_t capacity;          /* Mapping length or buffer size */
+    size_t pos;               /* Next undelivered byte in data */
+    size_t end;               /* End of valid bytes in data */
+    uint64_t size;            /* File size at open; 0 if not a regular file */
+} file_reader_t;
+
+/**
+ * Open `path` for reading. `buffer_size` (0 means FILE_READER_DEFAULT_BUFFER,
+ * rounded up to the page size) only matters when streaming. Returns 0, or
+ * the errno from open, fstat, mmap (FILE_READER_MAP only) or the buffer
+ * allocation; on error `r` is left closed.
+ */
+int file_reader_open(file_reader_t *r, const char *path, file_reader_mode_t mode,
+                     size_t buffer_size);
+
+/**
+ * Next block of the file: the rest of the mapping in one piece, or the
+ * next buffer's worth when streaming. `*data` stays valid until the next
+ * call. At end of file returns 0 with `*len` == 0; otherwise the errno
+ * from read.
+ */
+int file_reader_next(file_reader_t *r, const unsigned char **data, size_t *len);
+
+/**
+ * Next line, without its '\n'; the last line need not end in one. At end
+ * of file returns 0 with `*line` == NULL. When streaming, a line longer
+ * than the buffer returns ENOBUFS and is not consumed.
+ */
+int file_reader_next_line(file_reader_t *r, const char **line, size_t *len);
+
+/** Unmap or free, and close the descriptor; returns 0 or the errno from close. */
+int file_reader_close(file_reader_t *r);
+
+static inline bool file_reader_is_mapped(const file_reader_t *r) {
+    return r->mapped;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FILE_READER_H */
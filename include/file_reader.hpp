@@ -0,0 +1,135 @@
+/**
+ * @file file_reader.hpp
+ * @brief C++14 owning wrapper over the file reader in file_reader.h.
+ *
+ * cs::file_reader::open() returns the reader or the errno as a
+ * cs::expected, so there is no handle to use before the open has been
+ * checked. The destructor unmaps and closes; call close() instead where
+ * the result of close(2) matters.
+ *
+ *   auto f = cs::file_reader::open("input.txt");
+ *   cs::string_view line;
+ *   while (f && f.value().next_line(line).value_or(false)) { ... }
+ */
+
+#ifndef FILE_READER_HPP
+#define FILE_READER_HPP
+
+#include "expected.hpp"
+#include "file_reader.h"
+#include "span.hpp"
+#include "string_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+namespace cs {
+
+class file_reader {
+public:
+    enum class mode {
+        automatic = FILE_READER_AUTO,  // Map regular files, stream the rest
+        map = FILE_READER_MAP,
+        stream = FILE_READER_STREAM
+    };
+
+    static expected<file_reader, std::errc> open(const char *path, mode m = mode::automatic,
+                                                 std::size_t buffer_size = 0u) noexcept {
+        expected<file_reader, std::errc> result = make_unexpected(std::errc::invalid_argument);
+        if (path != nullptr) {
+            file_reader f;
+            const int err = file_reader_open(&f.r_, path, static_cast<file_reader_mode_t>(m),
+                                             buffer_size);
+            if (err == 0) {
+                result = std::move(f);
+            } else {
+                result = make_unexpected(static_cast<std::errc>(err));
+            }
+        }
+        return result;
+    }
+
+    file_reader(file_reader &&other) noexcept : r_(other.r_) { other.forget(); }
+
+    file_reader &operator=(file_reader &&other) noexcept {
+        if (this != &other) {
+            static_cast<void>(file_reader_close(&r_));
+            r_ = other.r_;
+            other.forget();
+        }
+        return *this;
+    }
+
+    file_reader(const file_reader &) = delete;
+    file_reader &operator=(const file_reader &) = delete;
+
+    ~file_reader() { static_cast<void>(file_reader_close(&r_)); }
+
+    /** Next block, valid until the next call; empty at end of file. */
+    expected<span<const unsigned char>, std::errc> next() noexcept {
+        expected<span<const unsigned char>, std::errc> result;
+        const unsigned char *data = nullptr;
+        std::size_t len = 0u;
+        const int err = file_reader_next(&r_, &data, &len);
+        if (err == 0) {
+            result = span<const unsigned char>(data, len);
+        } else {
+            result = make_unexpected(static_cast<std::errc>(err));
+        }
+        return result;
+    }
+
+    /**
+     * Set `line` to the next line without its '\n' and return true, or
+     * return false at end of file. std::errc::no_buffer_space when a
+     * streamed line does not fit the buffer.
+     */
+    expected<bool, std::errc> next_line(string_view &line) noexcept {
+        expected<bool, std::errc> result;
+        const char *data = nullptr;
+        std::size_t len = 0u;
+        const int err = file_reader_next_line(&r_, &data, &len);
+        if (err == 0) {
+            line = string_view(data, len);
+            result = (data != nullptr);
+        } else {
+            result = make_unexpected(static_cast<std::errc>(err));
+        }
+        return result;
+    }
+
+    /** The whole file when it is mapped; empty when streaming. */
+    span<const unsigned char> view() const noexcept {
+        return r_.mapped ? span<const unsigned char>(r_.data, r_.capacity)
+                         : span<const unsigned char>();
+    }
+
+    /** Release everything now and report the result of close(2). */
+    expected<void, std::errc> close() noexcept {
+        expected<void, std::errc> result;
+        const int err = file_reader_close(&r_);
+        if (err != 0) {
+            result = make_unexpected(static_cast<std::errc>(err));
+        }
+        return result;
+    }
+
+    bool is_mapped() const noexcept { return file_reader_is_mapped(&r_); }
+    /** File size at open; 0 for pipes and other non-regular files. */
+    std::uint64_t size() const noexcept { return r_.size; }
+
+private:
+    file_reader() noexcept { forget(); }
+
+    void forget() noexcept {
+        r_ = file_reader_t{};
+        r_.fd = -1;
+    }
+
+    file_reader_t r_;
+};
+
+}  // namespace cs
+
+#endif  // FILE_READER_HPP
@@ -0,0 +1,80 @@
+/**
+ * @file fmt.h
+ * @brief Locale-free number formatting and bounded text buffers without
+ * stdio (C11).
+ *
+ * Compliant alternative for MISRA C 2012 Rule 21.6 and the core of the
+ * C++ formatter in fmt.hpp. The converters write digits straight into a
+ * caller buffer, and fmt_buf_t collects a line with snprintf's truncation
+ * rules: no heap, no locale, no errno, safe to call from a signal handler.
+ * fmt_write_all() hands the line to a file descriptor with write(2), so
+ * a failure leaves write's errno set; a signal handler that calls it
+ * should save and restore errno.
+ *
+ * Floats print in fixed notation below 2^64, within one unit in the last
+ * digit of printf("%.*f") (the integer part is exact). Larger magnitudes
+ * switch to d.ddde+XX, approximate in the last digit.
+ */
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Worst-case output lengths, without a NUL */
+#define FMT_U64_MAX 20u
+#define FMT_I64_MAX 20u
+#define FMT_HEX64_MAX 16u
+#define FMT_BIN64_MAX 64u
+#define FMT_F64_MAX 48u
+
+/* Largest precision fmt_f64 honours; more is clamped */
+#define FMT_F64_PREC_MAX 15u
+
+/* Each converter returns the number of characters written (no NUL) */
+size_t fmt_u64(char *out, uint64_t v);
+size_t fmt_i64(char *out, int64_t v);
+size_t fmt_hex64(char *out, uint64_t v, bool upper);
+size_t fmt_bin64(char *out, uint64_t v);
+size_t fmt_f64(char *out, double v, uint32_t precision);
+
+/**
+ * Text buffer with snprintf semantics: stores what fits, always leaves
+ * room for the NUL, and `len` counts everything that was appended.
+ */
+typedef struct fmt_buf {
+    char *data;
+    size_t cap;
+    size_t len;
+} fmt_buf_t;
+
+void fmt_buf_init(fmt_buf_t *b, char *data, size_t cap);
+void fmt_put(fmt_buf_t *b, const char *s, size_t n);
+void fmt_put_str(fmt_buf_t *b, const char *s);
+void fmt_put_char(fmt_buf_t *b, char c);
+void fmt_put_u64(fmt_buf_t *b, uint64_t v);
+void fmt_put_i64(fmt_buf_t *b, int64_t v);
+void fmt_put_f64(fmt_buf_t *b, double v, uint32_t precision);
+
+/** NUL-terminate and return the full length (may exceed what was stored). */
+size_t fmt_buf_finish(fmt_buf_t *b);
+
+/** Characters actually stored, excluding the NUL. */
+size_t fmt_buf_stored(const fmt_buf_t *b);
+
+bool fmt_buf_truncated(const fmt_buf_t *b);
+
+/** write(2) all of `buf`, retrying on EINTR; false, with errno set, on any other error. */
+bool fmt_write_all(int fd, const char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FMT_H */
@@ -0,0 +1,572 @@
+/**
+ * @file fmt.hpp
+ * @brief C++14 type-safe text formatting without <cstdio> or C variadics,
+ * with the format string checked at compile time.
+ *
+ * Compliant alternative for CERT C++ DCL50-CPP and MISRA C++ 27-0-1.
+ * Arguments go through a variadic template, so each one keeps its type;
+ * the format string is wrapped by CS_FMT so the compiler can parse it and
+ * match every placeholder against its argument:
+ *
+ *   char line[128];
+ *   cs::format_to(line, sizeof(line), CS_FMT("{} took {:.3} ms\n"), name, ms);
+ *   cs::print(CS_FMT("{:>8}|{:08x}\n"), count, mask);
+ *
+ * A missing or extra argument, an unbalanced brace or a spec that does not
+ * fit its argument type (`{:x}` on a string) is a static_assert, not a
+ * runtime surprise. Output goes to a caller buffer (snprintf semantics:
+ * truncates, NUL-terminates, returns the full length) or to any Sink with
+ * `void write(const char *, std::size_t)`. Formatting uses no heap, no
+ * locale and no errno; numbers are converted by the C core in fmt.h.
+ * cs::fd_sink and cs::print write with write(2), which sets errno when it
+ * fails.
+ *
+ * Placeholders: `{}` or `{:[<|>][0][width][.precision][x|X|b]}`, with
+ * `{{` and `}}` for literal braces. Width is at most 3 digits. Precision
+ * applies to floats (default 6, at most FMT_F64_PREC_MAX), x/X/b to
+ * integers, and `0` padding to numbers. As in std::format, x/X/b print a
+ * negative signed value as a sign and its magnitude (`{:x}` of -255 is
+ * "-ff"), where printf("%x") prints the two's complement; pass the
+ * unsigned type for that. Numbers and pointers align right
+ * by default, text, bool and char left. A null const char * prints
+ * "(null)".
+ */
+
+#ifndef FMT_HPP
+#define FMT_HPP
+
+#include "fmt.h"
+#include "string_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <unistd.h>
+
+/** Wraps a string literal so its contents are visible to the compiler. */
+#define CS_FMT(s)                                                                              \
+    ([] {                                                                                      \
+        struct cs_fmt_string : ::cs::detail::format_string_tag {                               \
+            static constexpr const char *data() noexcept { return s; }                         \
+            static constexpr std::size_t size() noexcept { return ::cs::detail::literal_size(s); } \
+        };                                                                                     \
+        return cs_fmt_string{};                                                                \
+    }())
+
+namespace cs {
+
+namespace detail {
+
+struct format_string_tag {};
+
+template <std::size_t N>
+constexpr std::size_t literal_size(const char (&)[N]) noexcept {
+    return N - 1u;
+}
+
+template <typename S>
+using if_format_string =
+    typename std::enable_if<std::is_base_of<format_string_tag, S>::value>::type;
+
+enum class arg_kind : std::uint8_t { none, sint, uint, boolean, character, string, floating, pointer };
+
+enum class format_error : std::uint8_t {
+    none,
+    unmatched_open,
+    unmatched_close,
+    bad_spec,
+    too_few_args,
+    too_many_args,
+    spec_type_mismatch
+};
+
+struct spec {
+    char align;  // '<', '>' or 0 for the default of the argument type
+    char fill;   // ' ' or '0'
+    char type;   // 'x', 'X', 'b' or 0 for decimal
+    std::uint32_t width;
+    std::int32_t precision;  // -1: default
+};
+
+struct parse_result {
+    std::size_t next;
+    format_error error;
+};
+
+constexpr bool is_digit(char c) noexcept { return (c >= '0') && (c <= '9'); }
+
+constexpr bool is_hex_digit(char c) noexcept {
+    return is_digit(c) || ((c >= 'a') && (c <= 'f')) || ((c >= 'A') && (c <= 'F'));
+}
+
+/** Parse the placeholder whose '{' is at s[i - 1]; `next` is past its '}'. */
+constexpr parse_result parse_spec(const char *s, std::size_t n, std::size_t i, spec &sp) noexcept {
+    sp = spec{0, ' ', 0, 0u, -1};
+    format_error err = format_error::none;
+    if ((i < n) && (s[i] == ':')) {
+        ++i;
+        if ((i < n) && ((s[i] == '<') || (s[i] == '>'))) {
+            sp.align = s[i];
+            ++i;
+        }
+        if ((i < n) && (s[i] == '0')) {
+            sp.fill = '0';
+            ++i;
+        }
+        std::size_t digits = 0u;
+        while ((i < n) && is_digit(s[i]) && (digits < 3u)) {
+            sp.width = (sp.width * 10u) + static_cast<std::uint32_t>(s[i] - '0');
+            ++digits;
+            ++i;
+        }
+        if ((i < n) && (s[i] == '.')) {
+            ++i;
+            sp.precision = 0;
+            digits = 0u;
+            while ((i < n) && is_digit(s[i]) && (digits < 2u)) {
+                sp.precision = (sp.precision * 10) + static_cast<std::int32_t>(s[i] - '0');
+                ++digits;
+                ++i;
+            }
+            if ((digits == 0u) || (sp.precision > static_cast<std::int32_t>(FMT_F64_PREC_MAX))) {
+                err = format_error::bad_spec;
+            }
+        }
+        if ((i < n) && ((s[i] == 'x') || (s[i] == 'X') || (s[i] == 'b'))) {
+            sp.type = s[i];
+            ++i;
+        }
+        if ((sp.fill == '0') && (sp.align != 0)) {
+            err = format_error::bad_spec;
+        }
+    }
+    if (err == format_error::none) {
+        if (i >= n) {
+            err = format_error::unmatched_open;
+        } else if (s[i] != '}') {
+            err = format_error::bad_spec;
+        } else {
+            ++i;
+        }
+    }
+    return parse_result{i, err};
+}
+
+constexpr bool is_number(arg_kind k) noexcept {
+    return (k == arg_kind::sint) || (k == arg_kind::uint) || (k == arg_kind::floating);
+}
+
+constexpr bool kind_accepts(arg_kind k, const spec &sp) noexcept {
+    return (k != arg_kind::none) &&
+           ((sp.type == 0) || (k == arg_kind::sint) || (k == arg_kind::uint)) &&
+           ((sp.precision < 0) || (k == arg_kind::floating)) && ((sp.fill != '0') || is_number(k));
+}
+
+/** The same walk vformat() does, run by the compiler over the argument kinds. */
+constexpr format_error check(const char *s, std::size_t n, const arg_kind *kinds,
+                             std::size_t count) noexcept {
+    format_error err = format_error::none;
+    std::size_t used = 0u;
+    std::size_t i = 0u;
+    while ((err == format_error::none) && (i < n)) {
+        const bool doubled = ((i + 1u) < n) && (s[i + 1u] == s[i]);
+        if ((s[i] == '{') && !doubled) {
+            spec sp{0, ' ', 0, 0u, -1};
+            const parse_result r = parse_spec(s, n, i + 1u, sp);
+            if (r.error != format_error::none) {
+                err = r.error;
+            } else if (used >= count) {
+                err = format_error::too_few_args;
+            } else if (!kind_accepts(kinds[used], sp)) {
+                err = format_error::spec_type_mismatch;
+            } else {
+                ++used;
+                i = r.next;
+            }
+        } else if ((s[i] == '}') && !doubled) {
+            err = format_error::unmatched_close;
+        } else {
+            i += ((s[i] == '{') || (s[i] == '}')) ? 2u : 1u;
+        }
+    }
+    if ((err == format_error::none) && (used != count)) {
+        err = format_error::too_many_args;
+    }
+    return err;
+}
+
+template <typename T>
+struct kind_of {
+    using type = typename std::decay<T>::type;
+    static constexpr bool is_text =
+        std::is_same<type, char *>::value || std::is_same<type, const char *>::value ||
+        std::is_same<type, std::string>::value || std::is_same<type, string_view>::value;
+    static constexpr bool is_data_pointer =
+        (std::is_pointer<type>::value &&
+         !std::is_function<typename std::remove_pointer<type>::type>::value) ||
+        std::is_same<type, std::nullptr_t>::value;
+
+    static constexpr arg_kind value =
+        std::is_same<type, bool>::value   ? arg_kind::boolean
+        : std::is_same<type, char>::value ? arg_kind::character
+        : std::is_integral<type>::value
+            ? (std::is_signed<type>::value ? arg_kind::sint : arg_kind::uint)
+        : std::is_floating_point<type>::value ? arg_kind::floating
+        : is_text                             ? arg_kind::string
+        : is_data_pointer                     ? arg_kind::pointer
+                                              : arg_kind::none;
+};
+
+/** Argument kinds of a call, terminated by none so the array is never empty. */
+template <typename... Args>
+struct kinds_of {
+    static constexpr arg_kind value[] = {kind_of<Args>::value..., arg_kind::none};
+};
+
+template <typename... Args>
+constexpr arg_kind kinds_of<Args...>::value[];
+
+template <typename... Args>
+constexpr bool all_supported() noexcept {
+    bool ok = true;
+    for (std::size_t i = 0u; i < sizeof...(Args); ++i) {
+        ok = ok && (kinds_of<Args...>::value[i] != arg_kind::none);
+    }
+    return ok;
+}
+
+template <typename S, typename... Args>
+constexpr format_error check_format() noexcept {
+    return check(S::data(), S::size(), kinds_of<Args...>::value, sizeof...(Args));
+}
+
+template <typename S, typename... Args>
+void static_check() noexcept {
+    static_assert(all_supported<Args...>(),
+                  "cs::format: an argument has no conversion (integers, floats, bool, char, "
+                  "strings and data pointers are supported)");
+    constexpr format_error e = check_format<S, Args...>();
+    static_assert(e != format_error::unmatched_open,
+                  "cs::format: '{' without a closing '}' (write '{{' for a literal brace)");
+    static_assert(e != format_error::unmatched_close,
+                  "cs::format: '}' without an opening '{' (write '}}' for a literal brace)");
+    static_assert(e != format_error::bad_spec, "cs::format: malformed placeholder spec");
+    static_assert(e != format_error::too_few_args, "cs::format: more placeholders than arguments");
+    static_assert(e != format_error::too_many_args, "cs::format: more arguments than placeholders");
+    static_assert(e != format_error::spec_type_mismatch,
+                  "cs::format: spec does not apply to the argument's type");
+}
+
+/** One type-erased argument; only the member named by `kind` is set. */
+struct arg {
+    struct text {
+        const char *data;
+        std::size_t size;
+    };
+    arg_kind kind;
+    union {
+        std::int64_t i;
+        std::uint64_t u;
+        double f;
+        text s;
+    } v;
+};
+
+inline arg::text to_text(const char *s) noexcept {
+    return (s != nullptr) ? arg::text{s, std::strlen(s)} : arg::text{"(null)", 6u};
+}
+inline arg::text to_text(const std::string &s) noexcept { return arg::text{s.data(), s.size()}; }
+inline arg::text to_text(string_view s) noexcept { return arg::text{s.data(), s.size()}; }
+
+template <arg_kind K>
+using kind_constant = std::integral_constant<arg_kind, K>;
+
+template <typename T>
+arg make_arg(const T &value, kind_constant<arg_kind::sint>) noexcept {
+    arg a{arg_kind::sint, {}};
+    a.v.i = static_cast<std::int64_t>(value);
+    return a;
+}
+
+template <typename T>
+arg make_arg(const T &value, kind_constant<arg_kind::uint>) noexcept {
+    arg a{arg_kind::uint, {}};
+    a.v.u = static_cast<std::uint64_t>(value);
+    return a;
+}
+
+inline arg make_arg(bool value, kind_constant<arg_kind::boolean>) noexcept {
+    arg a{arg_kind::boolean, {}};
+    a.v.u = value ? 1u : 0u;
+    return a;
+}
+
+inline arg make_arg(char value, kind_constant<arg_kind::character>) noexcept {
+    arg a{arg_kind::character, {}};
+    a.v.u = static_cast<unsigned char>(value);
+    return a;
+}
+
+template <typename T>
+arg make_arg(const T &value, kind_constant<arg_kind::floating>) noexcept {
+    arg a{arg_kind::floating, {}};
+    a.v.f = static_cast<double>(value);
+    return a;
+}
+
+template <typename T>
+arg make_arg(const T &value, kind_constant<arg_kind::string>) noexcept {
+    arg a{arg_kind::string, {}};
+    a.v.s = to_text(value);
+    return a;
+}
+
+template <typename T>
+arg make_arg(const T &value, kind_constant<arg_kind::pointer>) noexcept {
+    arg a{arg_kind::pointer, {}};
+    a.v.u = reinterpret_cast<std::uintptr_t>(value);
+    return a;
+}
+
+inline arg make_arg(std::nullptr_t, kind_constant<arg_kind::pointer>) noexcept {
+    arg a{arg_kind::pointer, {}};
+    a.v.u = 0u;
+    return a;
+}
+
+template <typename T>
+arg make_arg(const T &value) noexcept {
+    return make_arg(value, kind_constant<kind_of<T>::value>{});
+}
+
+constexpr char kPadSpaces[] = "                                ";
+constexpr char kPadZeros[] = "00000000000000000000000000000000";
+
+template <typename Sink>
+void pad(Sink &sink, char fill, std::size_t count) {
+    const char *src = (fill == '0') ? kPadZeros : kPadSpaces;
+    while (count > 0u) {
+        const std::size_t k = (count < (sizeof(kPadSpaces) - 1u)) ? count : (sizeof(kPadSpaces) - 1u);
+        sink.write(src, k);
+        count -= k;
+    }
+}
+
+template <typename Sink>
+void write_padded(Sink &sink, const char *s, std::size_t n, const spec &sp, bool numeric) {
+    const std::size_t padding = (sp.width > n) ? (sp.width - n) : 0u;
+    const std::size_t sign = ((n > 0u) && (s[0] == '-')) ? 1u : 0u;
+    const char align = (sp.align != 0) ? sp.align : (numeric ? '>' : '<');
+    // Zeros go after the sign; nan and inf are padded with spaces
+    if ((sp.fill == '0') && (n > sign) && is_hex_digit(s[sign])) {
+        sink.write(s, sign);
+        pad(sink, '0', padding);
+        sink.write(s + sign, n - sign);
+    } else if (align == '>') {
+        pad(sink, ' ', padding);
+        sink.write(s, n);
+    } else {
+        sink.write(s, n);
+        pad(sink, ' ', padding);
+    }
+}
+
+inline std::size_t put_unsigned(char *out, std::uint64_t v, char type) noexcept {
+    std::size_t n = 0u;
+    if (type == 'x') {
+        n = fmt_hex64(out, v, false);
+    } else if (type == 'X') {
+        n = fmt_hex64(out, v, true);
+    } else if (type == 'b') {
+        n = fmt_bin64(out, v);
+    } else {
+        n = fmt_u64(out, v);
+    }
+    return n;
+}
+
+template <typename Sink>
+void write_arg(Sink &sink, const arg &a, const spec &sp) {
+    char tmp[2u + FMT_BIN64_MAX];
+    static_assert(sizeof(tmp) >= FMT_F64_MAX, "conversion buffer too small for a double");
+    const char *text = tmp;
+    std::size_t n = 0u;
+    bool numeric = true;
+    switch (a.kind) {
+    case arg_kind::sint: {
+        const bool negative = a.v.i < 0;
+        const std::uint64_t magnitude = static_cast<std::uint64_t>(a.v.i);
+        tmp[0] = '-';
+        n = negative ? 1u : 0u;
+        n += put_unsigned(tmp + n, negative ? (0u - magnitude) : magnitude, sp.type);
+        break;
+    }
+    case arg_kind::uint:
+        n = put_unsigned(tmp, a.v.u, sp.type);
+        break;
+    case arg_kind::floating:
+        n = fmt_f64(tmp, a.v.f, (sp.precision < 0) ? 6u : static_cast<std::uint32_t>(sp.precision));
+        break;
+    case arg_kind::pointer:
+        tmp[0] = '0';
+        tmp[1] = 'x';
+        n = 2u + fmt_hex64(tmp + 2, a.v.u, false);
+        break;
+    case arg_kind::boolean:
+        text = (a.v.u != 0u) ? "true" : "false";
+        n = (a.v.u != 0u) ? 4u : 5u;
+        numeric = false;
+        break;
+    case arg_kind::character:
+        tmp[0] = static_cast<char>(a.v.u);
+        n = 1u;
+        numeric = false;
+        break;
+    case arg_kind::string:
+        text = a.v.s.data;
+        n = a.v.s.size;
+        numeric = false;
+        break;
+    default:
+        /* none: rejected at compile time */
+        break;
+    }
+    write_padded(sink, text, n, sp, numeric);
+}
+
+/** Runtime half of the formatter; `s` has already passed check(). */
+template <typename Sink>
+void vformat(Sink &sink, const char *s, std::size_t n, const arg *args) {
+    std::size_t literal = 0u;
+    std::size_t used = 0u;
+    std::size_t i = 0u;
+    while (i < n) {
+        const bool brace = (s[i] == '{') || (s[i] == '}');
+        if (!brace) {
+            ++i;
+        } else {
+            sink.write(s + literal, i - literal);
+            const bool doubled = ((i + 1u) < n) && (s[i + 1u] == s[i]);
+            if ((s[i] == '{') && !doubled) {
+                spec sp{0, ' ', 0, 0u, -1};
+                i = parse_spec(s, n, i + 1u, sp).next;
+                write_arg(sink, args[used], sp);
+                ++used;
+            } else {
+                sink.write(s + i, 1u);
+                i += doubled ? 2u : 1u;
+            }
+            literal = i;
+        }
+    }
+    sink.write(s + literal, n - literal);
+}
+
+}  // namespace detail
+
+/** Caller-owned buffer with snprintf semantics; see fmt_buf_t. */
+class buffer_sink {
+public:
+    buffer_sink(char *data, std::size_t cap) noexcept : data_(data), cap_(cap), len_(0u) {}
+
+    void write(const char *s, std::size_t n) noexcept {
+        const std::size_t stored = this->stored();
+        if ((cap_ > 0u) && (stored < (cap_ - 1u))) {
+            const std::size_t room = (cap_ - 1u) - stored;
+            std::memcpy(data_ + stored, s, (n < room) ? n : room);
+        }
+        len_ += n;
+    }
+
+    /** NUL-terminate and return the full length (may exceed what was stored). */
+    std::size_t finish() noexcept {
+        if (cap_ > 0u) {
+            data_[stored()] = '\0';
+        }
+        return len_;
+    }
+
+    std::size_t size() const noexcept { return len_; }
+    bool truncated() const noexcept { return stored() < len_; }
+
+private:
+    std::size_t stored() const noexcept {
+        return (cap_ == 0u) ? 0u : ((len_ < (cap_ - 1u)) ? len_ : (cap_ - 1u));
+    }
+
+    char *data_;
+    std::size_t cap_;
+    std::size_t len_;
+};
+
+/** Buffers output for a file descriptor; flushed when full and on destruction. */
+class fd_sink {
+public:
+    explicit fd_sink(int fd) noexcept : fd_(fd) {}
+    fd_sink(const fd_sink &) = delete;
+    fd_sink &operator=(const fd_sink &) = delete;
+    ~fd_sink() { static_cast<void>(flush()); }
+
+    void write(const char *s, std::size_t n) noexcept {
+        if (n > (sizeof(buf_) - len_)) {
+            static_cast<void>(flush());
+            if (n >= sizeof(buf_)) {
+                ok_ = fmt_write_all(fd_, s, n) && ok_;
+                n = 0u;
+            }
+        }
+        std::memcpy(buf_ + len_, s, n);
+        len_ += n;
+    }
+
+    /** Write out what is buffered; false once any write has failed. */
+    bool flush() noexcept {
+        if (len_ > 0u) {
+            ok_ = fmt_write_all(fd_, buf_, len_) && ok_;
+            len_ = 0u;
+        }
+        return ok_;
+    }
+
+    bool ok() const noexcept { return ok_; }
+
+private:
+    int fd_;
+    bool ok_ = true;
+    std::size_t len_ = 0u;
+    char buf_[4096];
+};
+
+/** Format into any Sink with `write(const char *, std::size_t)`. */
+template <typename Sink, typename S, typename... Args, typename = detail::if_format_string<S>>
+void format_to(Sink &sink, S, const Args &...args) {
+    detail::static_check<S, Args...>();
+    const detail::arg list[] = {detail::make_arg(args)..., detail::arg{detail::arg_kind::none, {}}};
+    detail::vformat(sink, S::data(), S::size(), list);
+}
+
+/**
+ * Format into buf[0..cap): stores what fits, always NUL-terminates when
+ * cap > 0, and returns the full length like snprintf.
+ */
+template <typename S, typename... Args, typename = detail::if_format_string<S>>
+std::size_t format_to(char *buf, std::size_t cap, S fmt, const Args &...args) {
+    buffer_sink sink(buf, cap);
+    format_to(sink, fmt, args...);
+    return sink.finish();
+}
+
+/** Format to standard output; false if the write failed. */
+template <typename S, typename... Args, typename = detail::if_format_string<S>>
+bool print(S fmt, const Args &...args) {
+    fd_sink sink(STDOUT_FILENO);
+    format_to(sink, fmt, args...);
+    return sink.flush();
+}
+
+}  // namespace cs
+
+#endif  // FMT_HPP
@@ -0,0 +1,62 @@
+/**
+ * @file int_convert.h
+ * @brief Checked and saturating integer conversions for common type pairs
+ * (C11, header-only).
+ *
+ * For each pair <name> (e.g. i32_to_i16) this header defines:
+ *   bool   checked_<name>(from v, to *out)  - store and return true if v fits
+ *   to     sat_<name>(from v)               - clamp v to the range of `to`
+ *   size_t sat_<name>_n(in, out, n)         - clamp an array; returns the
+ *                                             number of clamped elements
+ * The range tests compare against constants only, so they compile to
+ * branch-free code and the array loops vectorise. See int_convert.hpp for
+ * the C++ templates covering every pair.
+ */
+
+#ifndef INT_CONVERT_H
+#define INT_CONVERT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* `below` / `above` are expressions in `v` that are true when v is under
+ * or over the range of `to_t`; use `false` where a side cannot overflow. */
+#define INT_CONVERT_DEFINE(name, from_t, to_t, below, above, lo, hi)        \
+    static inline bool checked_##name(from_t v, to_t *out) {               \
+        bool ok = !(below) && !(above);                                    \
+        if (ok) {                                                          \
+            *out = (to_t)v;                                                \
+        }                                                                  \
+        return ok;                                                         \
+    }                                                                      \
+    static inline to_t sat_##name(from_t v) {                              \
+        return (below) ? (to_t)(lo) : ((above) ? (to_t)(hi) : (to_t)v);    \
+    }                                                                      \
+    static inline size_t sat_##name##_n(const from_t *in, to_t *out, size_t n) { \
+        size_t clamped = 0u;                                               \
+        size_t i;                                                          \
+        for (i = 0u; i < n; i++) {                                         \
+            from_t v = in[i];                                              \
+            clamped += ((below) || (above)) ? 1u : 0u;                     \
+            out[i] = sat_##name(v);                                        \
+        }                                                                  \
+        return clamped;                                                    \
+    }
+
+INT_CONVERT_DEFINE(i16_to_i8, int16_t, int8_t, v < INT8_MIN, v > INT8_MAX, INT8_MIN, INT8_MAX)
+INT_CONVERT_DEFINE(i16_to_u8, int16_t, uint8_t, v < 0, v > UINT8_MAX, 0, UINT8_MAX)
+INT_CONVERT_DEFINE(i32_to_i8, int32_t, int8_t, v < INT8_MIN, v > INT8_MAX, INT8_MIN, INT8_MAX)
+INT_CONVERT_DEFINE(i32_to_u8, int32_t, uint8_t, v < 0, v > UINT8_MAX, 0, UINT8_MAX)
+INT_CONVERT_DEFINE(i32_to_i16, int32_t, int16_t, v < INT16_MIN, v > INT16_MAX, INT16_MIN, INT16_MAX)
+INT_CONVERT_DEFINE(i32_to_u16, int32_t, uint16_t, v < 0, v > UINT16_MAX, 0, UINT16_MAX)
+INT_CONVERT_DEFINE(i32_to_u32, int32_t, uint32_t, v < 0, false, 0, 0)
+INT_CONVERT_DEFINE(u32_to_i32, uint32_t, int32_t, false, v > (uint32_t)INT32_MAX, 0, INT32_MAX)
+INT_CONVERT_DEFINE(u32_to_u16, uint32_t, uint16_t, false, v > UINT16_MAX, 0, UINT16_MAX)
+INT_CONVERT_DEFINE(i64_to_i32, int64_t, int32_t, v < INT32_MIN, v > INT32_MAX, INT32_MIN, INT32_MAX)
+INT_CONVERT_DEFINE(i64_to_u32, int64_t, uint32_t, v < 0, v > (int64_t)UINT32_MAX, 0, UINT32_MAX)
+INT_CONVERT_DEFINE(u64_to_u32, uint64_t, uint32_t, false, v > UINT32_MAX, 0, UINT32_MAX)
+INT_CONVERT_DEFINE(u64_to_i64, uint64_t, int64_t, false, v > (uint64_t)INT64_MAX, 0, INT64_MAX)
+INT_CONVERT_DEFINE(i64_to_u64, int64_t, uint64_t, v < 0, false, 0, 0)
+
+#endif /* INT_CONVERT_H */
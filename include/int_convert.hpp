@@ -0,0 +1,203 @@
+/**
+ * @file int_convert.hpp
+ * @brief Checked, saturating and wrapping integer conversions (C++14).
+ *
+ * Compliant alternative for CERT C INT31-C, MISRA C 2012 Rule 10.3,
+ * AUTOSAR M5-0-3 and MISRA C++ 5-0-3. The range check for each
+ * (To, From) pair is chosen at compile time from the types' limits:
+ * lossless pairs get no check at all, and the others get a single
+ * comparison or a round trip, so the checks stay branch-free and the bulk
+ * *_n kernels vectorise.
+ */
+
+#ifndef INT_CONVERT_HPP
+#define INT_CONVERT_HPP
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace cs {
+
+namespace detail {
+
+enum class range_check {
+    none,            // every From value fits in To
+    round_trip,      // same signedness, narrowing: To -> From restores v
+    non_negative,    // signed -> wider-or-equal unsigned: v >= 0
+    unsigned_le_max, // signed -> narrower unsigned: unsigned(v) <= To max
+    le_max           // unsigned -> narrower-or-equal signed: v <= To max
+};
+
+template <typename To, typename From>
+constexpr range_check select_check() noexcept {
+    using lt = std::numeric_limits<To>;
+    using lf = std::numeric_limits<From>;
+    return (lf::is_signed == lt::is_signed)
+               ? ((lt::digits >= lf::digits) ? range_check::none : range_check::round_trip)
+           : lf::is_signed
+               ? ((lt::digits >= lf::digits) ? range_check::non_negative
+                                             : range_check::unsigned_le_max)
+               : ((lt::digits >= lf::digits) ? range_check::none : range_check::le_max);
+}
+
+template <range_check Kind>
+struct checker;
+
+template <>
+struct checker<range_check::none> {
+    template <typename To, typename From>
+    static constexpr bool fits(From) noexcept { return true; }
+};
+
+template <>
+struct checker<range_check::round_trip> {
+    template <typename To, typename From>
+    static constexpr bool fits(From v) noexcept {
+        return static_cast<From>(static_cast<To>(v)) == v;
+    }
+};
+
+template <>
+struct checker<range_check::non_negative> {
+    template <typename To, typename From>
+    static constexpr bool fits(From v) noexcept { return v >= From{0}; }
+};
+
+template <>
+struct checker<range_check::unsigned_le_max> {
+    template <typename To, typename From>
+    static constexpr bool fits(From v) noexcept {
+        using uf = typename std::make_unsigned<From>::type;
+        return static_cast<uf>(v) <= static_cast<uf>(std::numeric_limits<To>::max());
+    }
+};
+
+template <>
+struct checker<range_check::le_max> {
+    template <typename To, typename From>
+    static constexpr bool fits(From v) noexcept {
+        return v <= static_cast<From>(std::numeric_limits<To>::max());
+    }
+};
+
+/** a < b across signedness without the usual arithmetic conversions. */
+template <bool SignedA, bool SignedB>
+struct less_impl {
+    template <typename A, typename B>
+    static constexpr bool apply(A a, B b) noexcept { return a < b; }
+};
+
+template <>
+struct less_impl<true, false> {
+    template <typename A, typename B>
+    static constexpr bool apply(A a, B b) noexcept {
+        return (a < A{0}) || (static_cast<typename std::make_unsigned<A>::type>(a) < b);
+    }
+};
+
+template <>
+struct less_impl<false, true> {
+    template <typename A, typename B>
+    static constexpr bool apply(A a, B b) noexcept {
+        return (b >= B{0}) && (a < static_cast<typename std::make_unsigned<B>::type>(b));
+    }
+};
+
+template <typename A, typename B>
+constexpr bool cmp_less(A a, B b) noexcept {
+    return less_impl<std::is_signed<A>::value, std::is_signed<B>::value>::apply(a, b);
+}
+
+template <typename To, typename From>
+constexpr void require_integral() noexcept {
+    static_assert(std::is_integral<To>::value && std::is_integral<From>::value,
+                  "integer conversions only");
+    static_assert(!std::is_same<To, bool>::value && !std::is_same<From, bool>::value,
+                  "bool is not an integer type here");
+}
+
+}  // namespace detail
+
+/** True if every value of From is exactly representable in To. */
+template <typename To, typename From>
+struct is_lossless
+    : std::integral_constant<bool,
+                             std::is_floating_point<To>::value
+                                 ? (std::numeric_limits<To>::digits >=
+                                    std::numeric_limits<From>::digits)
+                                 : (detail::select_check<To, From>() ==
+                                    detail::range_check::none)> {};
+
+/** True if `v` is exactly representable in To. */
+template <typename To, typename From>
+constexpr bool in_range(From v) noexcept {
+    detail::require_integral<To, From>();
+    return detail::checker<detail::select_check<To, From>()>::template fits<To>(v);
+}
+
+/** Explicit conversion that only compiles when it can never lose data. */
+template <typename To, typename From>
+constexpr To widen(From v) noexcept {
+    static_assert(std::is_arithmetic<To>::value && std::is_integral<From>::value,
+                  "widen converts integers to arithmetic types");
+    static_assert(is_lossless<To, From>::value, "conversion may lose data");
+    return static_cast<To>(v);
+}
+
+/** Store `v` in `out` and return true if it fits; otherwise leave `out`. */
+template <typename To, typename From>
+constexpr bool try_convert(From v, To &out) noexcept {
+    bool ok = in_range<To>(v);
+    if (ok) {
+        out = static_cast<To>(v);
+    }
+    return ok;
+}
+
+/** Clamp `v` to the range of To. */
+template <typename To, typename From>
+constexpr To saturate_cast(From v) noexcept {
+    detail::require_integral<To, From>();
+    using lt = std::numeric_limits<To>;
+    return detail::cmp_less(v, lt::min())   ? lt::min()
+           : detail::cmp_less(lt::max(), v) ? lt::max()
+                                            : static_cast<To>(v);
+}
+
+/** Reduce `v` modulo 2^N of To (the definition GCC/Clang use, and C++20's). */
+template <typename To, typename From>
+constexpr To wrap_cast(From v) noexcept {
+    detail::require_integral<To, From>();
+    return static_cast<To>(static_cast<typename std::make_unsigned<To>::type>(v));
+}
+
+/**
+ * Bulk conversions over arrays. Each writes all `n` outputs and returns
+ * how many inputs were not exactly representable (0 means the whole batch
+ * converted losslessly), so callers test once per batch instead of once
+ * per element.
+ */
+template <typename To, typename From>
+std::size_t wrap_n(const From *in, To *out, std::size_t n) noexcept {
+    std::size_t lossy = 0u;
+    for (std::size_t i = 0u; i < n; ++i) {
+        lossy += in_range<To>(in[i]) ? 0u : 1u;
+        out[i] = wrap_cast<To>(in[i]);
+    }
+    return lossy;
+}
+
+template <typename To, typename From>
+std::size_t saturate_n(const From *in, To *out, std::size_t n) noexcept {
+    std::size_t lossy = 0u;
+    for (std::size_t i = 0u; i < n; ++i) {
+        lossy += in_range<To>(in[i]) ? 0u : 1u;
+        out[i] = saturate_cast<To>(in[i]);
+    }
+    return lossy;
+}
+
+}  // namespace cs
+
+#endif  // INT_CONVERT_HPP
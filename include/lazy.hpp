@@ -0,0 +1,114 @@
+/**
+ * @file lazy.hpp
+ * @brief C++14 lazily constructed global that reports construction
+ * failures to the caller.
+ *
+ * Compliant alternative for CERT C++ ERR58-CPP. A cs::lazy is constant-
+ * initialised, so it costs nothing at load time and nothing can throw
+ * before main(). The first get() runs the init function exactly once,
+ * even under contention; later calls take a single acquire load. If init
+ * returns an error, or init or T's move constructor throws, that get()
+ * returns the error or rethrows, and the next get() tries again.
+ *
+ *   cs::expected<config, std::errc> load_config();
+ *   cs::lazy<config, std::errc> g_config(load_config);
+ *
+ *   auto c = g_config.get();   // cs::expected<config *, std::errc>
+ *
+ * The object is never destroyed. That avoids exit-time destructor
+ * ordering problems, and it keeps the type trivially destructible so no
+ * destructor is registered at startup.
+ */
+
+#ifndef LAZY_HPP
+#define LAZY_HPP
+
+#include "expected.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+
+template <typename T, typename E>
+class lazy {
+public:
+    using init_fn = expected<T, E> (*)();
+
+    constexpr explicit lazy(init_fn init) noexcept : init_(init), state_(empty), storage_{} {}
+
+    lazy(const lazy &) = delete;
+    lazy &operator=(const lazy &) = delete;
+
+    /** The object, constructing it first if needed; or init's error. */
+    expected<T *, E> get() {
+        expected<T *, E> result = object();
+        if (state_.load(std::memory_order_acquire) != ready) {
+            result = construct();
+        }
+        return result;
+    }
+
+    /** True once construction has succeeded. */
+    bool ready_now() const noexcept { return state_.load(std::memory_order_acquire) == ready; }
+
+private:
+    enum : std::uint8_t { empty, busy, ready };
+
+    T *object() noexcept { return reinterpret_cast<T *>(&storage_); }
+
+    expected<T *, E> construct() {
+        expected<T *, E> result = object();
+        bool done = false;
+        while (!done) {
+            std::uint8_t expect = empty;
+            if (state_.compare_exchange_strong(expect, busy, std::memory_order_acquire)) {
+#if defined(__cpp_exceptions)
+                try {
+                    result = run_init();
+                } catch (...) {
+                    // An exception from init or T's move leaves the object unbuilt
+                    state_.store(empty, std::memory_order_release);
+                    throw;
+                }
+#else
+                result = run_init();
+#endif
+                done = true;
+            } else if (expect == ready) {
+                done = true;
+            } else {
+                // Another thread is running init: wait for ready, or for empty
+                // after a failure, in which case this thread tries init itself
+                std::this_thread::yield();
+            }
+        }
+        return result;
+    }
+
+    /** Called with state_ busy; leaves it ready or, on an error, empty. */
+    expected<T *, E> run_init() {
+        expected<T *, E> result = object();
+        expected<T, E> value = init_();
+        if (value) {
+            ::new (static_cast<void *>(&storage_)) T(std::move(*value));
+            state_.store(ready, std::memory_order_release);
+        } else {
+            state_.store(empty, std::memory_order_release);
+            result = make_unexpected(std::move(value).error());
+        }
+        return result;
+    }
+
+    init_fn init_;
+    std::atomic<std::uint8_t> state_;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+};
+
+}  // namespace cs
+
+#endif  // LAZY_HPP
@@ -0,0 +1,144 @@
+/**
+ * @file poly_value.hpp
+ * @brief C++14 value type that holds any object derived from Base in
+ * inline storage, keeping its dynamic type.
+ *
+ * Compliant alternative for CERT C++ OOP51-CPP. Passing or storing Base
+ * by value slices; the usual fix, Base * or std::unique_ptr<Base>, puts
+ * each element of a container in its own heap block. A
+ * cs::poly_value<Base, N> stores the derived object itself in an N-byte
+ * buffer. Copying it copies the derived object and calls dispatch
+ * virtually as before, so a std::vector of them is one contiguous
+ * allocation:
+ *
+ *   std::vector<cs::poly_value<shape, 32>> shapes;
+ *   shapes.emplace_back(circle{1.0});
+ *   shapes[0]->area();
+ *
+ * A type that does not fit in N bytes, or needs more alignment than
+ * Align (std::max_align_t by default), is a compile error, not a silent
+ * heap fallback. Lowering Align to alignof(void *) saves padding when no
+ * type in the hierarchy needs more. Base needs a virtual destructor.
+ */
+
+#ifndef POLY_VALUE_HPP
+#define POLY_VALUE_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+
+template <typename Base, std::size_t N = 4u * sizeof(void *),
+          std::size_t Align = alignof(std::max_align_t)>
+class poly_value {
+    static_assert(std::has_virtual_destructor<Base>::value, "Base needs a virtual destructor");
+
+    template <typename D>
+    using if_fits = typename std::enable_if<
+        std::is_base_of<Base, typename std::decay<D>::type>::value &&
+        !std::is_same<typename std::decay<D>::type, poly_value>::value>::type;
+
+public:
+    /** Holds a copy of `object`, which keeps its dynamic type. */
+    template <typename D, typename = if_fits<D>>
+    poly_value(D &&object) {
+        using type = typename std::decay<D>::type;
+        check_fits<type>();
+        ops_ = &ops_for<type>::table;
+        base_ = static_cast<Base *>(::new (static_cast<void *>(buffer_)) type(std::forward<D>(object)));
+    }
+
+    /** Constructs a D in place: `auto s = poly_value<shape>::make<circle>(1.0);`. */
+    template <typename D, typename... Args>
+    static poly_value make(Args &&...args) {
+        return poly_value(construct_tag<D>{}, std::forward<Args>(args)...);
+    }
+
+    poly_value(const poly_value &other) : ops_(other.ops_) {
+        base_ = ops_->copy(buffer_, other.buffer_);
+    }
+
+    poly_value(poly_value &&other) noexcept : ops_(other.ops_) {
+        base_ = ops_->move(buffer_, other.buffer_);
+    }
+
+    poly_value &operator=(const poly_value &other) {
+        if (this != &other) {
+            poly_value copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    poly_value &operator=(poly_value &&other) noexcept {
+        if (this != &other) {
+            base_->~Base();
+            ops_ = other.ops_;
+            base_ = ops_->move(buffer_, other.buffer_);
+        }
+        return *this;
+    }
+
+    ~poly_value() { base_->~Base(); }
+
+    Base *get() noexcept { return base_; }
+    const Base *get() const noexcept { return base_; }
+    Base *operator->() noexcept { return base_; }
+    const Base *operator->() const noexcept { return base_; }
+    Base &operator*() noexcept { return *base_; }
+    const Base &operator*() const noexcept { return *base_; }
+
+    static constexpr std::size_t capacity() noexcept { return N; }
+
+private:
+    struct ops {
+        Base *(*copy)(void *dst, const void *src);
+        Base *(*move)(void *dst, void *src) noexcept;
+    };
+
+    template <typename D>
+    struct ops_for {
+        static Base *copy(void *dst, const void *src) {
+            return static_cast<Base *>(::new (dst) D(*static_cast<const D *>(src)));
+        }
+        static Base *move(void *dst, void *src) noexcept {
+            return static_cast<Base *>(::new (dst) D(std::move(*static_cast<D *>(src))));
+        }
+        static constexpr ops table = {&copy, &move};
+    };
+
+    template <typename D>
+    struct construct_tag {};
+
+    template <typename D, typename... Args>
+    explicit poly_value(construct_tag<D>, Args &&...args) {
+        check_fits<D>();
+        ops_ = &ops_for<D>::table;
+        base_ = static_cast<Base *>(::new (static_cast<void *>(buffer_)) D(std::forward<Args>(args)...));
+    }
+
+    template <typename D>
+    static void check_fits() noexcept {
+        static_assert(std::is_base_of<Base, D>::value, "poly_value holds types derived from Base");
+        static_assert(sizeof(D) <= N, "type does not fit the poly_value buffer; raise N");
+        static_assert(alignof(D) <= Align, "type needs more alignment than the buffer; raise Align");
+        static_assert(std::is_copy_constructible<D>::value, "poly_value needs copyable types");
+        static_assert(std::is_nothrow_move_constructible<D>::value,
+                      "poly_value needs types that move without throwing");
+    }
+
+    alignas(Align) unsigned char buffer_[N];
+    const ops *ops_;
+    Base *base_;  // Into buffer_; re-derived on every copy and move
+};
+
+template <typename Base, std::size_t N, std::size_t Align>
+template <typename D>
+constexpr typename poly_value<Base, N, Align>::ops poly_value<Base, N, Align>::ops_for<D>::table;
+
+}  // namespace cs
+
+#endif  // POLY_VALUE_HPP
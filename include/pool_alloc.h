@@ -0,0 +1,83 @@
+/**
+ * @file pool_alloc.h
+ * @brief Deterministic fixed-size-block pool allocator (C11 API).
+ *
+ * Compliant alternative to malloc/free for MISRA C 2012 Rule 21.3,
+ * AUTOSAR A18-5-1 and MISRA C++ 18-4-1. The pool never touches the heap:
+ * the caller supplies storage (normally an object with static storage
+ * duration) and every allocate/free is O(1) with no searching, splitting
+ * or coalescing, so latency does not depend on allocation history.
+ */
+
+#ifndef POOL_ALLOC_H
+#define POOL_ALLOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#define POOL_ALIGNOF(type) alignof(type)
+#else
+#define POOL_ALIGNOF(type) _Alignof(type)
+#endif
+
+/* Every block is aligned for any fundamental type. */
+#define POOL_ALIGN ((size_t)POOL_ALIGNOF(max_align_t))
+
+/* Block size actually used for a requested object size: large enough to
+ * hold the free-list link and rounded up to POOL_ALIGN. */
+#define POOL_BLOCK_SIZE(size)                                              \
+    (((((size) < sizeof(void *)) ? sizeof(void *) : (size)) + POOL_ALIGN - 1u) \
+     / POOL_ALIGN * POOL_ALIGN)
+
+/* Bytes of storage needed for `count` blocks of `size` bytes. */
+#define POOL_STORAGE_SIZE(size, count) (POOL_BLOCK_SIZE(size) * (count))
+
+/* Declares suitably aligned static storage for a pool. */
+#define POOL_DEFINE_STORAGE(name, size, count)                             \
+    static max_align_t name[(POOL_STORAGE_SIZE((size), (count))            \
+                             + sizeof(max_align_t) - 1u) / sizeof(max_align_t)]
+
+typedef struct pool_block {
+    struct pool_block *next;
+} pool_block_t;
+
+typedef struct pool {
+    unsigned char *storage;  /* First block */
+    size_t block_size;       /* Rounded block size in bytes */
+    size_t block_count;      /* Total number of blocks */
+    size_t next_unused;      /* Index of the first never-allocated block */
+    size_t in_use;           /* Blocks currently handed out */
+    pool_block_t *free_list; /* Blocks returned by pool_free() */
+} pool_t;
+
+/**
+ * Initialise a pool over caller-owned storage. Runs in O(1): blocks are
+ * carved lazily from the untouched tail, so no free list is built up front.
+ * Returns false if the arguments cannot describe at least one block or the
+ * storage is misaligned.
+ */
+bool pool_init(pool_t *pool, void *storage, size_t storage_size, size_t object_size);
+
+/** Allocate one block, or return NULL when the pool is exhausted. */
+void *pool_alloc(pool_t *pool);
+
+/** Return a block obtained from pool_alloc(). NULL is ignored. */
+void pool_free(pool_t *pool, void *block);
+
+/** True if `ptr` is the start of a block inside the pool's storage. */
+bool pool_owns(const pool_t *pool, const void *ptr);
+
+size_t pool_capacity(const pool_t *pool);
+size_t pool_in_use(const pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POOL_ALLOC_H */
@@ -0,0 +1,171 @@
+/**
+ * @file pool_alloc.hpp
+ * @brief C++14 static pool, standard allocator and typed object pool built
+ * on the C pool allocator in pool_alloc.h.
+ */
+
+#ifndef POOL_ALLOC_HPP
+#define POOL_ALLOC_HPP
+
+#include "pool_alloc.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+
+/**
+ * A pool that owns its storage inline. Declare it with static storage
+ * duration to get heap-free allocation of up to BlockCount blocks of
+ * BlockSize bytes each.
+ */
+template <std::size_t BlockSize, std::size_t BlockCount>
+class static_pool {
+public:
+    static_assert(BlockSize > 0u, "BlockSize must be non-zero");
+    static_assert(BlockCount > 0u, "BlockCount must be non-zero");
+
+    static_pool() noexcept {
+        static_cast<void>(pool_init(&pool_, storage_, sizeof(storage_), BlockSize));
+    }
+
+    static_pool(const static_pool &) = delete;
+    static_pool &operator=(const static_pool &) = delete;
+
+    void *allocate() noexcept { return pool_alloc(&pool_); }
+    void deallocate(void *block) noexcept { pool_free(&pool_, block); }
+
+    std::size_t capacity() const noexcept { return pool_capacity(&pool_); }
+    std::size_t in_use() const noexcept { return pool_in_use(&pool_); }
+
+    pool_t &native() noexcept { return pool_; }
+
+private:
+    alignas(max_align_t) unsigned char storage_[POOL_STORAGE_SIZE(BlockSize, BlockCount)];
+    pool_t pool_;
+};
+
+/**
+ * Standard allocator over a pool_t. Each allocation must fit in one block,
+ * so this is meant for node-based containers (std::list, std::map, ...)
+ * whose rebound node type fits the pool's block size.
+ */
+template <typename T>
+class pool_allocator {
+public:
+    using value_type = T;
+
+    explicit pool_allocator(pool_t &pool) noexcept : pool_(&pool) {}
+
+    template <typename U>
+    pool_allocator(const pool_allocator<U> &other) noexcept : pool_(other.pool()) {}
+
+    T *allocate(std::size_t n) {
+        void *block = nullptr;
+        if ((n == 1u) && (sizeof(T) <= pool_->block_size) &&
+            (alignof(T) <= POOL_ALIGN)) {
+            block = pool_alloc(pool_);
+        }
+        if (block == nullptr) {
+#if defined(__cpp_exceptions)
+            throw std::bad_alloc();
+#else
+            std::abort();
+#endif
+        }
+        return static_cast<T *>(block);
+    }
+
+    void deallocate(T *p, std::size_t) noexcept { pool_free(pool_, p); }
+
+    pool_t *pool() const noexcept { return pool_; }
+
+private:
+    pool_t *pool_;
+};
+
+template <typename T, typename U>
+bool operator==(const pool_allocator<T> &a, const pool_allocator<U> &b) noexcept {
+    return a.pool() == b.pool();
+}
+
+template <typename T, typename U>
+bool operator!=(const pool_allocator<T> &a, const pool_allocator<U> &b) noexcept {
+    return !(a == b);
+}
+
+/**
+ * Fixed-capacity pool of T objects. create() constructs in place and
+ * returns nullptr when the pool is exhausted; make() wraps the result in a
+ * unique_ptr that returns the block to the pool on destruction.
+ */
+template <typename T, std::size_t Capacity>
+class typed_pool {
+public:
+    static_assert(alignof(T) <= alignof(max_align_t), "over-aligned types are not supported");
+
+    class deleter {
+    public:
+        deleter() noexcept = default;
+        explicit deleter(typed_pool &owner) noexcept : owner_(&owner) {}
+        void operator()(T *p) const noexcept {
+            if (owner_ != nullptr) {
+                owner_->destroy(p);
+            }
+        }
+
+    private:
+        typed_pool *owner_ = nullptr;
+    };
+
+    using handle = std::unique_ptr<T, deleter>;
+
+    typed_pool() noexcept = default;
+    typed_pool(const typed_pool &) = delete;
+    typed_pool &operator=(const typed_pool &) = delete;
+
+    template <typename... Args>
+    T *create(Args &&...args) {
+        T *result = nullptr;
+        void *block = pool_.allocate();
+        if (block != nullptr) {
+#if defined(__cpp_exceptions)
+            try {
+                result = ::new (block) T(std::forward<Args>(args)...);
+            } catch (...) {
+                pool_.deallocate(block);
+                throw;
+            }
+#else
+            result = ::new (block) T(std::forward<Args>(args)...);
+#endif
+        }
+        return result;
+    }
+
+    void destroy(T *p) noexcept {
+        if (p != nullptr) {
+            p->~T();
+            pool_.deallocate(p);
+        }
+    }
+
+    template <typename... Args>
+    handle make(Args &&...args) {
+        return handle(create(std::forward<Args>(args)...), deleter(*this));
+    }
+
+    std::size_t capacity() const noexcept { return pool_.capacity(); }
+    std::size_t in_use() const noexcept { return pool_.in_use(); }
+
+private:
+    static_pool<sizeof(T), Capacity> pool_;
+};
+
+}  // namespace cs
+
+#endif  // POOL_ALLOC_HPP
@@ -0,0 +1,106 @@
+/**
+ * @file prng.hpp
+ * @brief C++14 UniformRandomBitGenerator wrappers around prng.h.
+ *
+ * cs::xoshiro256 plugs into <random> distributions in place of std::rand()
+ * or std::mt19937_64; cs::xoshiro256_bulk exposes the lane-parallel fill.
+ */
+
+#ifndef PRNG_HPP
+#define PRNG_HPP
+
+#include "prng.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <system_error>
+
+namespace cs {
+
+class xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    explicit xoshiro256(std::uint64_t seed) noexcept { xoshiro256_seed(&state_, seed); }
+
+    /**
+     * Seeded from OS entropy; throws std::system_error if unavailable
+     * (aborts when built with -fno-exceptions).
+     */
+    static xoshiro256 from_entropy() {
+        xoshiro256 rng(0u);
+        if (!xoshiro256_seed_from_entropy(&rng.state_)) {
+#if defined(__cpp_exceptions)
+            throw std::system_error(errno, std::generic_category(), "getentropy");
+#else
+            std::abort();
+#endif
+        }
+        return rng;
+    }
+
+    /** Stream `index` of the family rooted at this generator's state. */
+    xoshiro256 stream(std::size_t index) const noexcept {
+        xoshiro256 copy = *this;
+        for (std::size_t i = 0u; i < index; ++i) {
+            copy.long_jump();
+        }
+        return copy;
+    }
+
+    static constexpr result_type min() noexcept { return 0u; }
+    static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() noexcept { return xoshiro256_next(&state_); }
+
+    void discard(unsigned long long n) noexcept {
+        for (unsigned long long i = 0u; i < n; ++i) {
+            static_cast<void>(xoshiro256_next(&state_));
+        }
+    }
+
+    void jump() noexcept { xoshiro256_jump(&state_); }
+    void long_jump() noexcept { xoshiro256_long_jump(&state_); }
+
+    void fill(result_type *out, std::size_t n) noexcept { xoshiro256_fill(&state_, out, n); }
+
+    xoshiro256_t &native() noexcept { return state_; }
+
+    friend bool operator==(const xoshiro256 &a, const xoshiro256 &b) noexcept {
+        return (a.state_.s[0] == b.state_.s[0]) && (a.state_.s[1] == b.state_.s[1]) &&
+               (a.state_.s[2] == b.state_.s[2]) && (a.state_.s[3] == b.state_.s[3]);
+    }
+    friend bool operator!=(const xoshiro256 &a, const xoshiro256 &b) noexcept {
+        return !(a == b);
+    }
+
+private:
+    xoshiro256_t state_;
+};
+
+/**
+ * XOSHIRO256_LANES interleaved streams for bulk generation. Constructing
+ * from `base` jumps it past the lanes it hands out.
+ */
+class xoshiro256_bulk {
+public:
+    explicit xoshiro256_bulk(xoshiro256 &base) noexcept {
+        xoshiro256_lanes_init(&lanes_, &base.native());
+    }
+
+    void fill(std::uint64_t *out, std::size_t n) noexcept {
+        xoshiro256_lanes_fill(&lanes_, out, n);
+    }
+
+private:
+    xoshiro256_lanes_t lanes_;
+};
+
+}  // namespace cs
+
+#endif  // PRNG_HPP
@@ -0,0 +1,113 @@
+/**
+ * @file probe.h
+ * @brief Scoped timing probes with per-thread counters and a JSON report
+ * at exit (C11 and C++14, GCC/Clang).
+ *
+ * A probe site is a named point in the code; every pass through it adds
+ * one call and its duration to the calling thread's counters (count,
+ * total, min, max). Each thread records into its own buffer, so recording
+ * takes no lock and shares no cache line with other threads. At exit the
+ * buffers are merged and written as JSON to the file named by
+ * probe_set_output() or $PROBE_JSON, or to stderr.
+ *
+ *   void work(void) {
+ *       PROBE_SCOPE("work");    // Times the rest of the enclosing block
+ *       ...
+ *   }
+ *   PROBE_CALL(work, ());       // Times one call, named after the function
+ *
+ * Probes are compiled in only when PROBE_ENABLE is defined (`make
+ * probes`). Otherwise PROBE_SCOPE expands to nothing and PROBE_CALL to
+ * the bare call, so an uninstrumented build contains no probe code at all.
+ *
+ * Durations are read from the TSC on x86 and CLOCK_MONOTONIC elsewhere;
+ * the report converts ticks to nanoseconds with a rate calibrated against
+ * CLOCK_MONOTONIC over the life of the process. The report is written by
+ * an atexit() handler, so a process that crashes or calls _exit() writes
+ * none.
+ */
+
+#ifndef PROBE_H
+#define PROBE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Distinct sites per process; passes through later sites are counted as dropped. */
+#define PROBE_MAX_SITES 256u
+
+typedef struct probe_site {
+    const char *name;
+    uint32_t id; /* 0 until first use registers the site */
+} probe_site_t;
+
+typedef struct probe_scope {
+    probe_site_t *site;
+    uint64_t start;
+} probe_scope_t;
+
+/** CLOCK_MONOTONIC in nanoseconds. */
+uint64_t probe_clock_ns(void);
+
+/** Add one pass of `ticks` duration at `site` to the calling thread's counters. */
+void probe_record(probe_site_t *site, uint64_t ticks);
+
+/**
+ * Where the exit report goes: a file path, "-" for stderr, or NULL for no
+ * report. Overrides $PROBE_JSON.
+ */
+void probe_set_output(const char *path);
+
+/** Write the merged counters as JSON; false on a write error. */
+bool probe_write_json(FILE *out);
+
+static inline uint64_t probe_ticks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return probe_clock_ns();
+#endif
+}
+
+static inline probe_scope_t probe_scope_begin(probe_site_t *site) {
+    probe_scope_t scope;
+    scope.site = site;
+    scope.start = probe_ticks();
+    return scope;
+}
+
+static inline void probe_scope_end(probe_scope_t *scope) {
+    probe_record(scope->site, probe_ticks() - scope->start);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#define PROBE_CAT_(a, b) a##b
+#define PROBE_CAT(a, b) PROBE_CAT_(a, b)
+
+#if defined(PROBE_ENABLE)
+/* The cleanup attribute ends the scope on every exit from the block,
+ * including C++ exceptions. */
+#define PROBE_SCOPE(name)                                                          \
+    static probe_site_t PROBE_CAT(probe_site_, __LINE__) = {(name), 0u};           \
+    probe_scope_t PROBE_CAT(probe_scope_, __LINE__)                                \
+        __attribute__((cleanup(probe_scope_end), unused)) =                        \
+            probe_scope_begin(&PROBE_CAT(probe_site_, __LINE__))
+#define PROBE_CALL(fn, args) \
+    __extension__({          \
+        PROBE_SCOPE(#fn);    \
+        fn args;             \
+    })
+#else
+#define PROBE_SCOPE(name)
+#define PROBE_CALL(fn, args) fn args
+#endif
+
+#endif /* PROBE_H */
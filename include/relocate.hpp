@@ -0,0 +1,127 @@
+/**
+ * @file relocate.hpp
+ * @brief C++14 bulk copy and relocation of object arrays, dispatched on
+ * std::is_trivially_copyable.
+ *
+ * Compliant alternative for CERT C++ OOP57-CPP. Calling std::memcpy on
+ * objects is only correct when their type is trivially copyable, and
+ * nothing at the call site stops someone from later adding a std::string
+ * member. These helpers make that check once, in the type system: a
+ * trivially copyable T is copied with one memcpy, anything else goes
+ * through its copy or move constructor element by element.
+ *
+ *   cs::copy_construct_n(src, n, dst)  construct copies in raw storage
+ *   cs::copy_assign_n(src, n, dst)     assign over live objects
+ *   cs::relocate_n(src, n, dst)        move into raw storage, destroy src
+ *
+ * Ranges must not overlap. If a copy constructor throws, copy_construct_n
+ * destroys what it built and rethrows.
+ */
+
+#ifndef RELOCATE_HPP
+#define RELOCATE_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+
+namespace detail {
+
+template <typename T>
+using is_bitwise = std::integral_constant<bool, std::is_trivially_copyable<T>::value>;
+
+template <typename T>
+void bitwise_copy(const T *src, std::size_t n, T *dst) noexcept {
+    if (n > 0u) {
+        std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+    }
+}
+
+template <typename T>
+void destroy_n(T *p, std::size_t n) noexcept {
+    for (std::size_t i = 0u; i < n; ++i) {
+        p[i].~T();
+    }
+}
+
+template <typename T>
+void copy_construct_n(const T *src, std::size_t n, T *dst, std::true_type) noexcept {
+    bitwise_copy(src, n, dst);
+}
+
+template <typename T>
+void copy_construct_n(const T *src, std::size_t n, T *dst, std::false_type) {
+    std::size_t built = 0u;
+#if defined(__cpp_exceptions)
+    try {
+#endif
+        for (; built < n; ++built) {
+            ::new (static_cast<void *>(dst + built)) T(src[built]);
+        }
+#if defined(__cpp_exceptions)
+    } catch (...) {
+        destroy_n(dst, built);
+        throw;
+    }
+#endif
+}
+
+template <typename T>
+void copy_assign_n(const T *src, std::size_t n, T *dst, std::true_type) noexcept {
+    bitwise_copy(src, n, dst);
+}
+
+template <typename T>
+void copy_assign_n(const T *src, std::size_t n, T *dst, std::false_type) {
+    for (std::size_t i = 0u; i < n; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+template <typename T>
+void relocate_n(T *src, std::size_t n, T *dst, std::true_type) noexcept {
+    bitwise_copy(src, n, dst);
+}
+
+template <typename T>
+void relocate_n(T *src, std::size_t n, T *dst, std::false_type) noexcept {
+    for (std::size_t i = 0u; i < n; ++i) {
+        ::new (static_cast<void *>(dst + i)) T(std::move(src[i]));
+        src[i].~T();
+    }
+}
+
+}  // namespace detail
+
+/** Copy-construct src[0..n) into uninitialised storage at dst. */
+template <typename T>
+void copy_construct_n(const T *src, std::size_t n, T *dst) noexcept(
+    std::is_nothrow_copy_constructible<T>::value) {
+    detail::copy_construct_n(src, n, dst, detail::is_bitwise<T>{});
+}
+
+/** Copy-assign src[0..n) over the live objects dst[0..n). */
+template <typename T>
+void copy_assign_n(const T *src, std::size_t n, T *dst) noexcept(
+    std::is_nothrow_copy_assignable<T>::value) {
+    detail::copy_assign_n(src, n, dst, detail::is_bitwise<T>{});
+}
+
+/**
+ * Move src[0..n) into uninitialised storage at dst and end the lifetime of
+ * the sources, which are left as raw storage.
+ */
+template <typename T>
+void relocate_n(T *src, std::size_t n, T *dst) noexcept {
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "relocate_n needs types that move without throwing");
+    detail::relocate_n(src, n, dst, detail::is_bitwise<T>{});
+}
+
+}  // namespace cs
+
+#endif  // RELOCATE_HPP
@@ -0,0 +1,93 @@
+/**
+ * @file sig_ring.h
+ * @brief Lock-free, async-signal-safe event ring for signal handlers (C11).
+ *
+ * Compliant alternative for CERT C SIG30-C: a handler records a fixed-size
+ * event with sig_ring_push()/sig_ring_record(), which use only lock-free
+ * atomics and clock_gettime() (both async-signal-safe), and an ordinary
+ * thread later formats and writes the events with batched write() calls.
+ *
+ * The ring is multi-producer (handlers may nest or run on several threads)
+ * and single-consumer. A zero-initialised sig_ring_t is ready to use, so a
+ * ring with static storage duration needs no run-time initialisation
+ * before the handler is installed. When the ring is full new events are
+ * dropped and counted rather than blocking the handler.
+ */
+
+#ifndef SIG_RING_H
+#define SIG_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of slots; must be a power of two. */
+#ifndef SIG_RING_CAPACITY
+#define SIG_RING_CAPACITY 1024u
+#endif
+
+typedef struct sig_record {
+    uint64_t timestamp_ns; /* CLOCK_MONOTONIC at the time of recording */
+    int32_t signo;
+    int32_t code;
+    uint64_t value[2];     /* Free-form payload */
+} sig_record_t;
+
+/* The layout uses C11 atomics and is only visible to C translation units;
+ * C++ code works through sig_ring_t pointers (e.g. sig_ring_default()). */
+typedef struct sig_ring sig_ring_t;
+
+#ifndef __cplusplus
+#include <stdatomic.h>
+
+typedef struct sig_ring_slot {
+    atomic_size_t seq;     /* Stored relative to the slot index (see sig_ring.c) */
+    sig_record_t record;
+} sig_ring_slot_t;
+
+struct sig_ring {
+    _Alignas(64) atomic_size_t head;   /* Next position producers claim */
+    _Alignas(64) atomic_size_t tail;   /* Next position the consumer reads */
+    _Alignas(64) atomic_size_t pushed;
+    atomic_size_t dropped;
+    sig_ring_slot_t slots[SIG_RING_CAPACITY];
+};
+#endif
+
+typedef struct sig_ring_stats {
+    size_t pushed;  /* Events accepted by the ring */
+    size_t dropped; /* Events rejected because the ring was full */
+    size_t drained; /* Events removed by the consumer */
+} sig_ring_stats_t;
+
+/** Process-wide ring with static storage duration. */
+sig_ring_t *sig_ring_default(void);
+
+/** Async-signal-safe. Copies `rec` into the ring; false if it was dropped. */
+bool sig_ring_push(sig_ring_t *ring, const sig_record_t *rec);
+
+/** Async-signal-safe. Timestamps and pushes an event. */
+bool sig_ring_record(sig_ring_t *ring, int32_t signo, int32_t code,
+                     uint64_t value0, uint64_t value1);
+
+/** Consumer only. Removes the oldest event; false if none is ready. */
+bool sig_ring_pop(sig_ring_t *ring, sig_record_t *out);
+
+/**
+ * Consumer only. Formats up to `max_records` events as text lines and
+ * writes them to `fd` in batches. Returns the number of events drained,
+ * or -1 if write() failed (errno is preserved).
+ */
+long sig_ring_drain(sig_ring_t *ring, int fd, size_t max_records);
+
+sig_ring_stats_t sig_ring_get_stats(sig_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIG_RING_H */
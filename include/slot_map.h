@@ -0,0 +1,131 @@
+/**
+ * @file slot_map.h
+ * @brief Generational slot map: densely stored objects addressed by
+ * index + generation handles (C11 API).
+ *
+ * Compliant alternative to raw pointers for CERT C MEM30-C and DCL30-C.
+ * The map owns its objects, so there is no pointer whose lifetime the
+ * caller has to track: insertion returns a slot_handle_t, and every slot
+ * carries a generation that changes when its object is erased. Looking up
+ * a handle whose object is gone compares the generations, finds they
+ * differ and returns NULL, where a dangling pointer would be undefined
+ * behaviour.
+ *
+ * Objects live in one packed array in insertion order, with erase moving
+ * the last object into the hole, so iteration over slot_map_data() is a
+ * linear scan. Pointers from slot_map_get() and slot_map_data() are
+ * therefore only valid until the next insert or erase; keep the handle and
+ * look it up again. Objects are copied in and moved with memcpy.
+ *
+ * Like pool_alloc.h, the map never touches the heap: the caller supplies
+ * the storage, and insert reports a full map by returning a null handle.
+ * A slot whose generation counter wraps is retired instead of reused, so
+ * a handle can never match a later object.
+ */
+
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Live slots have odd generations; a handle never matches an even one. */
+typedef struct slot_handle {
+    uint32_t index;
+    uint32_t generation;
+} slot_handle_t;
+
+#define SLOT_HANDLE_NULL_INIT {UINT32_MAX, 0u}
+
+typedef struct slot_entry {
+    uint32_t generation;
+    uint32_t link; /* Dense position while live, next free slot otherwise */
+} slot_entry_t;
+
+/* Bytes of storage for `capacity` objects of `size` bytes: objects first,
+ * then the slot table, then the dense-to-slot back links. */
+#define SLOT_MAP_STORAGE_SIZE(size, capacity)                                  \
+    ((((size) * (capacity)) + sizeof(slot_entry_t) - 1u) / sizeof(slot_entry_t) \
+         * sizeof(slot_entry_t)                                                 \
+     + ((capacity) * sizeof(slot_entry_t)) + ((capacity) * sizeof(uint32_t)))
+
+/* Declares suitably aligned static storage for a slot map. */
+#define SLOT_MAP_DEFINE_STORAGE(name, size, capacity)                          \
+    static max_align_t name[(SLOT_MAP_STORAGE_SIZE((size), (capacity))          \
+                             + sizeof(max_align_t) - 1u) / sizeof(max_align_t)]
+
+typedef struct slot_map {
+    unsigned char *values; /* Packed objects, element_size bytes each */
+    slot_entry_t *slots;   /* Indexed by slot_handle_t.index */
+    uint32_t *owners;      /* Slot index of the object at each dense position */
+    size_t element_size;
+    uint32_t capacity;
+    uint32_t size;        /* Live objects, also the first unused dense position */
+    uint32_t next_unused; /* Slots at or past this index have never been used */
+    uint32_t free_head;   /* Most recently freed slot, or UINT32_MAX */
+} slot_map_t;
+
+/**
+ * Initialise a map over caller-owned storage of at least
+ * SLOT_MAP_STORAGE_SIZE(element_size, capacity) bytes, aligned for
+ * max_align_t. O(1): slots are used in order before any is recycled.
+ * Returns false if the storage is too small or misaligned.
+ */
+bool slot_map_init(slot_map_t *map, void *storage, size_t storage_size, size_t element_size,
+                   uint32_t capacity);
+
+/** Copy *value into the map; a null handle if the map is full. */
+slot_handle_t slot_map_insert(slot_map_t *map, const void *value);
+
+/** Destroy the object behind `handle`; false if it was already gone. */
+bool slot_map_erase(slot_map_t *map, slot_handle_t handle);
+
+/** Remove every object; all outstanding handles go stale. */
+void slot_map_clear(slot_map_t *map);
+
+/** Handle of the object at dense position `pos` < slot_map_size(). */
+slot_handle_t slot_map_handle_at(const slot_map_t *map, uint32_t pos);
+
+/** The object behind `handle`, or NULL if it has been erased. */
+static inline void *slot_map_get(const slot_map_t *map, slot_handle_t handle) {
+    void *object = NULL;
+    if (handle.index < map->next_unused) {
+        const slot_entry_t *slot = &map->slots[handle.index];
+        if (slot->generation == handle.generation) {
+            object = map->values + ((size_t)slot->link * map->element_size);
+        }
+    }
+    return object;
+}
+
+static inline bool slot_map_contains(const slot_map_t *map, slot_handle_t handle) {
+    return slot_map_get(map, handle) != NULL;
+}
+
+static inline bool slot_handle_is_null(slot_handle_t handle) {
+    return handle.generation == 0u;
+}
+
+/** The live objects, packed: slot_map_size() of them. */
+static inline void *slot_map_data(const slot_map_t *map) {
+    return map->values;
+}
+
+static inline uint32_t slot_map_size(const slot_map_t *map) {
+    return map->size;
+}
+
+static inline uint32_t slot_map_capacity(const slot_map_t *map) {
+    return map->capacity;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLOT_MAP_H */
@@ -0,0 +1,200 @@
+/**
+ * @file slot_map.hpp
+ * @brief C++14 generational slot map with inline, fixed-capacity storage.
+ *
+ * The typed counterpart of slot_map.h, for CERT C++ code that would
+ * otherwise hold raw pointers or shared_ptr/weak_ptr pairs into a
+ * collection. It hands out the same slot_handle_t (index + generation), so
+ * handles pass through C interfaces unchanged; a stale handle makes get()
+ * return nullptr after one generation comparison, with no reference count
+ * and no heap allocation.
+ *
+ *   cs::slot_map<particle, 4096> particles;
+ *   slot_handle_t h = particles.emplace(x, y);
+ *   if (particle *p = particles.get(h)) { ... }
+ *   particles.erase(h);            // get(h) is now nullptr
+ *
+ * Objects are kept packed in insertion order, with erase moving the last
+ * object into the hole, so range-for visits them as one contiguous array.
+ * Element pointers are invalidated by insert and erase; handles are not.
+ */
+
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include "slot_map.h"
+#include "span.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+
+template <typename T, std::size_t N>
+class slot_map {
+public:
+    static_assert(N > 0u, "slot_map needs a non-zero capacity");
+    static_assert(N < std::numeric_limits<std::uint32_t>::max(),
+                  "slot_map indices are 32-bit");
+    static_assert(std::is_nothrow_move_constructible<T>::value &&
+                      std::is_nothrow_move_assignable<T>::value,
+                  "erase moves objects and must not throw");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using handle = slot_handle_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    static constexpr handle null_handle() noexcept { return handle SLOT_HANDLE_NULL_INIT; }
+
+    slot_map() noexcept = default;
+    slot_map(const slot_map &) = delete;
+    slot_map &operator=(const slot_map &) = delete;
+    ~slot_map() { clear(); }
+
+    /** Construct an object in place; null_handle() if the map is full. */
+    template <typename... Args>
+    handle emplace(Args &&...args) {
+        handle h = null_handle();
+        const std::uint32_t index = acquire();
+        if (index != kNone) {
+#if defined(__cpp_exceptions)
+            try {
+                ::new (static_cast<void *>(&storage_[size_])) T(std::forward<Args>(args)...);
+            } catch (...) {
+                // The slot is still free: its generation has not moved
+                slots_[index].link = free_head_;
+                free_head_ = index;
+                throw;
+            }
+#else
+            ::new (static_cast<void *>(&storage_[size_])) T(std::forward<Args>(args)...);
+#endif
+            slot_entry_t &slot = slots_[index];
+            ++slot.generation;
+            slot.link = static_cast<std::uint32_t>(size_);
+            owners_[size_] = index;
+            ++size_;
+            h = handle{index, slot.generation};
+        }
+        return h;
+    }
+
+    handle insert(const T &value) { return emplace(value); }
+    handle insert(T &&value) { return emplace(std::move(value)); }
+
+    /** The object behind `h`, or nullptr if it has been erased. */
+    T *get(handle h) noexcept {
+        return const_cast<T *>(static_cast<const slot_map *>(this)->get(h));
+    }
+
+    const T *get(handle h) const noexcept {
+        const T *object = nullptr;
+        if (h.index < next_unused_) {
+            const slot_entry_t &slot = slots_[h.index];
+            if (slot.generation == h.generation) {
+                object = data() + slot.link;
+            }
+        }
+        return object;
+    }
+
+    bool contains(handle h) const noexcept { return get(h) != nullptr; }
+
+    /** Destroy the object behind `h`; false if it was already gone. */
+    bool erase(handle h) noexcept {
+        T *object = get(h);
+        const bool found = object != nullptr;
+        if (found) {
+            slot_entry_t &slot = slots_[h.index];
+            const size_type last = size_ - 1u;
+            if (slot.link != last) {
+                *object = std::move(data()[last]);
+                owners_[slot.link] = owners_[last];
+                slots_[owners_[slot.link]].link = slot.link;
+            }
+            data()[last].~T();
+            size_ = last;
+            release(h.index);
+        }
+        return found;
+    }
+
+    void clear() noexcept {
+        while (size_ > 0u) {
+            static_cast<void>(erase(handle_at(size_ - 1u)));
+        }
+    }
+
+    /** Handle of the object at dense position `pos` < size(). */
+    handle handle_at(size_type pos) const noexcept {
+        const std::uint32_t index = owners_[pos];
+        return handle{index, slots_[index].generation};
+    }
+
+    T *data() noexcept { return reinterpret_cast<T *>(storage_.data()); }
+    const T *data() const noexcept { return reinterpret_cast<const T *>(storage_.data()); }
+
+    span<T> values() noexcept { return span<T>(data(), size_); }
+    span<const T> values() const noexcept { return span<const T>(data(), size_); }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size_; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size_; }
+
+    size_type size() const noexcept { return size_; }
+    static constexpr size_type capacity() noexcept { return N; }
+    bool empty() const noexcept { return size_ == 0u; }
+
+private:
+    static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+    /** A free slot index, or kNone when full. */
+    std::uint32_t acquire() noexcept {
+        std::uint32_t index = kNone;
+        if (free_head_ != kNone) {
+            index = free_head_;
+            free_head_ = slots_[index].link;
+        } else if (next_unused_ < N) {
+            index = next_unused_;
+            slots_[index].generation = 0u;
+            ++next_unused_;
+        } else {
+            // Full: report to the caller instead of growing
+        }
+        return index;
+    }
+
+    /** Make the slot's handles stale; a slot whose generation wraps is retired. */
+    void release(std::uint32_t index) noexcept {
+        slot_entry_t &slot = slots_[index];
+        ++slot.generation;
+        if (slot.generation != 0u) {
+            slot.link = free_head_;
+            free_head_ = index;
+        }
+    }
+
+    using cell = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    std::array<cell, N> storage_;
+    std::array<slot_entry_t, N> slots_;
+    std::array<std::uint32_t, N> owners_;
+    size_type size_ = 0u;
+    std::uint32_t next_unused_ = 0u;
+    std::uint32_t free_head_ = kNone;
+};
+
+template <typename T, std::size_t N>
+constexpr std::uint32_t slot_map<T, N>::kNone;
+
+}  // namespace cs
+
+#endif  // SLOT_MAP_HPP
@@ -0,0 +1,205 @@
+/**
+ * @file soa_xy.hpp
+ * @brief C++14 structure-of-arrays container for {x, y} records with
+ * inline, fixed-capacity storage.
+ *
+ * Companion to relocate.hpp for CERT C++ OOP57-CPP code that moves point
+ * records around in bulk. An array of SimpleData {x, y} interleaves the
+ * two fields, so a pass that reads only x still loads every y. A
+ * cs::soa_xy<T, N> keeps x[] and y[] as separate cache-line-aligned
+ * arrays: each field is a dense span the compiler can vectorise, and
+ * records convert to and from AoS form in one pass.
+ *
+ *   cs::soa_xy<std::int32_t, 4096> pts;
+ *   pts.assign(records, count);   // any type with .x and .y members
+ *   auto box = pts.bounds();
+ *
+ * Like static_vector, nothing allocates: push_back() and assign() return
+ * false when the capacity would be exceeded, and x(i)/y(i) apply the
+ * bounds policy from bounds.hpp. Sums, and min/max of floating-point T,
+ * keep kLanes independent accumulators so they vectorise without
+ * -ffast-math; floating-point sums therefore round in a different order
+ * from a plain loop.
+ */
+
+#ifndef SOA_XY_HPP
+#define SOA_XY_HPP
+
+#include "bounds.hpp"
+#include "span.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace cs {
+
+template <typename T, std::size_t N, typename Policy = bounds::standard>
+class soa_xy {
+public:
+    static_assert(std::is_arithmetic<T>::value, "soa_xy holds arithmetic coordinates");
+    static_assert(N > 0u, "soa_xy needs a non-zero capacity");
+
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /** Sums widen integers to 64 bits so a full container cannot overflow. */
+    using sum_type = typename std::conditional<
+        std::is_floating_point<T>::value, T,
+        typename std::conditional<std::is_signed<T>::value, std::int64_t,
+                                  std::uint64_t>::type>::type;
+
+    struct sums {
+        sum_type x;
+        sum_type y;
+    };
+
+    struct box {
+        T min_x;
+        T min_y;
+        T max_x;
+        T max_y;
+    };
+
+    static constexpr size_type kLanes = 8u;
+
+    /** Append one record; false when full. */
+    bool push_back(T x, T y) noexcept {
+        bool pushed = false;
+        if (size_ < N) {
+            x_[size_] = x;
+            y_[size_] = y;
+            ++size_;
+            pushed = true;
+        }
+        return pushed;
+    }
+
+    /** Replace the contents with records[0..n) (AoS to SoA); false if n > N. */
+    template <typename Record>
+    bool assign(const Record *records, size_type n) noexcept {
+        bool fits = n <= N;
+        if (fits) {
+            for (size_type i = 0u; i < n; ++i) {
+                x_[i] = records[i].x;
+                y_[i] = records[i].y;
+            }
+            size_ = n;
+        }
+        return fits;
+    }
+
+    /** Write every record to out[0..size()) (SoA to AoS). */
+    template <typename Record>
+    void store(Record *out) const noexcept {
+        for (size_type i = 0u; i < size_; ++i) {
+            out[i].x = x_[i];
+            out[i].y = y_[i];
+        }
+    }
+
+    void clear() noexcept { size_ = 0u; }
+
+    T &x(size_type i) noexcept { return x_[Policy::index(i, size_)]; }
+    T &y(size_type i) noexcept { return y_[Policy::index(i, size_)]; }
+    T x(size_type i) const noexcept { return x_[Policy::index(i, size_)]; }
+    T y(size_type i) const noexcept { return y_[Policy::index(i, size_)]; }
+
+    span<T> xs() noexcept { return span<T>(x_.data(), size_); }
+    span<T> ys() noexcept { return span<T>(y_.data(), size_); }
+    span<const T> xs() const noexcept { return span<const T>(x_.data(), size_); }
+    span<const T> ys() const noexcept { return span<const T>(y_.data(), size_); }
+
+    size_type size() const noexcept { return size_; }
+    static constexpr size_type capacity() noexcept { return N; }
+    bool empty() const noexcept { return size_ == 0u; }
+
+    sums sum() const noexcept {
+        return sums{lane_sum(x_.data(), size_), lane_sum(y_.data(), size_)};
+    }
+
+    /** Bounding box; all zero when empty. */
+    box bounds() const noexcept {
+        box b{T{}, T{}, T{}, T{}};
+        if (size_ > 0u) {
+            lane_min_max(x_.data(), size_, b.min_x, b.max_x);
+            lane_min_max(y_.data(), size_, b.min_y, b.max_y);
+        }
+        return b;
+    }
+
+private:
+    static sum_type lane_sum(const T *v, size_type n) noexcept {
+        std::array<sum_type, kLanes> acc = {};
+        const size_type whole = n - (n % kLanes);
+        for (size_type i = 0u; i < whole; i += kLanes) {
+            for (size_type l = 0u; l < kLanes; ++l) {
+                acc[l] += static_cast<sum_type>(v[i + l]);
+            }
+        }
+        sum_type total = sum_type{};
+        for (size_type l = 0u; l < kLanes; ++l) {
+            total += acc[l];
+        }
+        for (size_type i = whole; i < n; ++i) {
+            total += static_cast<sum_type>(v[i]);
+        }
+        return total;
+    }
+
+    static void lane_min_max(const T *v, size_type n, T &lo, T &hi) noexcept {
+        min_max(v, n, lo, hi, std::is_integral<T>{});
+    }
+
+    /** Integer min/max is associative, so GCC vectorises the plain loop itself. */
+    static void min_max(const T *v, size_type n, T &lo, T &hi, std::true_type) noexcept {
+        T l = v[0];
+        T h = v[0];
+        for (size_type i = 1u; i < n; ++i) {
+            l = (v[i] < l) ? v[i] : l;
+            h = (v[i] > h) ? v[i] : h;
+        }
+        lo = l;
+        hi = h;
+    }
+
+    /** n > 0. Lanes start from v[0] so an empty lane never reports a bogus extreme. */
+    static void min_max(const T *v, size_type n, T &lo, T &hi, std::false_type) noexcept {
+        std::array<T, kLanes> lo_lane;
+        std::array<T, kLanes> hi_lane;
+        for (size_type l = 0u; l < kLanes; ++l) {
+            lo_lane[l] = v[0];
+            hi_lane[l] = v[0];
+        }
+        const size_type whole = n - (n % kLanes);
+        for (size_type i = 0u; i < whole; i += kLanes) {
+            for (size_type l = 0u; l < kLanes; ++l) {
+                const T e = v[i + l];
+                lo_lane[l] = (e < lo_lane[l]) ? e : lo_lane[l];
+                hi_lane[l] = (e > hi_lane[l]) ? e : hi_lane[l];
+            }
+        }
+        for (size_type i = whole; i < n; ++i) {
+            lo_lane[0] = (v[i] < lo_lane[0]) ? v[i] : lo_lane[0];
+            hi_lane[0] = (v[i] > hi_lane[0]) ? v[i] : hi_lane[0];
+        }
+        lo = lo_lane[0];
+        hi = hi_lane[0];
+        for (size_type l = 1u; l < kLanes; ++l) {
+            lo = (lo_lane[l] < lo) ? lo_lane[l] : lo;
+            hi = (hi_lane[l] > hi) ? hi_lane[l] : hi;
+        }
+    }
+
+    alignas(64) std::array<T, N> x_;
+    alignas(64) std::array<T, N> y_;
+    size_type size_ = 0u;
+};
+
+template <typename T, std::size_t N, typename Policy>
+constexpr std::size_t soa_xy<T, N, Policy>::kLanes;
+
+}  // namespace cs
+
+#endif  // SOA_XY_HPP
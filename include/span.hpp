@@ -0,0 +1,113 @@
+/**
+ * @file span.hpp
+ * @brief C++14 non-owning view of a contiguous sequence.
+ *
+ * Compliant alternative for AUTOSAR A8-4-7 when a function only reads a
+ * container: cs::span<const T> is two words, cheap to pass by value, and
+ * binds to std::vector, std::array, cs::checked_array, cs::static_vector
+ * and built-in arrays without copying them. Element access and slicing go
+ * through the bounds policy of bounds.hpp.
+ */
+
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include "bounds.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+
+namespace detail {
+
+/** Slicing checks follow BOUNDS_POLICY; only the unchecked build drops them. */
+inline void view_check(bool in_range) noexcept {
+#if BOUNDS_POLICY != BOUNDS_POLICY_UNCHECKED
+    if (!in_range) {
+        BOUNDS_TRAP();
+    }
+#else
+    static_cast<void>(in_range);
+#endif
+}
+
+/** Containers with data() and size() whose elements convert to T* (qualification only). */
+template <typename C, typename T, typename = void>
+struct is_span_source : std::false_type {};
+
+template <typename C, typename T>
+struct is_span_source<
+    C, T,
+    typename std::enable_if<std::is_convertible<
+        typename std::remove_pointer<decltype(std::declval<C &>().data())>::type (*)[],
+        T (*)[]>::value>::type>
+    : std::true_type {};
+
+}  // namespace detail
+
+template <typename T>
+class span {
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using size_type = std::size_t;
+    using iterator = T *;
+
+    constexpr span() noexcept = default;
+    constexpr span(T *data, size_type size) noexcept : data_(data), size_(size) {}
+
+    template <std::size_t N>
+    constexpr span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+    /** Any contiguous container: std::vector, std::array, cs::checked_array, ... */
+    template <typename C, typename = typename std::enable_if<detail::is_span_source<C, T>::value>::type>
+    constexpr span(C &container) noexcept : data_(container.data()), size_(container.size()) {}
+
+    /** span<T> converts to span<const T>. */
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+    constexpr span(const span<U> &other) noexcept : data_(other.data()), size_(other.size()) {}
+
+    constexpr T *data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+    constexpr bool empty() const noexcept { return size_ == 0u; }
+
+    T &operator[](size_type i) const noexcept { return data_[bounds::standard::index(i, size_)]; }
+    T &front() const noexcept { return (*this)[0u]; }
+    T &back() const noexcept { return (*this)[size_ - 1u]; }
+
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+    span first(size_type count) const noexcept {
+        detail::view_check(count <= size_);
+        return span(data_, count);
+    }
+
+    span last(size_type count) const noexcept {
+        detail::view_check(count <= size_);
+        return span(data_ + (size_ - count), count);
+    }
+
+    span subspan(size_type offset, size_type count) const noexcept {
+        detail::view_check((offset <= size_) && (count <= (size_ - offset)));
+        return span(data_ + offset, count);
+    }
+
+private:
+    T *data_ = nullptr;
+    size_type size_ = 0u;
+};
+
+/** Read-only view of a container, deducing the element type. */
+template <typename C>
+auto as_span(const C &container) noexcept
+    -> span<const typename std::remove_pointer<decltype(container.data())>::type> {
+    return {container.data(), container.size()};
+}
+
+}  // namespace cs
+
+#endif  // SPAN_HPP
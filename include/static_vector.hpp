@@ -0,0 +1,140 @@
+/**
+ * @file static_vector.hpp
+ * @brief C++14 vector with inline, fixed-capacity storage and a bounds
+ * policy on element access.
+ *
+ * Compliant alternative for CERT C++ CTR50-CPP (out-of-range container
+ * access) where the element count is bounded at compile time: no heap
+ * allocation, and operator[] checks against size() under the policy
+ * from bounds.hpp. Operations that would exceed the capacity report it
+ * (push_back returns false, emplace_back nullptr) instead of throwing.
+ */
+
+#ifndef STATIC_VECTOR_HPP
+#define STATIC_VECTOR_HPP
+
+#include "bounds.hpp"
+#include "relocate.hpp"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+
+template <typename T, std::size_t N, typename Policy = bounds::standard>
+class static_vector {
+public:
+    static_assert(N > 0u, "static_vector needs a non-zero capacity");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    static_vector() noexcept = default;
+
+    /** Elements beyond the capacity trap: the list length is a programming error. */
+    static_vector(std::initializer_list<T> init) {
+        if (init.size() > N) {
+            BOUNDS_TRAP();
+        }
+        for (const T &v : init) {
+            static_cast<void>(push_back(v));
+        }
+    }
+
+    static_vector(const static_vector &other) {
+        copy_construct_n(other.data(), other.size_, data());
+        size_ = other.size_;
+    }
+
+    static_vector(static_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        for (T &v : other) {
+            static_cast<void>(push_back(std::move(v)));
+        }
+        other.clear();
+    }
+
+    static_vector &operator=(const static_vector &other) {
+        if (this != &other) {
+            clear();
+            copy_construct_n(other.data(), other.size_, data());
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    static_vector &operator=(static_vector &&other) noexcept(
+        std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            clear();
+            for (T &v : other) {
+                static_cast<void>(push_back(std::move(v)));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~static_vector() { clear(); }
+
+    /** Construct an element in place; nullptr when full. */
+    template <typename... Args>
+    T *emplace_back(Args &&...args) {
+        T *result = nullptr;
+        if (size_ < N) {
+            result = ::new (static_cast<void *>(&storage_[size_])) T(std::forward<Args>(args)...);
+            ++size_;
+        }
+        return result;
+    }
+
+    bool push_back(const T &value) { return emplace_back(value) != nullptr; }
+    bool push_back(T &&value) { return emplace_back(std::move(value)) != nullptr; }
+
+    /** Remove the last element; false when empty. */
+    bool pop_back() noexcept {
+        bool removed = false;
+        if (size_ > 0u) {
+            --size_;
+            data()[size_].~T();
+            removed = true;
+        }
+        return removed;
+    }
+
+    void clear() noexcept {
+        while (pop_back()) {
+        }
+    }
+
+    T &operator[](size_type i) noexcept { return data()[Policy::index(i, size_)]; }
+    const T &operator[](size_type i) const noexcept { return data()[Policy::index(i, size_)]; }
+
+    T *data() noexcept { return reinterpret_cast<T *>(storage_.data()); }
+    const T *data() const noexcept { return reinterpret_cast<const T *>(storage_.data()); }
+
+    size_type size() const noexcept { return size_; }
+    static constexpr size_type capacity() noexcept { return N; }
+    bool empty() const noexcept { return size_ == 0u; }
+    bool full() const noexcept { return size_ == N; }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size_; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size_; }
+
+private:
+    using slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    std::array<slot, N> storage_;
+    size_type size_ = 0u;
+};
+
+}  // namespace cs
+
+#endif  // STATIC_VECTOR_HPP
@@ -0,0 +1,120 @@
+/**
+ * @file string_view.hpp
+ * @brief C++14 non-owning view of a character sequence, in the style of
+ * C++17 std::string_view.
+ *
+ * Compliant alternative for AUTOSAR A8-4-7 when a function only reads a
+ * string: it binds to std::string, string literals and (pointer, length)
+ * pairs without copying. Element access and substrings follow the bounds
+ * policy of bounds.hpp; like std::string_view, substr() and the find
+ * functions treat positions past the end as "no characters".
+ */
+
+#ifndef STRING_VIEW_HPP
+#define STRING_VIEW_HPP
+
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace cs {
+
+class string_view {
+public:
+    using size_type = std::size_t;
+    using iterator = const char *;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    constexpr string_view() noexcept = default;
+    constexpr string_view(const char *data, size_type size) noexcept : data_(data), size_(size) {}
+
+    /** From a NUL-terminated string; nullptr gives an empty view. */
+    string_view(const char *s) noexcept
+        : data_(s), size_((s != nullptr) ? std::char_traits<char>::length(s) : 0u) {}
+
+    string_view(const std::string &s) noexcept : data_(s.data()), size_(s.size()) {}
+
+    constexpr const char *data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr size_type length() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0u; }
+
+    const char &operator[](size_type i) const noexcept {
+        return data_[bounds::standard::index(i, size_)];
+    }
+
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+    /** Characters [pos, pos + count), clipped to the view. */
+    string_view substr(size_type pos, size_type count = npos) const noexcept {
+        size_type start = (pos < size_) ? pos : size_;
+        size_type n = ((size_ - start) < count) ? (size_ - start) : count;
+        return string_view(data_ + start, n);
+    }
+
+    void remove_prefix(size_type n) noexcept {
+        detail::view_check(n <= size_);
+        data_ += n;
+        size_ -= n;
+    }
+
+    void remove_suffix(size_type n) noexcept {
+        detail::view_check(n <= size_);
+        size_ -= n;
+    }
+
+    int compare(string_view other) const noexcept {
+        size_type n = (size_ < other.size_) ? size_ : other.size_;
+        int c = (n == 0u) ? 0 : std::memcmp(data_, other.data_, n);
+        if (c == 0) {
+            c = (size_ < other.size_) ? -1 : ((size_ > other.size_) ? 1 : 0);
+        }
+        return c;
+    }
+
+    bool starts_with(string_view prefix) const noexcept {
+        return (prefix.size_ <= size_) && (substr(0u, prefix.size_).compare(prefix) == 0);
+    }
+
+    bool ends_with(string_view suffix) const noexcept {
+        return (suffix.size_ <= size_) &&
+               (substr(size_ - suffix.size_).compare(suffix) == 0);
+    }
+
+    /** Position of the first `c` at or after `pos`, or npos. */
+    size_type find(char c, size_type pos = 0u) const noexcept {
+        size_type found = npos;
+        if (pos < size_) {
+            const void *p = std::memchr(data_ + pos, c, size_ - pos);
+            if (p != nullptr) {
+                found = static_cast<size_type>(static_cast<const char *>(p) - data_);
+            }
+        }
+        return found;
+    }
+
+    std::string to_string() const { return std::string(data_, size_); }
+
+    /** The characters as a span, e.g. for byte-wise processing. */
+    span<const char> chars() const noexcept { return span<const char>(data_, size_); }
+
+private:
+    const char *data_ = nullptr;
+    size_type size_ = 0u;
+};
+
+inline bool operator==(string_view a, string_view b) noexcept {
+    return (a.size() == b.size()) && (a.compare(b) == 0);
+}
+
+inline bool operator!=(string_view a, string_view b) noexcept { return !(a == b); }
+
+inline bool operator<(string_view a, string_view b) noexcept { return a.compare(b) < 0; }
+
+}  // namespace cs
+
+#endif  // STRING_VIEW_HPP
@@ -0,0 +1,223 @@
+/**
+ * @file units.hpp
+ * @brief C++14 durations with named scale factors and overflow-checked or
+ * saturating conversion between them.
+ *
+ * Compliant alternative for AUTOSAR A5-1-1 where a literal such as 3600
+ * stands for a unit conversion. A cs::units::duration<Rep, Scale> carries
+ * its unit in the type, the scale factors are named and derived from each
+ * other (hour = 60 minutes), and the factor between two units is the
+ * std::ratio quotient of their scales, reduced to lowest terms at compile
+ * time. Converting hours to seconds therefore names both units and never
+ * spells out the 3600.
+ *
+ * Unlike std::chrono::duration_cast, every conversion either cannot
+ * overflow or says what happens when it does:
+ *
+ *   cs::units::widen<To>(d)          compiles only if no value can overflow
+ *   cs::units::checked_cast<To>(d)   cs::expected<To, std::errc>
+ *   cs::units::try_cast<To>(d, out)  constexpr; false and `out` untouched
+ *   cs::units::saturate_cast<To>(d)  constexpr; clamps to To's range
+ *   cs::units::saturate_n<To, From>(in, out, n)
+ *                                    whole arrays of counts; returns how
+ *                                    many were clamped
+ *
+ * Down-scaling truncates toward zero, as duration_cast does. The integer
+ * part and the remainder are scaled separately, so no intermediate product
+ * overflows where the exact result would fit. Counts are signed integers.
+ */
+
+#ifndef UNITS_HPP
+#define UNITS_HPP
+
+#include "expected.hpp"
+#include "int_convert.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <system_error>
+#include <type_traits>
+
+namespace cs {
+namespace units {
+
+/** Scale factors, in seconds. */
+namespace scale {
+using nano = std::nano;
+using micro = std::micro;
+using milli = std::milli;
+using second = std::ratio<1>;
+using minute = std::ratio_multiply<second, std::ratio<60>>;
+using hour = std::ratio_multiply<minute, std::ratio<60>>;
+using day = std::ratio_multiply<hour, std::ratio<24>>;
+}  // namespace scale
+
+template <typename Rep, typename Scale>
+class duration {
+public:
+    static_assert(std::is_integral<Rep>::value && std::is_signed<Rep>::value,
+                  "durations count in a signed integer type");
+
+    using rep = Rep;
+    using scale = typename Scale::type;
+
+    constexpr duration() noexcept = default;
+    constexpr explicit duration(Rep count) noexcept : count_(count) {}
+
+    constexpr Rep count() const noexcept { return count_; }
+
+    static constexpr duration min() noexcept { return duration(std::numeric_limits<Rep>::min()); }
+    static constexpr duration max() noexcept { return duration(std::numeric_limits<Rep>::max()); }
+
+    constexpr bool operator==(duration other) const noexcept { return count_ == other.count_; }
+    constexpr bool operator!=(duration other) const noexcept { return count_ != other.count_; }
+    constexpr bool operator<(duration other) const noexcept { return count_ < other.count_; }
+    constexpr bool operator<=(duration other) const noexcept { return count_ <= other.count_; }
+    constexpr bool operator>(duration other) const noexcept { return count_ > other.count_; }
+    constexpr bool operator>=(duration other) const noexcept { return count_ >= other.count_; }
+
+private:
+    Rep count_ = 0;
+};
+
+using nanoseconds = duration<std::int64_t, scale::nano>;
+using microseconds = duration<std::int64_t, scale::micro>;
+using milliseconds = duration<std::int64_t, scale::milli>;
+using seconds = duration<std::int64_t, scale::second>;
+using minutes = duration<std::int64_t, scale::minute>;
+using hours = duration<std::int64_t, scale::hour>;
+using days = duration<std::int64_t, scale::day>;
+
+using seconds32 = duration<std::int32_t, scale::second>;
+using minutes32 = duration<std::int32_t, scale::minute>;
+using hours32 = duration<std::int32_t, scale::hour>;
+
+namespace detail {
+
+template <typename X>
+struct is_duration : std::false_type {};
+
+template <typename Rep, typename Scale>
+struct is_duration<duration<Rep, Scale>> : std::true_type {};
+
+/** Multiply by From's scale and divide by To's, as one reduced fraction. */
+template <typename From, typename To>
+struct factor {
+    static_assert(is_duration<From>::value && is_duration<To>::value,
+                  "unit conversions take cs::units::duration types");
+    using ratio = std::ratio_divide<typename From::scale, typename To::scale>;
+    static constexpr std::intmax_t num = ratio::num;
+    static constexpr std::intmax_t den = ratio::den;
+    static_assert(num <= (std::numeric_limits<std::intmax_t>::max() / den),
+                  "unit ratio too large to scale a remainder exactly");
+};
+
+/**
+ * v * num / den truncated toward zero, as (v / den) * num + (v % den) *
+ * num / den. The second term is below num in magnitude and has the sign
+ * of the first, so only the first product and the sum need checking.
+ * Saturates and sets `overflow` when the result does not fit To's rep.
+ */
+template <typename From, typename To>
+constexpr typename To::rep scale_count(typename From::rep v, bool &overflow) noexcept {
+    using f = factor<From, To>;
+    using to_rep = typename To::rep;
+    constexpr std::intmax_t kMax = std::numeric_limits<std::intmax_t>::max();
+    constexpr std::intmax_t kMin = std::numeric_limits<std::intmax_t>::min();
+    const std::intmax_t x = v;
+    const std::intmax_t q = x / f::den;
+    // |x % den| < den, so with num == 1 the remainder never contributes
+    const std::intmax_t tail = (f::num == 1) ? 0 : (((x % f::den) * f::num) / f::den);
+    bool over = (q > (kMax / f::num)) || (q < (kMin / f::num));
+    const std::intmax_t head = over ? 0 : (q * f::num);
+    over = over || ((tail > 0) ? (head > (kMax - tail)) : (head < (kMin - tail)));
+    const std::intmax_t y = over ? 0 : (head + tail);
+    over = over || !cs::in_range<to_rep>(y);
+    overflow = over;
+    return over ? ((x < 0) ? std::numeric_limits<to_rep>::min()
+                           : std::numeric_limits<to_rep>::max())
+                : static_cast<to_rep>(y);
+}
+
+template <typename From, typename To>
+constexpr bool scale_overflows(typename From::rep v) noexcept {
+    bool overflow = false;
+    static_cast<void>(scale_count<From, To>(v, overflow));
+    return overflow;
+}
+
+/** Scaling is monotonic, so the extremes of From decide every value. */
+template <typename From, typename To>
+constexpr bool always_fits() noexcept {
+    return !scale_overflows<From, To>(std::numeric_limits<typename From::rep>::min()) &&
+           !scale_overflows<From, To>(std::numeric_limits<typename From::rep>::max());
+}
+
+}  // namespace detail
+
+/** True if every From converts to To without overflow or truncation. */
+template <typename To, typename From>
+struct is_exact
+    : std::integral_constant<bool, (detail::factor<From, To>::den == 1) &&
+                                       detail::always_fits<From, To>()> {};
+
+/** Conversion that only compiles when it can never overflow or truncate. */
+template <typename To, typename From>
+constexpr To widen(From d) noexcept {
+    static_assert(is_exact<To, From>::value, "unit conversion may overflow or truncate");
+    bool overflow = false;
+    return To(detail::scale_count<From, To>(d.count(), overflow));
+}
+
+/** Store d in To's units in `out` and return true if it fits; otherwise leave `out`. */
+template <typename To, typename From>
+constexpr bool try_cast(From d, To &out) noexcept {
+    bool overflow = false;
+    const typename To::rep v = detail::scale_count<From, To>(d.count(), overflow);
+    if (!overflow) {
+        out = To(v);
+    }
+    return !overflow;
+}
+
+/** d in To's units, clamped to To::min() / To::max(). */
+template <typename To, typename From>
+constexpr To saturate_cast(From d) noexcept {
+    bool overflow = false;
+    return To(detail::scale_count<From, To>(d.count(), overflow));
+}
+
+/** d in To's units, or std::errc::value_too_large. */
+template <typename To, typename From>
+cs::expected<To, std::errc> checked_cast(From d) noexcept {
+    cs::expected<To, std::errc> result = cs::make_unexpected(std::errc::value_too_large);
+    To out;
+    if (try_cast(d, out)) {
+        result = out;
+    }
+    return result;
+}
+
+/**
+ * Convert n counts of From to counts of To: out[i] = saturate_cast(in[i]).
+ * Returns how many were clamped (0 means the whole batch converted), so
+ * callers test once per batch. The loop has no branches or early exit.
+ */
+template <typename To, typename From>
+std::size_t saturate_n(const typename From::rep *in, typename To::rep *out,
+                       std::size_t n) noexcept {
+    std::size_t clamped = 0u;
+    for (std::size_t i = 0u; i < n; ++i) {
+        bool overflow = false;
+        out[i] = detail::scale_count<From, To>(in[i], overflow);
+        clamped += overflow ? 1u : 0u;
+    }
+    return clamped;
+}
+
+}  // namespace units
+}  // namespace cs
+
+#endif  // UNITS_HPP
@@ -0,0 +1,76 @@
+/**
+ * @file vm_region.h
+ * @brief Reserve-then-commit virtual memory regions over mmap (C11 API).
+ *
+ * Backing store for very large arrays (CERT C++ MEM52-CPP). A region
+ * reserves address space for its maximum size up front, with no access
+ * and no commit charge, then commits a growing prefix in chunks as the
+ * array grows. Every step reports failure as an errno value, and a commit
+ * that the kernel refuses (strict overcommit, RLIMIT_AS, a full address
+ * space) fails there, not as a SIGSEGV on first use.
+ *
+ * Committed memory is still only backed by physical pages on first touch;
+ * VM_POPULATE pre-faults each committed chunk instead, and VM_HUGE_PAGES
+ * aligns the region to 2 MiB and asks for transparent huge pages with
+ * madvise(MADV_HUGEPAGE). Both are hints: they are skipped where the
+ * kernel does not support them.
+ */
+
+#ifndef VM_REGION_H
+#define VM_REGION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VM_HUGE_PAGES 0x1u /* Align to VM_HUGE_PAGE_SIZE and madvise(MADV_HUGEPAGE) */
+#define VM_POPULATE 0x2u   /* Pre-fault committed chunks */
+
+#define VM_HUGE_PAGE_SIZE ((size_t)2u * 1024u * 1024u)
+#define VM_DEFAULT_CHUNK ((size_t)64u * 1024u * 1024u)
+
+typedef struct vm_region {
+    unsigned char *base; /* First usable byte; NULL when nothing is reserved */
+    size_t reserved;     /* Bytes of address space from base */
+    size_t committed;    /* Bytes from base that are readable and writable */
+    size_t chunk;        /* Commit granularity */
+    unsigned char *map;  /* What mmap returned, before any alignment */
+    size_t map_size;
+    uint32_t flags;
+} vm_region_t;
+
+/**
+ * Reserve `bytes` of address space, committing nothing. `chunk` (rounded
+ * up to the page size; 0 means VM_DEFAULT_CHUNK) is the step commit grows
+ * by. Returns 0, EINVAL for a zero size, or the errno from mmap.
+ */
+int vm_reserve(vm_region_t *region, size_t bytes, size_t chunk, uint32_t flags);
+
+/**
+ * Make at least [0, bytes) readable and writable, growing the committed
+ * prefix in whole chunks (capped at the reservation). Memory committed
+ * earlier keeps its contents; new memory reads as zero. Returns 0,
+ * ERANGE if bytes exceeds the reservation, or the errno from mprotect.
+ */
+int vm_commit(vm_region_t *region, size_t bytes);
+
+/**
+ * Shrink the committed prefix to `bytes` rounded up to a chunk, returning
+ * the pages beyond it and their commit charge to the kernel; they read as
+ * zero if committed again.
+ */
+int vm_decommit(vm_region_t *region, size_t bytes);
+
+/** Unmap the whole region; safe on a region that reserved nothing. */
+void vm_release(vm_region_t *region);
+
+size_t vm_page_size(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VM_REGION_H */
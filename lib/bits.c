@@ -0,0 +1,244 @@
+/**
+ * @file bits.c
+ * @brief Buffer kernels for bits.h and their run-time dispatch.
+ *
+ * The checksum kernels return the plain 64-bit sum of the buffer read as
+ * native-order 32-bit words; bits_inet_checksum() folds that to 16 bits.
+ * RFC 1071's sum is independent of byte order up to a final swap, so a
+ * little-endian host sums without swapping and swaps the folded result
+ * once. The AVX2 kernels use unaligned loads and hand the last partial
+ * block to the scalar kernel; every block they hand over starts at an
+ * offset that is a multiple of 32, so the 16-bit word boundaries agree.
+ */
+
+#include "bits.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BITS_HAVE_X86 1
+#else
+#define BITS_HAVE_X86 0
+#endif
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define BITS_BIG_ENDIAN 1
+#else
+#define BITS_BIG_ENDIAN 0
+#endif
+
+typedef struct bits_kernels {
+    const char *name;
+    uint64_t (*popcount)(const uint8_t *buf, size_t n);
+    void (*bswap16)(uint16_t *v, size_t n);
+    void (*bswap32)(uint32_t *v, size_t n);
+    uint64_t (*sum)(const uint8_t *buf, size_t n);
+} bits_kernels_t;
+
+/* ---- Scalar ------------------------------------------------------------ */
+
+static uint64_t popcount_scalar(const uint8_t *buf, size_t n) {
+    uint64_t total = 0u;
+    size_t i = 0u;
+    for (; (i + 8u) <= n; i += 8u) {
+        uint64_t w;
+        (void)memcpy(&w, buf + i, sizeof(w));
+        total += bits_popcount_u64(w);
+    }
+    for (; i < n; i++) {
+        total += bits_popcount_u8(buf[i]);
+    }
+    return total;
+}
+
+static void bswap16_scalar(uint16_t *v, size_t n) {
+    for (size_t i = 0u; i < n; i++) {
+        v[i] = __builtin_bswap16(v[i]);
+    }
+}
+
+static void bswap32_scalar(uint32_t *v, size_t n) {
+    for (size_t i = 0u; i < n; i++) {
+        v[i] = __builtin_bswap32(v[i]);
+    }
+}
+
+static uint64_t sum_scalar(const uint8_t *buf, size_t n) {
+    uint64_t sum = 0u;
+    size_t i = 0u;
+    for (; (i + 4u) <= n; i += 4u) {
+        uint32_t w;
+        (void)memcpy(&w, buf + i, sizeof(w));
+        sum += w;
+    }
+    if ((i + 2u) <= n) {
+        uint16_t w;
+        (void)memcpy(&w, buf + i, sizeof(w));
+        sum += w;
+        i += 2u;
+    }
+    if (i < n) {
+        /* Odd trailing byte: the high half of a zero-padded big-endian word */
+        sum += BITS_BIG_ENDIAN ? ((uint64_t)buf[i] << 8u) : (uint64_t)buf[i];
+    }
+    return sum;
+}
+
+static const bits_kernels_t bits_scalar = {"scalar", popcount_scalar, bswap16_scalar,
+                                           bswap32_scalar, sum_scalar};
+
+/* ---- AVX2 -------------------------------------------------------------- */
+
+#if BITS_HAVE_X86
+/* Per-byte popcount through a 16-entry nibble table, summed with SAD */
+__attribute__((target("avx2,popcnt")))
+static uint64_t popcount_avx2(const uint8_t *buf, size_t n) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+                                           1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0u;
+    for (; (i + 32u) <= n; i += 32u) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(buf + i));
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+        __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        __m256i counts = _mm256_add_epi8(lo, hi);
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)(void *)lanes, acc);
+    uint64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; (i + 8u) <= n; i += 8u) {
+        uint64_t w;
+        (void)memcpy(&w, buf + i, sizeof(w));
+        total += (uint64_t)_mm_popcnt_u64(w);
+    }
+    for (; i < n; i++) {
+        total += bits_popcount_u8(buf[i]);
+    }
+    return total;
+}
+
+__attribute__((target("avx2")))
+static void bswap16_avx2(uint16_t *v, size_t n) {
+    const __m256i order = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                           1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    size_t i = 0u;
+    for (; (i + 16u) <= n; i += 16u) {
+        __m256i *p = (__m256i *)(void *)(v + i);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), order));
+    }
+    bswap16_scalar(v + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void bswap32_avx2(uint32_t *v, size_t n) {
+    const __m256i order = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    size_t i = 0u;
+    for (; (i + 8u) <= n; i += 8u) {
+        __m256i *p = (__m256i *)(void *)(v + i);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), order));
+    }
+    bswap32_scalar(v + i, n - i);
+}
+
+/* 32-bit words widened into 64-bit lanes: no lane can overflow before 16 GiB */
+__attribute__((target("avx2")))
+static uint64_t sum_avx2(const uint8_t *buf, size_t n) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    size_t i = 0u;
+    for (; (i + 32u) <= n; i += 32u) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(buf + i));
+        acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(v, zero));
+        acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(v, zero));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)(void *)lanes, acc);
+    uint64_t sum = 0u;
+    for (size_t l = 0u; l < 4u; l++) {
+        /* Fold to 33 bits first so four lanes cannot overflow the total */
+        sum += (lanes[l] & 0xFFFFFFFFu) + (lanes[l] >> 32u);
+    }
+    return sum + sum_scalar(buf + i, n - i);
+}
+
+static const bits_kernels_t bits_avx2 = {"avx2", popcount_avx2, bswap16_avx2, bswap32_avx2,
+                                         sum_avx2};
+#endif
+
+/* ---- Dispatch ---------------------------------------------------------- */
+
+static const bits_kernels_t *impl_kernels(bits_impl_t impl) {
+    const bits_kernels_t *k = NULL;
+    switch (impl) {
+    case BITS_IMPL_AUTO:
+#if BITS_HAVE_X86
+        k = (__builtin_cpu_supports("avx2") != 0) ? &bits_avx2 : &bits_scalar;
+#else
+        k = &bits_scalar;
+#endif
+        break;
+    case BITS_IMPL_SCALAR:
+        k = &bits_scalar;
+        break;
+#if BITS_HAVE_X86
+    case BITS_IMPL_AVX2:
+        k = (__builtin_cpu_supports("avx2") != 0) ? &bits_avx2 : NULL;
+        break;
+#endif
+    default:
+        k = NULL;
+        break;
+    }
+    return k;
+}
+
+/* Resolved on first use; concurrent first calls store the same value. */
+static _Atomic(const bits_kernels_t *) bits_current = NULL;
+
+static const bits_kernels_t *current_kernels(void) {
+    const bits_kernels_t *k = atomic_load_explicit(&bits_current, memory_order_relaxed);
+    if (k == NULL) {
+        k = impl_kernels(BITS_IMPL_AUTO);
+        atomic_store_explicit(&bits_current, k, memory_order_relaxed);
+    }
+    return k;
+}
+
+uint64_t bits_popcount_buf(const uint8_t *buf, size_t n) {
+    return current_kernels()->popcount(buf, n);
+}
+
+void bits_bswap16_buf(uint16_t *v, size_t n) {
+    current_kernels()->bswap16(v, n);
+}
+
+void bits_bswap32_buf(uint32_t *v, size_t n) {
+    current_kernels()->bswap32(v, n);
+}
+
+uint16_t bits_inet_checksum(const uint8_t *buf, size_t n) {
+    uint64_t sum = current_kernels()->sum(buf, n);
+    while ((sum >> 16u) != 0u) {
+        sum = (sum & 0xFFFFu) + (sum >> 16u);
+    }
+    uint16_t folded = (uint16_t)~(uint32_t)sum;
+    return BITS_BIG_ENDIAN ? folded : __builtin_bswap16(folded);
+}
+
+bool bits_select_impl(bits_impl_t impl) {
+    const bits_kernels_t *k = impl_kernels(impl);
+    bool ok = k != NULL;
+    if (ok) {
+        atomic_store_explicit(&bits_current, k, memory_order_relaxed);
+    }
+    return ok;
+}
+
+const char *bits_impl_name(void) {
+    return current_kernels()->name;
+}
@@ -0,0 +1,228 @@
+/**
+ * @file bstr.c
+ * @brief Bounded string routines and their run-time dispatched scan kernels.
+ *
+ * The SIMD kernels only issue aligned vector loads. An aligned block never
+ * straddles a page, and every block they touch contains at least one byte
+ * the caller guarantees is readable, so reading the rest of the block
+ * cannot fault (the same argument glibc's strlen relies on).
+ */
+
+#include "bstr.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BSTR_HAVE_X86 1
+#else
+#define BSTR_HAVE_X86 0
+#endif
+
+typedef size_t (*bstr_nlen_fn)(const char *s, size_t max);
+
+static size_t nlen_scalar(const char *s, size_t max) {
+    size_t n = 0u;
+    while ((n < max) && (s[n] != '\0')) {
+        n++;
+    }
+    return n;
+}
+
+#if BSTR_HAVE_X86
+static inline size_t clamp_hit(size_t index, size_t max) {
+    return (index < max) ? index : max;
+}
+
+__attribute__((target("sse2")))
+static size_t nlen_sse2(const char *s, size_t max) {
+    size_t result = max;
+    if (max > 0u) {
+        const __m128i zero = _mm_setzero_si128();
+        uintptr_t addr = (uintptr_t)s;
+        unsigned shift = (unsigned)(addr & 15u);
+        const __m128i *block = (const __m128i *)(addr - shift);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(block), zero));
+        mask >>= shift;
+        if (mask != 0u) {
+            result = clamp_hit((size_t)__builtin_ctz(mask), max);
+        } else {
+            size_t scanned = 16u - shift;
+            while (scanned < max) {
+                block++;
+                mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(block), zero));
+                if (mask != 0u) {
+                    result = clamp_hit(scanned + (size_t)__builtin_ctz(mask), max);
+                    break;
+                }
+                scanned += 16u;
+            }
+        }
+    }
+    return result;
+}
+
+__attribute__((target("avx2")))
+static size_t nlen_avx2(const char *s, size_t max) {
+    size_t result = max;
+    if (max > 0u) {
+        const __m256i zero = _mm256_setzero_si256();
+        uintptr_t addr = (uintptr_t)s;
+        unsigned shift = (unsigned)(addr & 31u);
+        const __m256i *block = (const __m256i *)(addr - shift);
+        unsigned mask =
+            (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(block), zero));
+        mask >>= shift;
+        if (mask != 0u) {
+            result = clamp_hit((size_t)__builtin_ctz(mask), max);
+        } else {
+            size_t scanned = 32u - shift;
+            bool found = false;
+            /* Single blocks until 128-byte aligned, then four at a time; a
+             * 128-byte aligned group cannot straddle a page either. */
+            while (!found && (scanned < max)) {
+                block++;
+                if ((((uintptr_t)block & 127u) == 0u) && ((max - scanned) > 128u)) {
+                    __m256i m = _mm256_min_epu8(
+                        _mm256_min_epu8(_mm256_load_si256(block), _mm256_load_si256(block + 1)),
+                        _mm256_min_epu8(_mm256_load_si256(block + 2), _mm256_load_si256(block + 3)));
+                    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(m, zero)) == 0) {
+                        block += 3;
+                        scanned += 128u;
+                        continue;
+                    }
+                }
+                mask = (unsigned)_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(_mm256_load_si256(block), zero));
+                if (mask != 0u) {
+                    result = clamp_hit(scanned + (size_t)__builtin_ctz(mask), max);
+                    found = true;
+                } else {
+                    scanned += 32u;
+                }
+            }
+        }
+    }
+    return result;
+}
+#endif
+
+static bool impl_supported(bstr_impl_t impl) {
+    bool supported = false;
+    switch (impl) {
+    case BSTR_IMPL_AUTO:
+    case BSTR_IMPL_SCALAR:
+        supported = true;
+        break;
+#if BSTR_HAVE_X86
+    case BSTR_IMPL_SSE2:
+        supported = (__builtin_cpu_supports("sse2") != 0);
+        break;
+    case BSTR_IMPL_AVX2:
+        supported = (__builtin_cpu_supports("avx2") != 0);
+        break;
+#endif
+    default:
+        supported = false;
+        break;
+    }
+    return supported;
+}
+
+static bstr_nlen_fn impl_fn(bstr_impl_t impl) {
+    bstr_nlen_fn fn = nlen_scalar;
+#if BSTR_HAVE_X86
+    if (impl == BSTR_IMPL_AUTO) {
+        impl = impl_supported(BSTR_IMPL_AVX2)   ? BSTR_IMPL_AVX2
+               : impl_supported(BSTR_IMPL_SSE2) ? BSTR_IMPL_SSE2
+                                                : BSTR_IMPL_SCALAR;
+    }
+    if (impl == BSTR_IMPL_AVX2) {
+        fn = nlen_avx2;
+    } else if (impl == BSTR_IMPL_SSE2) {
+        fn = nlen_sse2;
+    } else {
+        fn = nlen_scalar;
+    }
+#else
+    (void)impl;
+#endif
+    return fn;
+}
+
+/* Resolved on first use; concurrent first calls store the same value. */
+static _Atomic(bstr_nlen_fn) bstr_nlen_impl = NULL;
+
+static bstr_nlen_fn current_impl(void) {
+    bstr_nlen_fn fn = atomic_load_explicit(&bstr_nlen_impl, memory_order_relaxed);
+    if (fn == NULL) {
+        fn = impl_fn(BSTR_IMPL_AUTO);
+        atomic_store_explicit(&bstr_nlen_impl, fn, memory_order_relaxed);
+    }
+    return fn;
+}
+
+size_t bstr_nlen(const char *s, size_t max) {
+    return current_impl()(s, max);
+}
+
+bstr_status_t bstr_copy(char *dst, size_t dst_size, const char *src, size_t *out_len) {
+    bstr_status_t status = BSTR_INVALID;
+    if ((dst != NULL) && (src != NULL) && (dst_size > 0u)) {
+        size_t len = bstr_nlen(src, dst_size);
+        if (len < dst_size) {
+            status = BSTR_OK;
+        } else {
+            len = dst_size - 1u;
+            status = BSTR_TRUNCATED;
+        }
+        (void)memmove(dst, src, len);
+        dst[len] = '\0';
+        if (out_len != NULL) {
+            *out_len = len;
+        }
+    }
+    return status;
+}
+
+bstr_status_t bstr_cat(char *dst, size_t dst_size, const char *src, size_t *out_len) {
+    bstr_status_t status = BSTR_INVALID;
+    if ((dst != NULL) && (src != NULL) && (dst_size > 0u)) {
+        size_t cur = bstr_nlen(dst, dst_size);
+        if (cur < dst_size) {
+            size_t appended = 0u;
+            status = bstr_copy(dst + cur, dst_size - cur, src, &appended);
+            if (out_len != NULL) {
+                *out_len = cur + appended;
+            }
+        }
+    }
+    return status;
+}
+
+bool bstr_select_impl(bstr_impl_t impl) {
+    bool ok = impl_supported(impl);
+    if (ok) {
+        atomic_store_explicit(&bstr_nlen_impl, impl_fn(impl), memory_order_relaxed);
+    }
+    return ok;
+}
+
+const char *bstr_impl_name(void) {
+    bstr_nlen_fn fn = current_impl();
+    const char *name = "scalar";
+#if BSTR_HAVE_X86
+    if (fn == nlen_avx2) {
+        name = "avx2";
+    } else if (fn == nlen_sse2) {
+        name = "sse2";
+    } else {
+        name = "scalar";
+    }
+#else
+    (void)fn;
+#endif
+    return name;
+}
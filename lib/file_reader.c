@@ -0,0 +1,185 @@
+/**
+ * @file file_reader.c
+ * @brief Read-only file access by mmap or large-buffer streaming.
+ *
+ * A mapped reader is treated as a stream whose buffer is the whole file
+ * and whose read(2) has already hit end of file, so both modes share the
+ * block and line code.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "file_reader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static void reset(file_reader_t *r) {
+    r->fd = -1;
+    r->mapped = false;
+    r->eof = false;
+    r->data = NULL;
+    r->capacity = 0u;
+    r->pos = 0u;
+    r->end = 0u;
+    r->size = 0u;
+}
+
+static int map_file(file_reader_t *r) {
+    int err = 0;
+    if (r->size > (uint64_t)SIZE_MAX) {
+        err = EFBIG;
+    } else if (r->size > 0u) {
+        void *p = mmap(NULL, (size_t)r->size, PROT_READ, MAP_PRIVATE, r->fd, 0);
+        if (p == MAP_FAILED) {
+            err = errno;
+        } else {
+            (void)madvise(p, (size_t)r->size, MADV_SEQUENTIAL); /* Hint only */
+            r->data = (unsigned char *)p;
+        }
+    } else {
+        /* An empty file maps to nothing */
+    }
+    if (err == 0) {
+        r->mapped = true;
+        r->eof = true;
+        r->capacity = (size_t)r->size;
+        r->end = r->capacity;
+    }
+    return err;
+}
+
+static int alloc_buffer(file_reader_t *r, size_t buffer_size) {
+    const long sys_page = sysconf(_SC_PAGESIZE);
+    const size_t page = (sys_page > 0) ? (size_t)sys_page : (size_t)4096u;
+    size_t want = (buffer_size == 0u) ? FILE_READER_DEFAULT_BUFFER : buffer_size;
+    int err = 0;
+    void *p = NULL;
+    if (want > (SIZE_MAX - page)) {
+        err = ENOMEM;
+    } else {
+        want = ((want + page - 1u) / page) * page;
+        err = posix_memalign(&p, page, want);
+    }
+    if (err == 0) {
+        (void)posix_fadvise(r->fd, 0, 0, POSIX_FADV_SEQUENTIAL); /* Hint only */
+        r->data = (unsigned char *)p;
+        r->capacity = want;
+    }
+    return err;
+}
+
+/* Move the undelivered bytes to the front and read until the buffer is full or EOF */
+static int fill(file_reader_t *r) {
+    int err = 0;
+    if (r->pos > 0u) {
+        (void)memmove(r->data, r->data + r->pos, r->end - r->pos);
+        r->end -= r->pos;
+        r->pos = 0u;
+    }
+    while ((err == 0) && !r->eof && (r->end < r->capacity)) {
+        const ssize_t n = read(r->fd, r->data + r->end, r->capacity - r->end);
+        if (n > 0) {
+            r->end += (size_t)n;
+        } else if (n == 0) {
+            r->eof = true;
+        } else if (errno != EINTR) {
+            err = errno;
+        } else {
+            /* Interrupted before reading anything: retry */
+        }
+    }
+    return err;
+}
+
+int file_reader_open(file_reader_t *r, const char *path, file_reader_mode_t mode,
+                     size_t buffer_size) {
+    int err = 0;
+    struct stat st;
+    reset(r);
+    r->fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (r->fd < 0) {
+        err = errno;
+    } else if (fstat(r->fd, &st) != 0) {
+        err = errno;
+    } else {
+        const bool regular = S_ISREG(st.st_mode);
+        r->size = regular ? (uint64_t)st.st_size : 0u;
+        if (mode == FILE_READER_MAP) {
+            err = regular ? map_file(r) : ENODEV;
+        } else if ((mode == FILE_READER_AUTO) && regular && (r->size > 0u) &&
+                   (map_file(r) == 0)) {
+            /* Mapped */
+        } else {
+            err = alloc_buffer(r, buffer_size);
+        }
+    }
+    if (err != 0) {
+        (void)file_reader_close(r);
+    }
+    return err;
+}
+
+int file_reader_next(file_reader_t *r, const unsigned char **data, size_t *len) {
+    int err = 0;
+    if (r->pos == r->end) {
+        err = fill(r);
+    }
+    *len = (err == 0) ? (r->end - r->pos) : 0u;
+    *data = (*len > 0u) ? (r->data + r->pos) : NULL;
+    r->pos += *len;
+    return err;
+}
+
+int file_reader_next_line(file_reader_t *r, const char **line, size_t *len) {
+    int err = 0;
+    bool done = false;
+    *line = NULL;
+    *len = 0u;
+    while (!done) {
+        const bool pending = r->pos < r->end;
+        const char *start = pending ? ((const char *)r->data + r->pos) : NULL;
+        const char *nl = pending ? memchr(start, '\n', r->end - r->pos) : NULL;
+        if (nl != NULL) {
+            *line = start;
+            *len = (size_t)(nl - start);
+            r->pos += *len + 1u;
+            done = true;
+        } else if (r->eof) {
+            if (pending) {
+                *line = start;
+                *len = r->end - r->pos;
+                r->pos = r->end;
+            }
+            done = true;
+        } else if ((r->pos == 0u) && (r->end == r->capacity)) {
+            err = ENOBUFS;
+            done = true;
+        } else {
+            err = fill(r);
+            done = (err != 0);
+        }
+    }
+    return err;
+}
+
+int file_reader_close(file_reader_t *r) {
+    int err = 0;
+    if (r->mapped) {
+        if (r->data != NULL) {
+            (void)munmap(r->data, r->capacity);
+        }
+    } else {
+        free(r->data);
+    }
+    if ((r->fd >= 0) && (close(r->fd) != 0)) {
+        err = errno;
+    }
+    reset(r);
+    return err;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file fmt.c
+ * @brief Locale-free integer/float conversion and bounded text buffers.
+ *
+ * Decimal integers are written two digits at a time from a 200-byte
+ * table after counting the digits, so each character is stored once, in
+ * place. Floats are split into an exact integer part and a fraction
+ * scaled by 10^precision, and both go through the same path.
+ */
+
+#include "fmt.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char fmt_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* Exactly representable powers of ten */
+static const double fmt_pow10[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static const uint64_t fmt_pow10_u64[20] = {1u,
+                                           10u,
+                                           100u,
+                                           1000u,
+                                           10000u,
+                                           100000u,
+                                           1000000u,
+                                           10000000u,
+                                           100000000u,
+                                           1000000000u,
+                                           10000000000u,
+                                           100000000000u,
+                                           1000000000000u,
+                                           10000000000000u,
+                                           100000000000000u,
+                                           1000000000000000u,
+                                           10000000000000000u,
+                                           100000000000000000u,
+                                           1000000000000000000u,
+                                           10000000000000000000u};
+
+/* 2^64: below it the integer part of a double fits a uint64_t */
+#define FMT_FIXED_LIMIT 18446744073709551616.0
+
+static size_t count_digits(uint64_t v) {
+    size_t n = 1u;
+    while ((n < 20u) && (v >= fmt_pow10_u64[n])) {
+        n++;
+    }
+    return n;
+}
+
+/* Write exactly `width` digits of v (zero-padded) ending at out + width */
+static void put_digits(char *out, uint64_t v, size_t width) {
+    char *p = out + width;
+    while (v >= 100u) {
+        size_t pair = (size_t)(v % 100u) * 2u;
+        v /= 100u;
+        p -= 2;
+        p[0] = fmt_digit_pairs[pair];
+        p[1] = fmt_digit_pairs[pair + 1u];
+    }
+    if (v >= 10u) {
+        size_t pair = (size_t)v * 2u;
+        p -= 2;
+        p[0] = fmt_digit_pairs[pair];
+        p[1] = fmt_digit_pairs[pair + 1u];
+    } else {
+        p -= 1;
+        p[0] = (char)('0' + (char)v);
+    }
+    while (p > out) {
+        p -= 1;
+        p[0] = '0';
+    }
+}
+
+size_t fmt_u64(char *out, uint64_t v) {
+    size_t n = count_digits(v);
+    put_digits(out, v, n);
+    return n;
+}
+
+size_t fmt_i64(char *out, int64_t v) {
+    size_t n = 0u;
+    uint64_t magnitude = (uint64_t)v;
+    if (v < 0) {
+        out[0] = '-';
+        magnitude = 0u - magnitude;
+        n = 1u;
+    }
+    return n + fmt_u64(out + n, magnitude);
+}
+
+size_t fmt_hex64(char *out, uint64_t v, bool upper) {
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    size_t n = 1u;
+    while ((n < 16u) && ((v >> (4u * n)) != 0u)) {
+        n++;
+    }
+    for (size_t i = 0u; i < n; ++i) {
+        out[n - 1u - i] = digits[(v >> (4u * i)) & 0xFu];
+    }
+    return n;
+}
+
+size_t fmt_bin64(char *out, uint64_t v) {
+    size_t n = 1u;
+    while ((n < 64u) && ((v >> n) != 0u)) {
+        n++;
+    }
+    for (size_t i = 0u; i < n; ++i) {
+        out[n - 1u - i] = (char)('0' + (char)((v >> i) & 1u));
+    }
+    return n;
+}
+
+/* x rounded to the nearest integer, ties to even; x < 2^63 */
+static uint64_t round_even(double x) {
+    uint64_t r = (uint64_t)x;
+    double frac = x - (double)r;
+    if ((frac > 0.5) || ((frac == 0.5) && ((r & 1u) != 0u))) {
+        r++;
+    }
+    return r;
+}
+
+/* "int.frac", frac being the `prec` digits after the point */
+static size_t put_fixed(char *out, uint64_t ip, uint64_t frac, uint32_t prec) {
+    size_t n = fmt_u64(out, ip);
+    if (prec > 0u) {
+        out[n] = '.';
+        put_digits(out + n + 1u, frac, prec);
+        n += 1u + prec;
+    }
+    return n;
+}
+
+static size_t put_exponent(char *out, double v, uint32_t prec) {
+    int32_t e = 0;
+    double m = v;
+    while (m >= 1e22) {
+        m /= 1e22;
+        e += 22;
+    }
+    int32_t k = 22;
+    while (k > 0) {
+        if (m >= fmt_pow10[k]) {
+            m /= fmt_pow10[k];
+            e += k;
+        }
+        k /= 2;
+    }
+    while (m >= 10.0) {
+        m /= 10.0;
+        e += 1;
+    }
+    uint64_t r = round_even(m * fmt_pow10[prec]);
+    if (r >= 10u * fmt_pow10_u64[prec]) {
+        r /= 10u;
+        e += 1;
+    }
+    size_t n = put_fixed(out, r / fmt_pow10_u64[prec], r % fmt_pow10_u64[prec], prec);
+    out[n] = 'e';
+    out[n + 1u] = '+';
+    n += 2u;
+    if (e < 10) {
+        out[n] = '0';
+        n += 1u;
+    }
+    return n + fmt_u64(out + n, (uint64_t)e);
+}
+
+size_t fmt_f64(char *out, double v, uint32_t precision) {
+    size_t n = 0u;
+    uint32_t prec = (precision > FMT_F64_PREC_MAX) ? FMT_F64_PREC_MAX : precision;
+    if (v != v) {
+        memcpy(out, "nan", 3u);
+        n = 3u;
+    } else {
+        double a = v;
+        if ((v < 0.0) || ((v == 0.0) && (1.0 / v < 0.0))) {
+            out[0] = '-';
+            a = -v;
+            n = 1u;
+        }
+        if (a > 1.7976931348623157e308) {
+            memcpy(out + n, "inf", 3u);
+            n += 3u;
+        } else if (a < FMT_FIXED_LIMIT) {
+            /* Taking off the integer part is exact, and frac * 10^15 < 2^53 */
+            uint64_t ip = (uint64_t)a;
+            uint64_t frac = round_even((a - (double)ip) * fmt_pow10[prec]);
+            if (frac >= fmt_pow10_u64[prec]) {
+                frac -= fmt_pow10_u64[prec];
+                ip++;
+            }
+            n += put_fixed(out + n, ip, frac, prec);
+        } else {
+            n += put_exponent(out + n, a, prec);
+        }
+    }
+    return n;
+}
+
+void fmt_buf_init(fmt_buf_t *b, char *data, size_t cap) {
+    b->data = data;
+    b->cap = cap;
+    b->len = 0u;
+}
+
+void fmt_put(fmt_buf_t *b, const char *s, size_t n) {
+    if ((b->cap > 0u) && (b->len < (b->cap - 1u))) {
+        size_t room = (b->cap - 1u) - b->len;
+        memcpy(b->data + b->len, s, (n < room) ? n : room);
+    }
+    b->len += n;
+}
+
+void fmt_put_str(fmt_buf_t *b, const char *s) {
+    fmt_put(b, s, strlen(s));
+}
+
+void fmt_put_char(fmt_buf_t *b, char c) {
+    fmt_put(b, &c, 1u);
+}
+
+void fmt_put_u64(fmt_buf_t *b, uint64_t v) {
+    char tmp[FMT_U64_MAX];
+    fmt_put(b, tmp, fmt_u64(tmp, v));
+}
+
+void fmt_put_i64(fmt_buf_t *b, int64_t v) {
+    char tmp[FMT_I64_MAX];
+    fmt_put(b, tmp, fmt_i64(tmp, v));
+}
+
+void fmt_put_f64(fmt_buf_t *b, double v, uint32_t precision) {
+    char tmp[FMT_F64_MAX];
+    fmt_put(b, tmp, fmt_f64(tmp, v, precision));
+}
+
+size_t fmt_buf_finish(fmt_buf_t *b) {
+    if (b->cap > 0u) {
+        b->data[fmt_buf_stored(b)] = '\0';
+    }
+    return b->len;
+}
+
+size_t fmt_buf_stored(const fmt_buf_t *b) {
+    size_t stored = 0u;
+    if (b->cap > 0u) {
+        stored = (b->len < (b->cap - 1u)) ? b->len : (b->cap - 1u);
+    }
+    return stored;
+}
+
+bool fmt_buf_truncated(const fmt_buf_t *b) {
+    return fmt_buf_stored(b) < b->len;
+}
+
+bool fmt_write_all(int fd, const char *buf, size_t len) {
+    bool ok = true;
+    while (ok && (len > 0u)) {
+        ssize_t n = write(fd, buf, len);
+        if (n >= 0) {
+            buf += n;
+            len -= (size_t)n;
+        } else if (errno != EINTR) {
+            ok = false;
+        } else {
+            /* Interrupted before writing anything: retry */
+        }
+    }
+    return ok;
+}
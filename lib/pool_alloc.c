@@ -0,0 +1,72 @@
+/**
+ * @file pool_alloc.c
+ * @brief Fixed-size-block pool allocator implementation.
+ */
+
+#include "pool_alloc.h"
+
+#include <assert.h>
+
+bool pool_init(pool_t *pool, void *storage, size_t storage_size, size_t object_size) {
+    bool ok = false;
+    if ((pool != NULL) && (storage != NULL) && (object_size > 0u)) {
+        size_t block_size = POOL_BLOCK_SIZE(object_size);
+        bool aligned = (((uintptr_t)storage % POOL_ALIGN) == 0u);
+        if (aligned && (storage_size >= block_size)) {
+            pool->storage = (unsigned char *)storage;
+            pool->block_size = block_size;
+            pool->block_count = storage_size / block_size;
+            pool->next_unused = 0u;
+            pool->in_use = 0u;
+            pool->free_list = NULL;
+            ok = true;
+        }
+    }
+    return ok;
+}
+
+void *pool_alloc(pool_t *pool) {
+    void *block = NULL;
+    if (pool->free_list != NULL) {
+        pool_block_t *head = pool->free_list;
+        pool->free_list = head->next;
+        block = head;
+    } else if (pool->next_unused < pool->block_count) {
+        block = pool->storage + (pool->next_unused * pool->block_size);
+        pool->next_unused++;
+    } else {
+        /* Exhausted: report to the caller instead of falling back to the heap */
+    }
+    if (block != NULL) {
+        pool->in_use++;
+    }
+    return block;
+}
+
+void pool_free(pool_t *pool, void *block) {
+    if (block != NULL) {
+        assert(pool_owns(pool, block));
+        pool_block_t *node = (pool_block_t *)block;
+        node->next = pool->free_list;
+        pool->free_list = node;
+        pool->in_use--;
+    }
+}
+
+bool pool_owns(const pool_t *pool, const void *ptr) {
+    bool owns = false;
+    uintptr_t base = (uintptr_t)pool->storage;
+    uintptr_t addr = (uintptr_t)ptr;
+    if ((addr >= base) && (addr < (base + (pool->block_count * pool->block_size)))) {
+        owns = (((addr - base) % pool->block_size) == 0u);
+    }
+    return owns;
+}
+
+size_t pool_capacity(const pool_t *pool) {
+    return pool->block_count;
+}
+
+size_t pool_in_use(const pool_t *pool) {
+    return pool->in_use;
+}
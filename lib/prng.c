@@ -0,0 +1,137 @@
+/**
+ * @file prng.c
+ * @brief xoshiro256** engine, jump polynomials and lane-parallel fill.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "prng.h"
+
+#include <string.h>
+#include <sys/random.h>
+
+static inline uint64_t rotl(uint64_t x, unsigned k) {
+    return (x << k) | (x >> (64u - k));
+}
+
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15u);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    return z ^ (z >> 31);
+}
+
+void xoshiro256_seed(xoshiro256_t *rng, uint64_t seed) {
+    uint64_t sm = seed;
+    size_t i;
+    for (i = 0u; i < 4u; i++) {
+        rng->s[i] = splitmix64(&sm);
+    }
+}
+
+bool xoshiro256_seed_from_entropy(xoshiro256_t *rng) {
+    bool ok = false;
+    uint64_t seed[4];
+    if (getentropy(seed, sizeof(seed)) == 0) {
+        /* The all-zero state is the one invalid state */
+        if ((seed[0] | seed[1] | seed[2] | seed[3]) != 0u) {
+            (void)memcpy(rng->s, seed, sizeof(seed));
+            ok = true;
+        }
+    }
+    return ok;
+}
+
+uint64_t xoshiro256_next(xoshiro256_t *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rotl(s[1] * 5u, 7u) * 9u;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45u);
+    return result;
+}
+
+static void apply_jump(xoshiro256_t *rng, const uint64_t poly[4]) {
+    uint64_t acc[4] = {0u, 0u, 0u, 0u};
+    size_t i;
+    unsigned b;
+    for (i = 0u; i < 4u; i++) {
+        for (b = 0u; b < 64u; b++) {
+            if ((poly[i] & ((uint64_t)1u << b)) != 0u) {
+                acc[0] ^= rng->s[0];
+                acc[1] ^= rng->s[1];
+                acc[2] ^= rng->s[2];
+                acc[3] ^= rng->s[3];
+            }
+            (void)xoshiro256_next(rng);
+        }
+    }
+    (void)memcpy(rng->s, acc, sizeof(acc));
+}
+
+void xoshiro256_jump(xoshiro256_t *rng) {
+    static const uint64_t poly[4] = {0x180EC6D33CFD0ABAu, 0xD5A61266F0C9392Cu,
+                                     0xA9582618E03FC9AAu, 0x39ABDC4529B1661Cu};
+    apply_jump(rng, poly);
+}
+
+void xoshiro256_long_jump(xoshiro256_t *rng) {
+    static const uint64_t poly[4] = {0x76E15D3EFEFDCBBFu, 0xC5004E441C522FB3u,
+                                     0x77710069854EE241u, 0x39109BB02ACBE635u};
+    apply_jump(rng, poly);
+}
+
+void xoshiro256_fill(xoshiro256_t *rng, uint64_t *out, size_t n) {
+    size_t i;
+    for (i = 0u; i < n; i++) {
+        out[i] = xoshiro256_next(rng);
+    }
+}
+
+void xoshiro256_lanes_init(xoshiro256_lanes_t *lanes, xoshiro256_t *base) {
+    size_t l;
+    for (l = 0u; l < XOSHIRO256_LANES; l++) {
+        lanes->s[0][l] = base->s[0];
+        lanes->s[1][l] = base->s[1];
+        lanes->s[2][l] = base->s[2];
+        lanes->s[3][l] = base->s[3];
+        xoshiro256_jump(base);
+    }
+}
+
+/* One step of every lane; the loop over lanes has no carried dependency. */
+static inline void lanes_step(xoshiro256_lanes_t *restrict lanes, uint64_t *restrict out) {
+    uint64_t *restrict s0 = lanes->s[0];
+    uint64_t *restrict s1 = lanes->s[1];
+    uint64_t *restrict s2 = lanes->s[2];
+    uint64_t *restrict s3 = lanes->s[3];
+    size_t l;
+    for (l = 0u; l < XOSHIRO256_LANES; l++) {
+        uint64_t result = rotl(s1[l] * 5u, 7u) * 9u;
+        uint64_t t = s1[l] << 17;
+        s2[l] ^= s0[l];
+        s3[l] ^= s1[l];
+        s1[l] ^= s2[l];
+        s0[l] ^= s3[l];
+        s2[l] ^= t;
+        s3[l] = rotl(s3[l], 45u);
+        out[l] = result;
+    }
+}
+
+void xoshiro256_lanes_fill(xoshiro256_lanes_t *lanes, uint64_t *out, size_t n) {
+    size_t i = 0u;
+    while ((n - i) >= XOSHIRO256_LANES) {
+        lanes_step(lanes, out + i);
+        i += XOSHIRO256_LANES;
+    }
+    if (i < n) {
+        uint64_t tail[XOSHIRO256_LANES];
+        lanes_step(lanes, tail);
+        (void)memcpy(out + i, tail, (n - i) * sizeof(uint64_t));
+    }
+}
@@ -0,0 +1,284 @@
+/**
+ * @file probe.c
+ * @brief Per-thread probe counters and the JSON report at exit.
+ *
+ * Each thread's first pass through any probe takes a buffer from a
+ * lock-free list that lives until exit: one left by a thread that has
+ * exited, or a new one pushed onto the list. A thread-specific key's
+ * destructor hands the buffer back when its thread exits, counters and
+ * all, so the next thread adds to them and the list grows only to the
+ * most threads recording at once. Only the owning thread writes a buffer,
+ * with relaxed atomic loads and stores (plain moves on x86), so the
+ * report can read it while threads are still running without a data race.
+ *
+ * The pthread functions are referenced weakly, so programs built without
+ * -pthread on a C library that keeps them in libpthread still link; there
+ * buffers are never handed back.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "probe.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "probe counters require lock-free 64-bit atomics");
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PROBE_CLOCK_NAME "tsc"
+#else
+#define PROBE_CLOCK_NAME "clock_gettime"
+#endif
+
+/* Short runs spin until this much time has passed so the tick rate is usable */
+#define PROBE_MIN_CALIBRATION_NS 10000000u
+
+typedef struct probe_counters {
+    _Atomic uint64_t count;
+    _Atomic uint64_t total;
+    _Atomic uint64_t min;
+    _Atomic uint64_t max;
+} probe_counters_t;
+
+typedef struct probe_buffer {
+    probe_counters_t sites[PROBE_MAX_SITES];
+    _Atomic bool owned;  /* Cleared when the owning thread exits */
+    struct probe_buffer *next;
+} probe_buffer_t;
+
+#pragma weak pthread_key_create
+#pragma weak pthread_once
+#pragma weak pthread_setspecific
+
+static _Thread_local probe_buffer_t *tls_buffer;
+static _Atomic(probe_buffer_t *) buffers;
+static _Atomic uint64_t threads_attached;
+static pthread_once_t release_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t release_key;
+static bool release_key_ready;
+static _Atomic uint32_t site_count;
+static _Atomic(const char *) site_names[PROBE_MAX_SITES];
+static _Atomic uint64_t dropped;
+
+static atomic_flag started = ATOMIC_FLAG_INIT;
+static _Atomic uint64_t start_ticks;
+static _Atomic uint64_t start_ns;
+
+static _Atomic bool output_set;
+static _Atomic(const char *) output_path;
+
+uint64_t probe_clock_ns(void) {
+    struct timespec ts;
+    uint64_t ns = 0u;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+        ns = ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+    }
+    return ns;
+}
+
+/* Site id, registering the site on its first pass; 0 once all slots are taken */
+static uint32_t site_id(probe_site_t *site) {
+    uint32_t id = __atomic_load_n(&site->id, __ATOMIC_ACQUIRE);
+    if (id == 0u) {
+        uint32_t slot = atomic_load_explicit(&site_count, memory_order_relaxed);
+        while ((slot < PROBE_MAX_SITES) &&
+               !atomic_compare_exchange_weak_explicit(&site_count, &slot, slot + 1u,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+            /* slot reloaded by the failed exchange */
+        }
+        if (slot < PROBE_MAX_SITES) {
+            atomic_store_explicit(&site_names[slot], site->name, memory_order_release);
+            /* A thread that lost the race takes the winner's id; its slot stays empty */
+            uint32_t current = 0u;
+            id = __atomic_compare_exchange_n(&site->id, &current, slot + 1u, false,
+                                             __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+                     ? (slot + 1u)
+                     : current;
+        }
+    }
+    return id;
+}
+
+static void write_report_at_exit(void);
+
+/* Thread exit: the buffer's counters stay in the report, and its next owner adds to them */
+static void release_buffer(void *buffer) {
+    probe_buffer_t *b = buffer;
+    tls_buffer = NULL;
+    atomic_store_explicit(&b->owned, false, memory_order_release);
+}
+
+static void create_release_key(void) {
+    release_key_ready = pthread_key_create(&release_key, release_buffer) == 0;
+}
+
+/* A buffer handed back by an exited thread, or NULL */
+static probe_buffer_t *reuse_buffer(void) {
+    probe_buffer_t *b = atomic_load_explicit(&buffers, memory_order_acquire);
+    bool taken = false;
+    while ((b != NULL) && !taken) {
+        bool owned = false;
+        taken = atomic_compare_exchange_strong_explicit(&b->owned, &owned, true,
+                                                        memory_order_acquire,
+                                                        memory_order_relaxed);
+        b = taken ? b : b->next;
+    }
+    return b;
+}
+
+static probe_buffer_t *attach_buffer(void) {
+    probe_buffer_t *b = reuse_buffer();
+    if (b == NULL) {
+        b = calloc(1u, sizeof(*b));
+        if (b != NULL) {
+            atomic_init(&b->owned, true);
+            b->next = atomic_load_explicit(&buffers, memory_order_relaxed);
+            while (!atomic_compare_exchange_weak_explicit(&buffers, &b->next, b,
+                                                          memory_order_release,
+                                                          memory_order_relaxed)) {
+                /* b->next reloaded by the failed exchange */
+            }
+        }
+    }
+    if (b != NULL) {
+        tls_buffer = b;
+        (void)atomic_fetch_add_explicit(&threads_attached, 1u, memory_order_relaxed);
+        if ((pthread_key_create != NULL) &&
+            (pthread_once(&release_key_once, create_release_key) == 0) && release_key_ready) {
+            (void)pthread_setspecific(release_key, b);  /* On failure b is never reused */
+        }
+        if (!atomic_flag_test_and_set(&started)) {
+            atomic_store(&start_ns, probe_clock_ns());
+            atomic_store(&start_ticks, probe_ticks());
+            (void)atexit(write_report_at_exit);
+        }
+    }
+    return b;
+}
+
+void probe_record(probe_site_t *site, uint64_t ticks) {
+    const uint32_t id = site_id(site);
+    probe_buffer_t *b = (tls_buffer != NULL) ? tls_buffer : attach_buffer();
+    if ((id != 0u) && (b != NULL)) {
+        probe_counters_t *c = &b->sites[id - 1u];
+        const uint64_t n = atomic_load_explicit(&c->count, memory_order_relaxed);
+        const uint64_t total = atomic_load_explicit(&c->total, memory_order_relaxed);
+        atomic_store_explicit(&c->total, total + ticks, memory_order_relaxed);
+        if ((n == 0u) || (ticks < atomic_load_explicit(&c->min, memory_order_relaxed))) {
+            atomic_store_explicit(&c->min, ticks, memory_order_relaxed);
+        }
+        if (ticks > atomic_load_explicit(&c->max, memory_order_relaxed)) {
+            atomic_store_explicit(&c->max, ticks, memory_order_relaxed);
+        }
+        atomic_store_explicit(&c->count, n + 1u, memory_order_relaxed);
+    } else {
+        (void)atomic_fetch_add_explicit(&dropped, 1u, memory_order_relaxed);
+    }
+}
+
+void probe_set_output(const char *path) {
+    atomic_store(&output_path, path);
+    atomic_store(&output_set, true);
+}
+
+static double ns_per_tick(void) {
+    double rate = 1.0;
+#if defined(__x86_64__) || defined(__i386__)
+    const uint64_t t0 = atomic_load(&start_ticks);
+    const uint64_t n0 = atomic_load(&start_ns);
+    if (n0 != 0u) {
+        uint64_t n1 = probe_clock_ns();
+        while ((n1 - n0) < PROBE_MIN_CALIBRATION_NS) {
+            n1 = probe_clock_ns();
+        }
+        const uint64_t t1 = probe_ticks();
+        rate = (t1 > t0) ? ((double)(n1 - n0) / (double)(t1 - t0)) : 1.0;
+    }
+#endif
+    return rate;
+}
+
+static bool write_name(FILE *out, const char *name) {
+    bool ok = fputc('"', out) != EOF;
+    for (const char *p = name; ok && (*p != '\0'); ++p) {
+        const unsigned char ch = (unsigned char)*p;
+        if ((ch == '"') || (ch == '\\')) {
+            ok = fprintf(out, "\\%c", ch) > 0;
+        } else if (ch < 0x20u) {
+            ok = fprintf(out, "\\u%04x", (unsigned)ch) > 0;
+        } else {
+            ok = fputc(ch, out) != EOF;
+        }
+    }
+    return ok && (fputc('"', out) != EOF);
+}
+
+bool probe_write_json(FILE *out) {
+    const double rate = ns_per_tick();
+    const probe_buffer_t *head = atomic_load_explicit(&buffers, memory_order_acquire);
+    uint32_t sites = atomic_load_explicit(&site_count, memory_order_relaxed);
+    sites = (sites < PROBE_MAX_SITES) ? sites : PROBE_MAX_SITES;
+    const uint64_t threads = atomic_load_explicit(&threads_attached, memory_order_relaxed);
+    bool ok = fprintf(out,
+                      "{\n  \"clock\": \"%s\",\n  \"ns_per_tick\": %.6f,\n  \"threads\": %llu,\n"
+                      "  \"dropped\": %llu,\n  \"probes\": [",
+                      PROBE_CLOCK_NAME, rate, (unsigned long long)threads,
+                      (unsigned long long)atomic_load_explicit(&dropped,
+                                                               memory_order_relaxed)) > 0;
+    const char *sep = "\n";
+    for (uint32_t i = 0u; ok && (i < sites); ++i) {
+        const char *name = atomic_load_explicit(&site_names[i], memory_order_acquire);
+        uint64_t count = 0u;
+        uint64_t total = 0u;
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0u;
+        for (const probe_buffer_t *b = head; b != NULL; b = b->next) {
+            const probe_counters_t *c = &b->sites[i];
+            const uint64_t n = atomic_load_explicit(&c->count, memory_order_relaxed);
+            if (n > 0u) {
+                const uint64_t lo = atomic_load_explicit(&c->min, memory_order_relaxed);
+                const uint64_t hi = atomic_load_explicit(&c->max, memory_order_relaxed);
+                count += n;
+                total += atomic_load_explicit(&c->total, memory_order_relaxed);
+                min = (lo < min) ? lo : min;
+                max = (hi > max) ? hi : max;
+            }
+        }
+        if ((name != NULL) && (count > 0u)) {
+            ok = (fprintf(out, "%s    {\"name\": ", sep) > 0) && write_name(out, name) &&
+                 (fprintf(out,
+                          ", \"count\": %llu, \"total_ns\": %.1f, \"mean_ns\": %.1f, "
+                          "\"min_ns\": %.1f, \"max_ns\": %.1f}",
+                          (unsigned long long)count, (double)total * rate,
+                          (double)total * rate / (double)count, (double)min * rate,
+                          (double)max * rate) > 0);
+            sep = ",\n";
+        }
+    }
+    return ok && (fprintf(out, "\n  ]\n}\n") > 0);
+}
+
+static void write_report_at_exit(void) {
+    const char *path = atomic_load(&output_set) ? atomic_load(&output_path) : getenv("PROBE_JSON");
+    const bool to_stderr = !atomic_load(&output_set) && (path == NULL);
+    if (to_stderr || ((path != NULL) && (strcmp(path, "-") == 0))) {
+        (void)probe_write_json(stderr);
+    } else if (path != NULL) {
+        FILE *out = fopen(path, "w");
+        if (out != NULL) {
+            const bool ok = probe_write_json(out);
+            if ((fclose(out) != 0) || !ok) {
+                (void)fprintf(stderr, "probe: cannot write %s\n", path);
+            }
+        } else {
+            (void)fprintf(stderr, "probe: cannot open %s\n", path);
+        }
+    } else {
+        /* Report disabled with probe_set_output(NULL) */
+    }
+}
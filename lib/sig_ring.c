@@ -0,0 +1,192 @@
+/**
+ * @file sig_ring.c
+ * @brief Bounded multi-producer/single-consumer event ring (Vyukov-style
+ * per-slot sequence numbers).
+ *
+ * Each slot's sequence number is stored minus the slot index, so the
+ * all-zero state is the correctly initialised empty ring.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sig_ring.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+_Static_assert((SIG_RING_CAPACITY & (SIG_RING_CAPACITY - 1u)) == 0u,
+               "SIG_RING_CAPACITY must be a power of two");
+_Static_assert(ATOMIC_LONG_LOCK_FREE == 2, "sig_ring requires lock-free size_t atomics");
+
+#define SIG_RING_MASK ((size_t)SIG_RING_CAPACITY - 1u)
+
+/* Events formatted per write() call and the worst-case text line length */
+#define SIG_RING_BATCH 64u
+#define SIG_RING_LINE_MAX 128u
+
+static sig_ring_t sig_ring_instance;
+
+sig_ring_t *sig_ring_default(void) {
+    return &sig_ring_instance;
+}
+
+bool sig_ring_push(sig_ring_t *ring, const sig_record_t *rec) {
+    bool pushed = false;
+    bool done = false;
+    size_t pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    while (!done) {
+        size_t idx = pos & SIG_RING_MASK;
+        sig_ring_slot_t *slot = &ring->slots[idx];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire) + idx;
+        ptrdiff_t diff = (ptrdiff_t)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->head, &pos, pos + 1u,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                slot->record = *rec;
+                atomic_store_explicit(&slot->seq, (pos + 1u) - idx, memory_order_release);
+                atomic_fetch_add_explicit(&ring->pushed, 1u, memory_order_relaxed);
+                pushed = true;
+                done = true;
+            }
+        } else if (diff < 0) {
+            /* Slot still holds an undrained event: the ring is full */
+            atomic_fetch_add_explicit(&ring->dropped, 1u, memory_order_relaxed);
+            done = true;
+        } else {
+            pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+    }
+    return pushed;
+}
+
+bool sig_ring_record(sig_ring_t *ring, int32_t signo, int32_t code,
+                     uint64_t value0, uint64_t value1) {
+    struct timespec ts = {0, 0};
+    sig_record_t rec;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        ts.tv_sec = 0;
+        ts.tv_nsec = 0;
+    }
+    rec.timestamp_ns = ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+    rec.signo = signo;
+    rec.code = code;
+    rec.value[0] = value0;
+    rec.value[1] = value1;
+    return sig_ring_push(ring, &rec);
+}
+
+bool sig_ring_pop(sig_ring_t *ring, sig_record_t *out) {
+    bool popped = false;
+    size_t pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t idx = pos & SIG_RING_MASK;
+    sig_ring_slot_t *slot = &ring->slots[idx];
+    size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire) + idx;
+    if (seq == (pos + 1u)) {
+        *out = slot->record;
+        atomic_store_explicit(&slot->seq, (pos + SIG_RING_CAPACITY) - idx,
+                              memory_order_release);
+        atomic_store_explicit(&ring->tail, pos + 1u, memory_order_relaxed);
+        popped = true;
+    }
+    return popped;
+}
+
+/* Appends the decimal form of `v` and returns the new end of the buffer. */
+static char *append_u64(char *dst, uint64_t v) {
+    char tmp[20];
+    size_t n = 0u;
+    do {
+        tmp[n] = (char)('0' + (int)(v % 10u));
+        n++;
+        v /= 10u;
+    } while (v != 0u);
+    while (n > 0u) {
+        n--;
+        *dst = tmp[n];
+        dst++;
+    }
+    return dst;
+}
+
+static char *append_i32(char *dst, int32_t v) {
+    uint64_t magnitude = (uint64_t)(v < 0 ? -(int64_t)v : (int64_t)v);
+    if (v < 0) {
+        *dst = '-';
+        dst++;
+    }
+    return append_u64(dst, magnitude);
+}
+
+static char *append_str(char *dst, const char *s) {
+    size_t len = strlen(s);
+    (void)memcpy(dst, s, len);
+    return dst + len;
+}
+
+static char *format_record(char *dst, const sig_record_t *rec) {
+    dst = append_str(dst, "t=");
+    dst = append_u64(dst, rec->timestamp_ns);
+    dst = append_str(dst, " sig=");
+    dst = append_i32(dst, rec->signo);
+    dst = append_str(dst, " code=");
+    dst = append_i32(dst, rec->code);
+    dst = append_str(dst, " v=");
+    dst = append_u64(dst, rec->value[0]);
+    dst = append_str(dst, ",");
+    dst = append_u64(dst, rec->value[1]);
+    *dst = '\n';
+    return dst + 1;
+}
+
+static bool write_all(int fd, const char *buf, size_t len) {
+    bool ok = true;
+    while (ok && (len > 0u)) {
+        ssize_t n = write(fd, buf, len);
+        if (n >= 0) {
+            buf += n;
+            len -= (size_t)n;
+        } else if (errno != EINTR) {
+            ok = false;
+        } else {
+            /* Interrupted before writing anything: retry */
+        }
+    }
+    return ok;
+}
+
+long sig_ring_drain(sig_ring_t *ring, int fd, size_t max_records) {
+    char buf[SIG_RING_BATCH * SIG_RING_LINE_MAX];
+    long drained = 0;
+    bool more = true;
+    while (more && ((size_t)drained < max_records)) {
+        char *end = buf;
+        size_t batch = 0u;
+        sig_record_t rec;
+        while ((batch < SIG_RING_BATCH) && ((size_t)drained + batch < max_records) &&
+               sig_ring_pop(ring, &rec)) {
+            end = format_record(end, &rec);
+            batch++;
+        }
+        more = (batch == SIG_RING_BATCH);
+        if (batch > 0u) {
+            if (!write_all(fd, buf, (size_t)(end - buf))) {
+                drained = -1;
+                more = false;
+            } else {
+                drained += (long)batch;
+            }
+        }
+    }
+    return drained;
+}
+
+sig_ring_stats_t sig_ring_get_stats(sig_ring_t *ring) {
+    sig_ring_stats_t stats;
+    stats.pushed = atomic_load_explicit(&ring->pushed, memory_order_relaxed);
+    stats.dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    stats.drained = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    return stats;
+}
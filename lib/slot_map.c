@@ -0,0 +1,99 @@
+/**
+ * @file slot_map.c
+ * @brief Generational slot map implementation.
+ */
+
+#include "slot_map.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define SLOT_NONE UINT32_MAX
+
+bool slot_map_init(slot_map_t *map, void *storage, size_t storage_size, size_t element_size,
+                   uint32_t capacity) {
+    bool ok = false;
+    if ((map != NULL) && (storage != NULL) && (element_size > 0u) && (capacity > 0u) &&
+        (capacity < SLOT_NONE) && ((SIZE_MAX / element_size) > capacity)) {
+        bool aligned = (((uintptr_t)storage % _Alignof(max_align_t)) == 0u);
+        if (aligned && (storage_size >= SLOT_MAP_STORAGE_SIZE(element_size, (size_t)capacity))) {
+            unsigned char *base = (unsigned char *)storage;
+            size_t values_size = SLOT_MAP_STORAGE_SIZE(element_size, (size_t)capacity) -
+                                 ((size_t)capacity * (sizeof(slot_entry_t) + sizeof(uint32_t)));
+            map->values = base;
+            map->slots = (slot_entry_t *)(void *)(base + values_size);
+            map->owners = (uint32_t *)(void *)(map->slots + capacity);
+            map->element_size = element_size;
+            map->capacity = capacity;
+            map->size = 0u;
+            map->next_unused = 0u;
+            map->free_head = SLOT_NONE;
+            ok = true;
+        }
+    }
+    return ok;
+}
+
+slot_handle_t slot_map_insert(slot_map_t *map, const void *value) {
+    slot_handle_t handle = SLOT_HANDLE_NULL_INIT;
+    uint32_t index = SLOT_NONE;
+    if (map->free_head != SLOT_NONE) {
+        index = map->free_head;
+        map->free_head = map->slots[index].link;
+    } else if (map->next_unused < map->capacity) {
+        index = map->next_unused;
+        map->slots[index].generation = 0u;
+        map->next_unused++;
+    } else {
+        /* Full: report to the caller instead of growing */
+    }
+    if (index != SLOT_NONE) {
+        slot_entry_t *slot = &map->slots[index];
+        slot->generation++;
+        slot->link = map->size;
+        map->owners[map->size] = index;
+        (void)memcpy(map->values + ((size_t)map->size * map->element_size), value,
+                     map->element_size);
+        map->size++;
+        handle.index = index;
+        handle.generation = slot->generation;
+    }
+    return handle;
+}
+
+bool slot_map_erase(slot_map_t *map, slot_handle_t handle) {
+    bool erased = false;
+    if (slot_map_get(map, handle) != NULL) {
+        slot_entry_t *slot = &map->slots[handle.index];
+        uint32_t pos = slot->link;
+        uint32_t last = map->size - 1u;
+        if (pos != last) {
+            /* Keep the objects packed: the last one fills the hole */
+            (void)memcpy(map->values + ((size_t)pos * map->element_size),
+                         map->values + ((size_t)last * map->element_size), map->element_size);
+            map->owners[pos] = map->owners[last];
+            map->slots[map->owners[pos]].link = pos;
+        }
+        map->size = last;
+        slot->generation++;
+        if (slot->generation != 0u) {
+            slot->link = map->free_head;
+            map->free_head = handle.index;
+        }
+        erased = true;
+    }
+    return erased;
+}
+
+void slot_map_clear(slot_map_t *map) {
+    while (map->size > 0u) {
+        (void)slot_map_erase(map, slot_map_handle_at(map, map->size - 1u));
+    }
+}
+
+slot_handle_t slot_map_handle_at(const slot_map_t *map, uint32_t pos) {
+    assert(pos < map->size);
+    uint32_t index = map->owners[pos];
+    slot_handle_t handle = {index, map->slots[index].generation};
+    return handle;
+}
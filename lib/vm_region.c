@@ -0,0 +1,123 @@
+/**
+ * @file vm_region.c
+ * @brief Reserve-then-commit virtual memory regions over mmap.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "vm_region.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static size_t round_up(size_t v, size_t to) {
+    return ((v + to - 1u) / to) * to;
+}
+
+/* Hints only: a kernel without THP or MADV_POPULATE_WRITE just ignores them */
+static void advise(const vm_region_t *region, unsigned char *start, size_t len) {
+#if defined(MADV_HUGEPAGE)
+    if ((region->flags & VM_HUGE_PAGES) != 0u) {
+        (void)madvise(start, len, MADV_HUGEPAGE);
+    }
+#endif
+#if defined(MADV_POPULATE_WRITE)
+    if ((region->flags & VM_POPULATE) != 0u) {
+        (void)madvise(start, len, MADV_POPULATE_WRITE);
+    }
+#endif
+    (void)region;
+    (void)start;
+    (void)len;
+}
+
+size_t vm_page_size(void) {
+    long page = sysconf(_SC_PAGESIZE);
+    return (page > 0) ? (size_t)page : (size_t)4096u;
+}
+
+int vm_reserve(vm_region_t *region, size_t bytes, size_t chunk, uint32_t flags) {
+    int err = 0;
+    const size_t page = vm_page_size();
+    const bool huge = (flags & VM_HUGE_PAGES) != 0u;
+    const size_t align = huge ? VM_HUGE_PAGE_SIZE : page;
+    region->base = NULL;
+    region->reserved = 0u;
+    region->committed = 0u;
+    region->map = NULL;
+    region->map_size = 0u;
+    region->flags = flags;
+    region->chunk = round_up((chunk == 0u) ? VM_DEFAULT_CHUNK : chunk, align);
+    if ((bytes == 0u) || (bytes > (SIZE_MAX - (2u * align)))) {
+        err = EINVAL;
+    } else {
+        const size_t reserved = round_up(bytes, align);
+        /* Over-reserve by one alignment unit so the usable part can start on it */
+        const size_t map_size = reserved + (huge ? align : 0u);
+        void *map = mmap(NULL, map_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED) {
+            err = errno;
+        } else {
+            const uintptr_t start = round_up((uintptr_t)map, align);
+            region->map = (unsigned char *)map;
+            region->map_size = map_size;
+            region->base = (unsigned char *)start;
+            region->reserved = reserved;
+        }
+    }
+    return err;
+}
+
+int vm_commit(vm_region_t *region, size_t bytes) {
+    int err = 0;
+    if (bytes > region->reserved) {
+        err = ERANGE;
+    } else if (bytes > region->committed) {
+        size_t target = round_up(bytes, region->chunk);
+        target = (target > region->reserved) ? region->reserved : target;
+        unsigned char *start = region->base + region->committed;
+        const size_t len = target - region->committed;
+        if (mprotect(start, len, PROT_READ | PROT_WRITE) != 0) {
+            err = errno;
+        } else {
+            advise(region, start, len);
+            region->committed = target;
+        }
+    } else {
+        /* Already committed */
+    }
+    return err;
+}
+
+int vm_decommit(vm_region_t *region, size_t bytes) {
+    int err = 0;
+    size_t keep = round_up(bytes, region->chunk);
+    keep = (keep > region->reserved) ? region->reserved : keep;
+    if (keep < region->committed) {
+        unsigned char *start = region->base + keep;
+        const size_t len = region->committed - keep;
+        /* Mapping the range afresh as vm_reserve() did drops the pages and the
+         * commit charge; mprotect(PROT_NONE) would keep the charge. Without
+         * MAP_NORESERVE, so the next vm_commit() is charged and can fail. */
+        if (mmap(start, len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) ==
+            MAP_FAILED) {
+            err = errno;
+        } else {
+            region->committed = keep;
+        }
+    }
+    return err;
+}
+
+void vm_release(vm_region_t *region) {
+    if (region->map != NULL) {
+        (void)munmap(region->map, region->map_size);
+    }
+    region->base = NULL;
+    region->reserved = 0u;
+    region->committed = 0u;
+    region->map = NULL;
+    region->map_size = 0u;
+}
@@ -8,9 +8,20 @@
  */
 
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <signal.h>
+#include <unistd.h>
+
+#include "bounds.h"
+#include "bstr.h"
+#include "file_reader.h"
+#include "int_convert.h"
+#include "prng.h"
+#include "probe.h"
+#include "sig_ring.h"
+#include "slot_map.h"
 
 /* ============================================================
  * CERT C EXP30-C — Do not depend on the order of evaluation of
@@ -42,6 +53,17 @@ void cert_arr30_c(void) {
     (void)val;
 }
 
+/* Compliant: the index is checked against the array's element count (bounds.h) */
+static void cert_arr30_c_compliant(void) {
+    int32_t arr[10] = {0};
+    size_t index = 10u;
+    int32_t val = 0;
+    if (bounds_ok(index, BOUNDS_COUNT(arr))) {
+        val = arr[index];
+    }
+    (void)val;
+}
+
 /* ============================================================
  * CERT C MEM30-C — Do not access freed memory
  * ============================================================ */
@@ -54,6 +76,32 @@ void cert_mem30_c(void) {
     (void)val;
 }
 
+/* Compliant: a handle to an erased object looks up as NULL, because handles
+ * into the slot map are checked, not trusted */
+SLOT_MAP_DEFINE_STORAGE(cert_mem30_storage, sizeof(int32_t), 8u);
+
+static slot_map_t *cert_mem30_objects(void) {
+    static slot_map_t map;
+    static bool ready = false;
+    if (!ready) {
+        ready = slot_map_init(&map, cert_mem30_storage, sizeof(cert_mem30_storage),
+                              sizeof(int32_t), 8u);
+    }
+    return ready ? &map : NULL;
+}
+
+static void cert_mem30_c_compliant(void) {
+    slot_map_t *objects = cert_mem30_objects();
+    if (objects != NULL) {
+        int32_t value = 42;
+        slot_handle_t h = slot_map_insert(objects, &value);
+        (void)slot_map_erase(objects, h);
+        const int32_t *p = (const int32_t *)slot_map_get(objects, h);
+        int32_t val = (p != NULL) ? *p : 0;
+        (void)val;
+    }
+}
+
 /* ============================================================
  * CERT C MEM35-C — Allocate sufficient memory for an object
  * ============================================================ */
@@ -78,6 +126,17 @@ void cert_str31_c(void) {
     strcpy(buf, "This string is way too long for the buffer");  /* Buffer overflow */
 }
 
+/* Compliant: bounded copy that reports truncation (bstr.h) */
+static void cert_str31_c_compliant(void) {
+    char buf[10];
+    bstr_status_t status = bstr_copy(buf, sizeof(buf),
+                                     "This string is way too long for the buffer", NULL);
+    if (status != BSTR_OK) {
+        buf[0] = '\0';  /* Reject the truncated value rather than use it */
+    }
+    (void)buf;
+}
+
 /* ============================================================
  * CERT C ERR33-C — Detect and handle standard library errors
  * ============================================================ */
@@ -87,6 +146,28 @@ void cert_err33_c(void) {
     fclose(f);  /* Potential NULL dereference */
 }
 
+/* Compliant: open, read and close each return an errno that is checked, and
+ * a reader that failed to open holds nothing to close (file_reader.h). */
+static void cert_err33_c_compliant(void) {
+    file_reader_t reader;
+    int err = file_reader_open(&reader, "nonexistent.txt", FILE_READER_AUTO, 0u);
+    if (err == 0) {
+        const char *line = NULL;
+        size_t len = 0u;
+        size_t lines = 0u;
+        do {
+            err = file_reader_next_line(&reader, &line, &len);
+            lines += (line != NULL) ? 1u : 0u;
+        } while ((err == 0) && (line != NULL));
+        const int close_err = file_reader_close(&reader);
+        err = (err != 0) ? err : close_err;
+        (void)lines;
+    }
+    if (err != 0) {
+        (void)fprintf(stderr, "nonexistent.txt: error %d\n", err);
+    }
+}
+
 /* ============================================================
  * CERT C SIG30-C — Call only asynchronous-safe functions within
  * signal handlers
@@ -99,6 +180,21 @@ void cert_sig30_c(void) {
     signal(SIGINT, bad_signal_handler);
 }
 
+/* Compliant: the handler only pushes a fixed-size record into a lock-free
+ * ring; a normal thread formats and writes it afterwards (sig_ring.h). */
+static void good_signal_handler(int sig) {
+    (void)sig_ring_record(sig_ring_default(), (int32_t)sig, 0, 0u, 0u);
+}
+
+static void cert_sig30_c_compliant(void) {
+    if (signal(SIGUSR1, good_signal_handler) != SIG_ERR) {
+        if (raise(SIGUSR1) == 0) {
+            (void)sig_ring_drain(sig_ring_default(), STDOUT_FILENO, SIG_RING_CAPACITY);
+        }
+        (void)signal(SIGUSR1, SIG_DFL);
+    }
+}
+
 /* ============================================================
  * CERT C MSC32-C — Properly seed pseudorandom number generators
  * ============================================================ */
@@ -107,6 +203,15 @@ void cert_msc32_c(void) {
     (void)r;
 }
 
+/* Compliant: an explicitly seeded, caller-owned generator (prng.h) */
+static void cert_msc32_c_compliant(void) {
+    xoshiro256_t rng;
+    if (xoshiro256_seed_from_entropy(&rng)) {
+        uint64_t r = xoshiro256_next(&rng);
+        (void)r;
+    }
+}
+
 /* ============================================================
  * CERT C INT31-C — Ensure integer conversions do not result in
  * lost or misinterpreted data
@@ -117,6 +222,16 @@ void cert_int31_c(void) {
     (void)s;
 }
 
+/* Compliant: the conversion is range-checked before use (int_convert.h) */
+static void cert_int31_c_compliant(void) {
+    uint32_t u = UINT32_MAX;
+    int32_t s = 0;
+    if (!checked_u32_to_i32(u, &s)) {
+        s = INT32_MAX;  /* Out of range: substitute a defined value */
+    }
+    (void)s;
+}
+
 /* ============================================================
  * CERT C DCL30-C — Declare objects with appropriate storage
  * durations
@@ -126,20 +241,63 @@ int *cert_dcl30_c(void) {
     return &local_var;  /* Returning address of local variable */
 }
 
+/* Compliant: the slot map keeps a copy and the caller gets a handle to it */
+SLOT_MAP_DEFINE_STORAGE(cert_dcl30_storage, sizeof(int32_t), 8u);
+
+static slot_map_t *cert_dcl30_objects(void) {
+    static slot_map_t map;
+    static bool ready = false;
+    if (!ready) {
+        ready = slot_map_init(&map, cert_dcl30_storage, sizeof(cert_dcl30_storage),
+                              sizeof(int32_t), 8u);
+    }
+    return ready ? &map : NULL;
+}
+
+static slot_handle_t cert_dcl30_c_compliant(void) {
+    slot_handle_t h = SLOT_HANDLE_NULL_INIT;
+    slot_map_t *objects = cert_dcl30_objects();
+    if (objects != NULL) {
+        int32_t local_var = 42;
+        h = slot_map_insert(objects, &local_var);
+    }
+    return h;
+}
+
+/* The caller reads through the handle and erases the object when done with it */
+static void cert_dcl30_c_compliant_caller(void) {
+    slot_map_t *objects = cert_dcl30_objects();
+    slot_handle_t h = cert_dcl30_c_compliant();
+    if (objects != NULL) {
+        const int32_t *p = (const int32_t *)slot_map_get(objects, h);
+        int32_t val = (p != NULL) ? *p : 0;
+        (void)val;
+        (void)slot_map_erase(objects, h);
+    }
+}
+
 /* ============================================================
  * Helper: entry point to prevent "unused function" warnings.
  * ============================================================ */
 int main(void) {
-    cert_exp30_c();
-    cert_exp33_c();
-    cert_arr30_c();
-    cert_mem30_c();
-    cert_mem35_c();
-    cert_str31_c();
-    cert_err33_c();
-    cert_sig30_c();
-    cert_msc32_c();
-    cert_int31_c();
-    (void)cert_dcl30_c();
+    PROBE_CALL(cert_exp30_c, ());
+    PROBE_CALL(cert_exp33_c, ());
+    PROBE_CALL(cert_arr30_c, ());
+    PROBE_CALL(cert_arr30_c_compliant, ());
+    PROBE_CALL(cert_mem30_c, ());
+    PROBE_CALL(cert_mem30_c_compliant, ());
+    PROBE_CALL(cert_mem35_c, ());
+    PROBE_CALL(cert_str31_c, ());
+    PROBE_CALL(cert_str31_c_compliant, ());
+    PROBE_CALL(cert_err33_c, ());
+    PROBE_CALL(cert_err33_c_compliant, ());
+    PROBE_CALL(cert_sig30_c, ());
+    PROBE_CALL(cert_sig30_c_compliant, ());
+    PROBE_CALL(cert_msc32_c, ());
+    PROBE_CALL(cert_msc32_c_compliant, ());
+    PROBE_CALL(cert_int31_c, ());
+    PROBE_CALL(cert_int31_c_compliant, ());
+    (void)PROBE_CALL(cert_dcl30_c, ());
+    PROBE_CALL(cert_dcl30_c_compliant_caller, ());
     return 0;
 }
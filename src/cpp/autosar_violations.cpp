@@ -7,12 +7,26 @@
  * pack will detect when run against this code.
  */
 
+#include <array>
+#include <cstdint>
 #include <cstdlib>
 #include <cstdio>
 #include <memory>
 #include <stdexcept>
+#include <system_error>
 #include <vector>
 
+#include "bits.hpp"
+#include "bounds.hpp"
+#include "dispatch.hpp"
+#include "expected.hpp"
+#include "int_convert.hpp"
+#include "pool_alloc.hpp"
+#include "probe.h"
+#include "span.hpp"
+#include "string_view.hpp"
+#include "units.hpp"
+
 /* ============================================================
  * AUTOSAR A0-1-1 — A project shall not contain instances of
  * non-volatile variables given values that are not subsequently used.
@@ -54,6 +68,11 @@ int autosar_a5_1_1(int input) {
     return input * 3600;  // Magic number 3600 (seconds in an hour)
 }
 
+// Compliant: both units are named in the types, and overflow is reported
+cs::expected<cs::units::seconds32, std::errc> autosar_a5_1_1_compliant(cs::units::hours32 input) {
+    return cs::units::checked_cast<cs::units::seconds32>(input);
+}
+
 /* ============================================================
  * AUTOSAR A7-1-5 — The auto specifier shall not be used apart
  * from … (limited contexts)
@@ -79,11 +98,29 @@ public:
  * AUTOSAR A15-1-2 — An exception object shall not be a pointer.
  * ============================================================ */
 void autosar_a15_1_2() {
+#if defined(__cpp_exceptions)
     try {
         throw new std::runtime_error("oops");  // Throwing a pointer — violates A15-1-2
     } catch (std::runtime_error *e) {
         delete e;
     }
+#endif
+}
+
+// Compliant: the failure travels back as a value; nothing is thrown or allocated
+cs::expected<std::int32_t, std::errc> autosar_a15_1_2_divide(std::int32_t num, std::int32_t den) {
+    cs::expected<std::int32_t, std::errc> result = cs::make_unexpected(std::errc::invalid_argument);
+    if ((den != 0) && !((num == INT32_MIN) && (den == -1))) {
+        result = num / den;
+    }
+    return result;
+}
+
+void autosar_a15_1_2_compliant() {
+    std::int32_t r = autosar_a15_1_2_divide(84, 2)
+                         .and_then([](std::int32_t q) { return autosar_a15_1_2_divide(q, 0); })
+                         .value_or(0);
+    static_cast<void>(r);
 }
 
 /* ============================================================
@@ -94,6 +131,13 @@ void autosar_a18_1_1() {
     static_cast<void>(arr);
 }
 
+// Compliant: a std::array-based fixed array with a bounds policy on operator[]
+void autosar_a18_1_1_compliant() {
+    cs::checked_array<std::int32_t, 10> arr{};
+    arr[9] = 1;
+    static_cast<void>(arr);
+}
+
 /* ============================================================
  * AUTOSAR A18-5-1 — Functions malloc, calloc, realloc and free
  * shall not be used.
@@ -105,6 +149,15 @@ void autosar_a18_5_1() {
     }
 }
 
+// Compliant: a typed pool with static storage replaces malloc/free
+void autosar_a18_5_1_compliant() {
+    static cs::typed_pool<std::array<std::int32_t, 10>, 4> pool;
+    cs::typed_pool<std::array<std::int32_t, 10>, 4>::handle p = pool.make();
+    if (p != nullptr) {
+        p->fill(0);
+    }
+}
+
 /* ============================================================
  * AUTOSAR M5-0-3 — A cvalue expression shall not be implicitly
  * converted to a different underlying type.
@@ -115,6 +168,13 @@ void autosar_m5_0_3() {
     static_cast<void>(d);
 }
 
+// Compliant: explicit conversion that is proven lossless at compile time
+void autosar_m5_0_3_compliant() {
+    std::int32_t i = 42;
+    double d = cs::widen<double>(i);
+    static_cast<void>(d);
+}
+
 /* ============================================================
  * AUTOSAR A5-2-2 — Traditional C-style casts shall not be used.
  * ============================================================ */
@@ -135,6 +195,14 @@ void autosar_a3_9_1() {
     static_cast<void>(y);
 }
 
+// Compliant: fixed-width types, and bit operations that keep them
+void autosar_a3_9_1_compliant() {
+    const std::int32_t x = 42;
+    const std::uint64_t y = cs::bits::rotl(std::uint64_t{100u}, 8u);
+    static_cast<void>(x);
+    static_cast<void>(y);
+}
+
 /* ============================================================
  * AUTOSAR M6-4-1 — An if-else-if construct shall be terminated
  * with an else clause.
@@ -148,6 +216,26 @@ void autosar_m6_4_1(int val) {
     // Missing final 'else' clause
 }
 
+// Compliant: the handlers are a table whose mandatory default takes every other value
+void autosar_m6_4_1_on_one() {
+    // Handle 1
+}
+
+void autosar_m6_4_1_on_two() {
+    // Handle 2
+}
+
+void autosar_m6_4_1_on_other() {
+    // Every other value
+}
+
+void autosar_m6_4_1_compliant(std::int32_t val) {
+    static constexpr auto kHandlers =
+        cs::make_dispatch_table<1, 2>(&autosar_m6_4_1_on_other, cs::on(1, &autosar_m6_4_1_on_one),
+                                      cs::on(2, &autosar_m6_4_1_on_two));
+    kHandlers(val);
+}
+
 /* ============================================================
  * AUTOSAR A8-4-7 — "in" parameters for "cheap to copy" types
  * shall be passed by value. "in" parameters for "not cheap to
@@ -157,29 +245,55 @@ void autosar_a8_4_7(std::vector<int> data) {  // Large type by value — should
     static_cast<void>(data.size());
 }
 
+// Compliant: the container is passed by reference to const
+void autosar_a8_4_7_compliant(const std::vector<int> &data) {
+    static_cast<void>(data.size());
+}
+
+// Compliant: a two-word non-owning view is cheap to copy, so it goes by value
+void autosar_a8_4_7_compliant(cs::span<const int> data) {
+    static_cast<void>(data.size());
+}
+
+// Compliant: read-only text through a non-owning string view
+void autosar_a8_4_7_compliant(cs::string_view text) {
+    static_cast<void>(text.size());
+}
+
 /* ============================================================
  * Helper: entry point to call all violation functions.
  * ============================================================ */
 int main() {
-    autosar_a0_1_1();
-    autosar_a0_1_2();
-    autosar_a2_10_1();
-    static_cast<void>(autosar_a5_1_1(10));
-    autosar_a7_1_5();
+    PROBE_CALL(autosar_a0_1_1, ());
+    PROBE_CALL(autosar_a0_1_2, ());
+    PROBE_CALL(autosar_a2_10_1, ());
+    static_cast<void>(PROBE_CALL(autosar_a5_1_1, (10)));
+    static_cast<void>(PROBE_CALL(autosar_a5_1_1_compliant, (cs::units::hours32(10))));
+    PROBE_CALL(autosar_a7_1_5, ());
 
     autosar_a11_0_2_struct s;
     s.visible = 1;
     s.set_secret(2);
 
-    autosar_a18_1_1();
-    autosar_a18_5_1();
-    autosar_m5_0_3();
-    autosar_a5_2_2();
-    autosar_a3_9_1();
-    autosar_m6_4_1(1);
+    PROBE_CALL(autosar_a15_1_2, ());
+    PROBE_CALL(autosar_a15_1_2_compliant, ());
+    PROBE_CALL(autosar_a18_1_1, ());
+    PROBE_CALL(autosar_a18_1_1_compliant, ());
+    PROBE_CALL(autosar_a18_5_1, ());
+    PROBE_CALL(autosar_a18_5_1_compliant, ());
+    PROBE_CALL(autosar_m5_0_3, ());
+    PROBE_CALL(autosar_m5_0_3_compliant, ());
+    PROBE_CALL(autosar_a5_2_2, ());
+    PROBE_CALL(autosar_a3_9_1, ());
+    PROBE_CALL(autosar_a3_9_1_compliant, ());
+    PROBE_CALL(autosar_m6_4_1, (1));
+    PROBE_CALL(autosar_m6_4_1_compliant, (1));
 
     std::vector<int> v = {1, 2, 3};
-    autosar_a8_4_7(v);
+    PROBE_CALL(autosar_a8_4_7, (v));
+    PROBE_CALL(autosar_a8_4_7_compliant, (v));
+    PROBE_CALL(autosar_a8_4_7_compliant, (cs::span<const int>(v)));
+    PROBE_CALL(autosar_a8_4_7_compliant, (cs::string_view("text")));
 
     return 0;
 }
@@ -7,14 +7,27 @@
  * pack will detect when run against this code.
  */
 
+#include <array>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <vector>
 
+#include "big_array.hpp"
+#include "expected.hpp"
+#include "lazy.hpp"
+#include "poly_value.hpp"
+#include "prng.hpp"
+#include "probe.h"
+#include "relocate.hpp"
+#include "static_vector.hpp"
+
 /* ============================================================
  * CERT C++ ERR50-CPP — Do not abruptly terminate the program
  * ============================================================ */
@@ -27,10 +40,26 @@ void cert_err50_cpp() {
  * begins executing
  * ============================================================ */
 std::string global_str = []() -> std::string {
+#if defined(__cpp_exceptions)
     throw std::runtime_error("init error");  // Thrown during static init
+#endif
     return "ok";
 }();
 
+// Compliant: built on first use, and an init failure is returned to the caller
+cs::expected<std::string, std::errc> cert_err58_cpp_init() {
+    return cs::make_unexpected(std::errc::io_error);  // The same "init error"
+}
+
+cs::lazy<std::string, std::errc> global_str_lazy(cert_err58_cpp_init);
+
+void cert_err58_cpp_compliant() {
+    cs::expected<std::string *, std::errc> s = global_str_lazy.get();
+    if (s) {
+        static_cast<void>((*s)->size());
+    }
+}
+
 /* ============================================================
  * CERT C++ DCL50-CPP — Do not define a C-style variadic function
  * ============================================================ */
@@ -38,6 +67,13 @@ int cert_dcl50_cpp(int count, ...) {  // C-style variadic — prohibited
     return count;
 }
 
+// Compliant: a variadic template keeps every argument's type, and the count
+// comes from the compiler instead of the caller (fmt.hpp is built this way)
+template <typename... Args>
+int cert_dcl50_cpp_compliant(const Args &...) {
+    return static_cast<int>(sizeof...(Args));
+}
+
 /* ============================================================
  * CERT C++ OOP57-CPP — Prefer special member functions and
  * overloaded operators to C Standard Library functions
@@ -54,6 +90,18 @@ void cert_oop57_cpp() {
     static_cast<void>(b);
 }
 
+// Compliant: the copy constructor for one object; for arrays, cs::copy_assign_n
+// uses memcpy only while SimpleData is trivially copyable
+void cert_oop57_cpp_compliant() {
+    SimpleData a = {1, 2};
+    SimpleData b = a;
+    const std::array<SimpleData, 4> src = {{{1, 2}, {3, 4}, {5, 6}, {7, 8}}};
+    std::array<SimpleData, 4> dst = {};
+    cs::copy_assign_n(src.data(), src.size(), dst.data());
+    static_cast<void>(b);
+    static_cast<void>(dst);
+}
+
 /* ============================================================
  * CERT C++ EXP55-CPP — Do not access a cv-qualified object
  * through a cv-unqualified type
@@ -75,6 +123,17 @@ void cert_ctr50_cpp() {
     static_cast<void>(val);
 }
 
+// Compliant: inline storage, and the index is checked against size() first
+void cert_ctr50_cpp_compliant() {
+    cs::static_vector<std::int32_t, 8> vec = {1, 2, 3};
+    std::size_t index = 5u;
+    std::int32_t val = 0;
+    if (index < vec.size()) {
+        val = vec[index];
+    }
+    static_cast<void>(val);
+}
+
 /* ============================================================
  * CERT C++ MEM52-CPP — Detect and handle memory allocation errors
  * ============================================================ */
@@ -85,15 +144,47 @@ void cert_mem52_cpp() {
     delete[] p;
 }
 
+// Compliant: the reservation and the commit each come back as a checked result
+void cert_mem52_cpp_compliant() {
+    cs::expected<cs::big_array<std::int32_t>, std::errc> a =
+        cs::big_array<std::int32_t>::reserve(1000000000u);
+    if (a.has_value() && a.value().resize(1u).has_value()) {
+        a.value()[0] = 42;
+    }
+}
+
 /* ============================================================
  * CERT C++ ERR61-CPP — Catch exceptions by lvalue reference
  * ============================================================ */
 void cert_err61_cpp() {
+#if defined(__cpp_exceptions)
     try {
         throw std::runtime_error("error");
     } catch (std::exception e) {  // Caught by value — causes object slicing
         static_cast<void>(e.what());
     }
+#endif
+}
+
+// Compliant: the whole error comes back by value; there is no base class to slice it to
+struct cert_err61_cpp_error {
+    std::errc code;
+    const char *what;
+};
+
+cs::expected<std::int32_t, cert_err61_cpp_error> cert_err61_cpp_operation(bool fail) {
+    cs::expected<std::int32_t, cert_err61_cpp_error> result = 0;
+    if (fail) {
+        result = cs::make_unexpected(cert_err61_cpp_error{std::errc::io_error, "error"});
+    }
+    return result;
+}
+
+void cert_err61_cpp_compliant() {
+    cs::expected<std::int32_t, cert_err61_cpp_error> r = cert_err61_cpp_operation(true);
+    if (!r) {
+        static_cast<void>(r.error().what);
+    }
 }
 
 /* ============================================================
@@ -105,6 +196,14 @@ void cert_msc50_cpp() {
     static_cast<void>(r);
 }
 
+// Compliant: an entropy-seeded engine used through a <random> distribution
+void cert_msc50_cpp_compliant() {
+    cs::xoshiro256 rng = cs::xoshiro256::from_entropy();
+    std::uniform_int_distribution<std::int32_t> dist(0, 99);
+    std::int32_t r = dist(rng);
+    static_cast<void>(r);
+}
+
 /* ============================================================
  * CERT C++ OOP51-CPP — Do not slice derived objects
  * ============================================================ */
@@ -129,18 +228,64 @@ void cert_oop51_cpp() {
     process_by_value(d);  // Object slicing occurs here
 }
 
+// Compliant: poly_value copies the whole Derived into inline storage, so it keeps its type
+void process_by_poly_value(const cs::poly_value<Base> &b) {
+    static_cast<void>(b->value());
+}
+
+void cert_oop51_cpp_compliant() {
+    Derived d;
+    process_by_poly_value(d);
+    std::array<cs::poly_value<Base>, 2> items = {{Derived{}, Base{}}};
+    for (const cs::poly_value<Base> &item : items) {
+        process_by_poly_value(item);
+    }
+}
+
+// Compliant: static dispatch through CRTP; the derived type is never erased
+template <typename D>
+class StaticBase {
+public:
+    int value() const { return static_cast<const D &>(*this).value_impl(); }
+};
+
+class StaticDerived : public StaticBase<StaticDerived> {
+    int extra_ = 42;
+public:
+    int value_impl() const { return extra_; }
+};
+
+template <typename D>
+void process_static(const StaticBase<D> &b) {
+    static_cast<void>(b.value());
+}
+
+void cert_oop51_cpp_compliant_static() {
+    StaticDerived d;
+    process_static(d);
+}
+
 /* ============================================================
  * Helper: entry point.
  * ============================================================ */
 int main() {
     // cert_err50_cpp();  // Would terminate — commented for demo
-    cert_dcl50_cpp(1, 2, 3);
-    cert_oop57_cpp();
-    cert_exp55_cpp();
-    cert_ctr50_cpp();
-    cert_mem52_cpp();
-    cert_err61_cpp();
-    cert_msc50_cpp();
-    cert_oop51_cpp();
+    PROBE_CALL(cert_err58_cpp_compliant, ());
+    PROBE_CALL(cert_dcl50_cpp, (1, 2, 3));
+    static_cast<void>(PROBE_CALL(cert_dcl50_cpp_compliant, (1, 2, 3)));
+    PROBE_CALL(cert_oop57_cpp, ());
+    PROBE_CALL(cert_oop57_cpp_compliant, ());
+    PROBE_CALL(cert_exp55_cpp, ());
+    PROBE_CALL(cert_ctr50_cpp, ());
+    PROBE_CALL(cert_ctr50_cpp_compliant, ());
+    PROBE_CALL(cert_mem52_cpp, ());
+    PROBE_CALL(cert_mem52_cpp_compliant, ());
+    PROBE_CALL(cert_err61_cpp, ());
+    PROBE_CALL(cert_err61_cpp_compliant, ());
+    PROBE_CALL(cert_msc50_cpp, ());
+    PROBE_CALL(cert_msc50_cpp_compliant, ());
+    PROBE_CALL(cert_oop51_cpp, ());
+    PROBE_CALL(cert_oop51_cpp_compliant, ());
+    PROBE_CALL(cert_oop51_cpp_compliant_static, ());
     return 0;
 }
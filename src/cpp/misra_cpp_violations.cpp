@@ -10,7 +10,19 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
+#include <system_error>
+
+#include "bstr.hpp"
+#include "dispatch.hpp"
+#include "expected.hpp"
+#include "fmt.hpp"
+#include "int_convert.hpp"
+#include "pool_alloc.hpp"
+#include "probe.h"
 
 /* ============================================================
  * MISRA C++ Rule 0-1-1 — A project shall not contain unreachable code
@@ -42,6 +54,13 @@ void misra_cpp_5_0_3() {
     static_cast<void>(d);
 }
 
+// Compliant: explicit conversion that is proven lossless at compile time
+void misra_cpp_5_0_3_compliant() {
+    std::int32_t i = 100;
+    double d = cs::widen<double>(i);
+    static_cast<void>(d);
+}
+
 /* ============================================================
  * MISRA C++ Rule 5-2-4 — C-style casts and functional notation
  * casts shall not be used.
@@ -65,6 +84,13 @@ void misra_cpp_6_4_2(int x) {
     // Missing final else clause
 }
 
+// Compliant: each case is a table entry and the mandatory default covers every other value
+std::int32_t misra_cpp_6_4_2_compliant(std::int32_t x) {
+    static constexpr auto kCaseOf = cs::make_dispatch_table<1, 2>(
+        std::int32_t{0}, cs::on(1, std::int32_t{1}), cs::on(2, std::int32_t{2}));
+    return kCaseOf[x];
+}
+
 /* ============================================================
  * MISRA C++ Rule 6-6-5 — A function shall have a single point of exit
  * at the end of the function.
@@ -79,16 +105,39 @@ int misra_cpp_6_6_5(int x) {
     return 0;  // Normal return
 }
 
+// Compliant: the sign is x clamped to [-1, 1], returned once at the end
+std::int32_t misra_cpp_6_6_5_compliant(std::int32_t x) {
+    return std::min(std::max(x, -1), 1);
+}
+
 /* ============================================================
  * MISRA C++ Rule 15-3-5 — A class type exception shall always
  * be caught by reference.
  * ============================================================ */
 void misra_cpp_15_3_5() {
+#if defined(__cpp_exceptions)
     try {
         throw 42;
     } catch (int) {  // Catching non-class type
         // ...
     }
+#endif
+}
+
+// Compliant: the error is a returned value handled by or_else; nothing is thrown or caught
+cs::expected<std::int32_t, std::errc> misra_cpp_15_3_5_lookup(std::int32_t key) {
+    cs::expected<std::int32_t, std::errc> result = cs::make_unexpected(std::errc::result_out_of_range);
+    if ((key >= 0) && (key < 42)) {
+        result = key * 2;
+    }
+    return result;
+}
+
+void misra_cpp_15_3_5_compliant() {
+    std::int32_t v = misra_cpp_15_3_5_lookup(42)
+                         .or_else([](std::errc) { return cs::expected<std::int32_t, std::errc>(0); })
+                         .value();
+    static_cast<void>(v);
 }
 
 /* ============================================================
@@ -102,6 +151,15 @@ void misra_cpp_18_0_1() {
     static_cast<void>(dst);
 }
 
+// Compliant: capacity comes from the array type and truncation is checked
+void misra_cpp_18_0_1_compliant() {
+    std::array<char, 10> dst{};
+    if (cs::bounded_copy(dst, "hello") != BSTR_OK) {
+        dst.fill('\0');
+    }
+    static_cast<void>(dst);
+}
+
 /* ============================================================
  * MISRA C++ Rule 18-4-1 — Dynamic heap memory allocation shall
  * not be used.
@@ -111,6 +169,15 @@ void misra_cpp_18_4_1() {
     delete p;
 }
 
+// Compliant: objects are constructed in a statically allocated pool
+void misra_cpp_18_4_1_compliant() {
+    static cs::typed_pool<std::int32_t, 8> pool;
+    std::int32_t *p = pool.create(42);
+    if (p != nullptr) {
+        pool.destroy(p);
+    }
+}
+
 /* ============================================================
  * MISRA C++ Rule 27-0-1 — The stream input/output library
  * <cstdio> shall not be used.
@@ -119,19 +186,31 @@ void misra_cpp_27_0_1() {
     std::printf("Using cstdio is a MISRA violation\n");
 }
 
+// Compliant: cs::print checks the format at compile time and writes with write(2)
+void misra_cpp_27_0_1_compliant() {
+    static_cast<void>(cs::print(CS_FMT("Formatted without cstdio: {} {:.2}\n"), -42, 2.5));
+}
+
 /* ============================================================
  * Helper: entry point.
  * ============================================================ */
 int main() {
-    static_cast<void>(misra_cpp_0_1_1(5));
-    misra_cpp_2_10_2();
-    misra_cpp_5_0_3();
-    misra_cpp_5_2_4();
-    misra_cpp_6_4_2(1);
-    static_cast<void>(misra_cpp_6_6_5(5));
-    misra_cpp_15_3_5();
-    misra_cpp_18_0_1();
-    misra_cpp_18_4_1();
-    misra_cpp_27_0_1();
+    static_cast<void>(PROBE_CALL(misra_cpp_0_1_1, (5)));
+    PROBE_CALL(misra_cpp_2_10_2, ());
+    PROBE_CALL(misra_cpp_5_0_3, ());
+    PROBE_CALL(misra_cpp_5_0_3_compliant, ());
+    PROBE_CALL(misra_cpp_5_2_4, ());
+    PROBE_CALL(misra_cpp_6_4_2, (1));
+    static_cast<void>(PROBE_CALL(misra_cpp_6_4_2_compliant, (1)));
+    static_cast<void>(PROBE_CALL(misra_cpp_6_6_5, (5)));
+    static_cast<void>(PROBE_CALL(misra_cpp_6_6_5_compliant, (5)));
+    PROBE_CALL(misra_cpp_15_3_5, ());
+    PROBE_CALL(misra_cpp_15_3_5_compliant, ());
+    PROBE_CALL(misra_cpp_18_0_1, ());
+    PROBE_CALL(misra_cpp_18_0_1_compliant, ());
+    PROBE_CALL(misra_cpp_18_4_1, ());
+    PROBE_CALL(misra_cpp_18_4_1_compliant, ());
+    PROBE_CALL(misra_cpp_27_0_1, ());
+    PROBE_CALL(misra_cpp_27_0_1_compliant, ());
     return 0;
 }
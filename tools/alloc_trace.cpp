@@ -0,0 +1,677 @@
+/**
+ * @file alloc_trace.cpp
+ * @brief LD_PRELOAD heap tracer: allocations and bytes per call stack,
+ * peak live bytes, and a symbolized report at exit.
+ *
+ *   make tools
+ *   LD_PRELOAD=tools/alloc_trace.so src/c/misra_violations
+ *
+ * Interposes malloc, calloc, realloc, free, the aligned allocators and the
+ * replaceable global operator new/delete, forwarding to glibc's
+ * __libc_malloc family. Each allocation is charged to its call stack, as
+ * captured by the unwinder with this library's own frames skipped, in a
+ * hash table owned by the allocating thread. Tables are updated without
+ * locks or shared cache lines and are merged only when the report is
+ * written. A thread's table is handed back when it exits and taken over,
+ * counts and all, by the next thread that allocates, so there are only as
+ * many tables as threads allocating at once. Live bytes, counted by
+ * malloc_usable_size, are the only shared counter.
+ *
+ * The report lists, for each "owner", the allocations and bytes charged to
+ * it. The owner is the innermost frame in the executable that is not
+ * std:: or __gnu_cxx:: code, so a vector copy is charged to the function
+ * that copied it. The call stacks follow. Functions in the executable are
+ * resolved from its .symtab, so static functions are named too; frames in
+ * shared libraries are resolved with dladdr.
+ *
+ * Environment:
+ *   ALLOC_TRACE_DEPTH   frames per stack, 1..16 (default 8); 1 skips the
+ *                       unwinder and records only the immediate caller
+ *   ALLOC_TRACE_OUT     report file (default stderr)
+ *   ALLOC_TRACE_FORBID  if any function in a recorded stack has a name
+ *                       containing this string, say so and exit with
+ *                       status 86, e.g. "_compliant" to prove that the
+ *                       compliant twins do not allocate, directly or
+ *                       through helpers. Only the recorded frames are
+ *                       matched, so keep ALLOC_TRACE_DEPTH deep enough to
+ *                       reach the function from the allocator.
+ *
+ * The report is written from an atexit() handler, so a process that
+ * crashes or calls _exit() writes none.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <link.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unwind.h>
+
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t n, std::size_t size);
+void *__libc_realloc(void *p, std::size_t size);
+void *__libc_memalign(std::size_t align, std::size_t size);
+void __libc_free(void *p);
+}
+
+namespace {
+
+constexpr std::uint32_t kMaxDepth = 16u;
+constexpr std::uint32_t kDefaultDepth = 8u;
+constexpr std::size_t kSlots = 4096u;  // Distinct stacks per thread; a power of two
+constexpr int kForbiddenStatus = 86;
+
+/* Written only by the owning thread; key is published last so a reader
+ * that sees it also sees the frames. */
+struct site {
+    std::atomic<std::uint64_t> key;  // 0: empty
+    std::uint32_t depth;
+    std::uintptr_t frames[kMaxDepth];
+    std::atomic<std::uint64_t> allocs;
+    std::atomic<std::uint64_t> bytes;
+};
+
+struct thread_table {
+    site sites[kSlots];
+    std::atomic<std::uint64_t> untracked;  // Allocations that found the table full
+    std::atomic<bool> owned;                // Cleared when the owning thread exits
+    thread_table *next;
+};
+
+std::atomic<thread_table *> g_tables{nullptr};
+std::atomic<std::uint64_t> g_threads{0};
+pthread_once_t g_release_once = PTHREAD_ONCE_INIT;
+pthread_key_t g_release_key;
+bool g_release_ready = false;
+std::atomic<std::int64_t> g_live{0};
+std::atomic<std::int64_t> g_peak{0};
+std::atomic<std::uint64_t> g_frees{0};
+std::atomic<bool> g_reporting{false};
+std::uint32_t g_depth = kDefaultDepth;
+
+}  // namespace
+
+// This library's own image, so its frames can be skipped. Known from the
+// first allocation on, which comes before any constructor runs.
+extern "C" const char __ehdr_start __attribute__((visibility("hidden")));
+extern "C" const char _end __attribute__((visibility("hidden")));
+
+namespace {
+
+const std::uintptr_t g_self_begin = reinterpret_cast<std::uintptr_t>(&__ehdr_start);
+const std::uintptr_t g_self_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+// Initial-exec TLS: a dynamic TLS access could itself call malloc
+__thread thread_table *t_table __attribute__((tls_model("initial-exec"))) = nullptr;
+__thread bool t_busy __attribute__((tls_model("initial-exec"))) = false;
+
+// Thread exit: the table's counts stay in the report, and its next owner adds to them
+void release_table(void *table) {
+    t_table = nullptr;
+    static_cast<thread_table *>(table)->owned.store(false, std::memory_order_release);
+}
+
+void create_release_key() {
+    g_release_ready = pthread_key_create(&g_release_key, release_table) == 0;
+}
+
+// A table handed back by an exited thread, or nullptr
+thread_table *reuse_table() {
+    thread_table *t = g_tables.load(std::memory_order_acquire);
+    bool taken = false;
+    while ((t != nullptr) && !taken) {
+        bool owned = false;
+        taken = t->owned.compare_exchange_strong(owned, true, std::memory_order_acquire,
+                                                 std::memory_order_relaxed);
+        t = taken ? t : t->next;
+    }
+    return t;
+}
+
+// Called with t_busy set, so an allocation by pthread_setspecific is not traced
+thread_table *attach_table() {
+    thread_table *t = reuse_table();
+    if (t == nullptr) {
+        void *mem = mmap(nullptr, sizeof(thread_table), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        t = (mem == MAP_FAILED) ? nullptr : static_cast<thread_table *>(mem);
+        if (t != nullptr) {
+            t->owned.store(true, std::memory_order_relaxed);
+            t->next = g_tables.load(std::memory_order_relaxed);
+            while (!g_tables.compare_exchange_weak(t->next, t, std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+                // t->next reloaded by the failed exchange
+            }
+        }
+    }
+    if (t != nullptr) {
+        t_table = t;
+        g_threads.fetch_add(1u, std::memory_order_relaxed);
+        if ((pthread_once(&g_release_once, create_release_key) == 0) && g_release_ready) {
+            static_cast<void>(pthread_setspecific(g_release_key, t));  // On failure, never reused
+        }
+    }
+    return t;
+}
+
+struct unwind_state {
+    std::uintptr_t *frames;
+    std::uint32_t n;
+};
+
+_Unwind_Reason_Code collect_frame(_Unwind_Context *ctx, void *arg) {
+    unwind_state *s = static_cast<unwind_state *>(arg);
+    const std::uintptr_t ip = static_cast<std::uintptr_t>(_Unwind_GetIP(ctx));
+    _Unwind_Reason_Code code = _URC_NO_REASON;
+    if (ip == 0u) {
+        code = _URC_END_OF_STACK;
+    } else if ((ip < g_self_begin) || (ip >= g_self_end)) {
+        s->frames[s->n] = ip;
+        s->n += 1u;
+        code = (s->n == g_depth) ? _URC_END_OF_STACK : _URC_NO_REASON;
+    } else {
+        // One of this library's frames
+    }
+    return code;
+}
+
+std::uint64_t hash_stack(const std::uintptr_t *frames, std::uint32_t n) {
+    std::uint64_t h = 0xCBF29CE484222325u;
+    for (std::uint32_t i = 0u; i < n; ++i) {
+        h = (h ^ frames[i]) * 0x100000001B3u;
+        h ^= h >> 29;
+    }
+    return h | 1u;  // Never the empty key
+}
+
+void charge(thread_table *t, const std::uintptr_t *frames, std::uint32_t n, std::size_t bytes) {
+    const std::uint64_t key = hash_stack(frames, n);
+    bool done = false;
+    for (std::size_t probe = 0u; !done && (probe < kSlots); ++probe) {
+        site &s = t->sites[(key + probe) & (kSlots - 1u)];
+        const std::uint64_t k = s.key.load(std::memory_order_relaxed);
+        if (k == 0u) {
+            s.depth = n;
+            std::memcpy(s.frames, frames, n * sizeof(frames[0]));
+            s.key.store(key, std::memory_order_release);
+        }
+        if ((k == 0u) || (k == key)) {
+            s.allocs.store(s.allocs.load(std::memory_order_relaxed) + 1u,
+                           std::memory_order_relaxed);
+            s.bytes.store(s.bytes.load(std::memory_order_relaxed) + bytes,
+                          std::memory_order_relaxed);
+            done = true;
+        }
+    }
+    if (!done) {
+        t->untracked.store(t->untracked.load(std::memory_order_relaxed) + 1u,
+                           std::memory_order_relaxed);
+    }
+}
+
+void on_alloc(void *p, std::size_t bytes, void *caller) {
+    if (!g_reporting.load(std::memory_order_relaxed)) {
+        const std::int64_t usable = static_cast<std::int64_t>(malloc_usable_size(p));
+        const std::int64_t live = g_live.fetch_add(usable, std::memory_order_relaxed) + usable;
+        std::int64_t peak = g_peak.load(std::memory_order_relaxed);
+        while ((live > peak) &&
+               !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+            // peak reloaded by the failed exchange
+        }
+        if (!t_busy) {
+            t_busy = true;  // The unwinder may allocate; don't trace that
+            thread_table *t = (t_table != nullptr) ? t_table : attach_table();
+            std::uintptr_t frames[kMaxDepth];
+            unwind_state s = {frames, 0u};
+            if (g_depth > 1u) {
+                static_cast<void>(_Unwind_Backtrace(collect_frame, &s));
+            }
+            if (s.n == 0u) {
+                frames[0] = reinterpret_cast<std::uintptr_t>(caller);
+                s.n = 1u;
+            }
+            if (t != nullptr) {
+                charge(t, frames, s.n, bytes);
+            }
+            t_busy = false;
+        }
+    }
+}
+
+void on_free(void *p) {
+    if (!g_reporting.load(std::memory_order_relaxed)) {
+        g_live.fetch_sub(static_cast<std::int64_t>(malloc_usable_size(p)),
+                         std::memory_order_relaxed);
+        g_frees.fetch_add(1u, std::memory_order_relaxed);
+    }
+}
+
+void *new_or_throw(std::size_t size, void *caller) {
+    void *p = __libc_malloc((size == 0u) ? 1u : size);
+    while (p == nullptr) {
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+        p = __libc_malloc((size == 0u) ? 1u : size);
+    }
+    on_alloc(p, size, caller);
+    return p;
+}
+
+void *new_nothrow(std::size_t size, void *caller) noexcept {
+    void *p = __libc_malloc((size == 0u) ? 1u : size);
+    if (p != nullptr) {
+        on_alloc(p, size, caller);
+    }
+    return p;
+}
+
+void release(void *p) noexcept {
+    if (p != nullptr) {
+        on_free(p);
+        __libc_free(p);
+    }
+}
+
+/* ---- Symbolization ----------------------------------------------------- */
+
+std::string demangle(const char *name) {
+    int status = 0;
+    char *d = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    std::string out = (status == 0) && (d != nullptr) ? std::string(d) : std::string(name);
+    std::free(d);
+    return out;
+}
+
+std::string base_name(const char *path) {
+    const char *slash = std::strrchr(path, '/');
+    return (slash != nullptr) ? std::string(slash + 1) : std::string(path);
+}
+
+/** Functions of the main executable, from its .symtab. */
+class exe_symbols {
+public:
+    exe_symbols() {
+        static_cast<void>(dl_iterate_phdr(find_main, this));
+        load("/proc/self/exe");
+        char path[4096];
+        const ssize_t n = readlink("/proc/self/exe", path, sizeof(path) - 1u);
+        name_ = (n > 0) ? base_name(std::string(path, static_cast<std::size_t>(n)).c_str())
+                        : std::string("exe");
+    }
+
+    bool contains(std::uintptr_t ip) const {
+        bool in = false;
+        for (const auto &r : ranges_) {
+            in = in || ((ip >= r.first) && (ip < r.second));
+        }
+        return in;
+    }
+
+    /** Function containing ip, or "" if the symbol table has none. */
+    std::string lookup(std::uintptr_t ip) const {
+        std::string out;
+        const std::uintptr_t addr = ip - bias_;
+        auto it = std::upper_bound(funcs_.begin(), funcs_.end(), addr,
+                                   [](std::uintptr_t a, const func &f) { return a < f.begin; });
+        if (it != funcs_.begin()) {
+            --it;
+            if (addr < it->begin + it->size) {
+                out = demangle(it->name.c_str());
+            }
+        }
+        return out;
+    }
+
+    const std::string &name() const { return name_; }
+    std::uintptr_t offset(std::uintptr_t ip) const { return ip - bias_; }
+
+private:
+    struct func {
+        std::uintptr_t begin;
+        std::uintptr_t size;
+        std::string name;
+    };
+
+    static int find_main(dl_phdr_info *info, std::size_t, void *arg) {
+        exe_symbols *self = static_cast<exe_symbols *>(arg);
+        for (ElfW(Half) i = 0u; i < info->dlpi_phnum; ++i) {
+            const ElfW(Phdr) &ph = info->dlpi_phdr[i];
+            if (ph.p_type == PT_LOAD) {
+                const std::uintptr_t begin = info->dlpi_addr + ph.p_vaddr;
+                self->ranges_.emplace_back(begin, begin + ph.p_memsz);
+            }
+        }
+        self->bias_ = info->dlpi_addr;
+        return 1;  // The main program comes first; stop there
+    }
+
+    void load(const char *path) {
+        const int fd = open(path, O_RDONLY | O_CLOEXEC);
+        struct stat st;
+        if ((fd >= 0) && (fstat(fd, &st) == 0) &&
+            (static_cast<std::size_t>(st.st_size) >= sizeof(ElfW(Ehdr)))) {
+            const std::size_t len = static_cast<std::size_t>(st.st_size);
+            void *map = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                read_symtab(static_cast<const unsigned char *>(map), len);
+                static_cast<void>(munmap(map, len));
+            }
+        }
+        if (fd >= 0) {
+            static_cast<void>(close(fd));
+        }
+        std::sort(funcs_.begin(), funcs_.end(),
+                  [](const func &a, const func &b) { return a.begin < b.begin; });
+    }
+
+    void read_symtab(const unsigned char *base, std::size_t len) {
+        const ElfW(Ehdr) *eh = reinterpret_cast<const ElfW(Ehdr) *>(base);
+        const bool elf = (std::memcmp(eh->e_ident, ELFMAG, SELFMAG) == 0) &&
+                         (eh->e_shoff + eh->e_shnum * sizeof(ElfW(Shdr)) <= len);
+        const ElfW(Shdr) *sh = elf ? reinterpret_cast<const ElfW(Shdr) *>(base + eh->e_shoff)
+                                   : nullptr;
+        for (ElfW(Half) i = 0u; elf && (i < eh->e_shnum); ++i) {
+            if ((sh[i].sh_type == SHT_SYMTAB) && (sh[i].sh_link < eh->e_shnum)) {
+                const ElfW(Shdr) &strtab = sh[sh[i].sh_link];
+                if ((sh[i].sh_offset + sh[i].sh_size <= len) &&
+                    (strtab.sh_offset + strtab.sh_size <= len)) {
+                    const ElfW(Sym) *syms =
+                        reinterpret_cast<const ElfW(Sym) *>(base + sh[i].sh_offset);
+                    const char *names = reinterpret_cast<const char *>(base + strtab.sh_offset);
+                    const std::size_t count = sh[i].sh_size / sizeof(ElfW(Sym));
+                    for (std::size_t k = 0u; k < count; ++k) {
+                        if ((ELF64_ST_TYPE(syms[k].st_info) == STT_FUNC) &&
+                            (syms[k].st_value != 0u) && (syms[k].st_name < strtab.sh_size)) {
+                            funcs_.push_back(func{syms[k].st_value, syms[k].st_size,
+                                                  std::string(names + syms[k].st_name)});
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<std::uintptr_t, std::uintptr_t>> ranges_;
+    std::uintptr_t bias_ = 0u;
+    std::vector<func> funcs_;
+    std::string name_;
+};
+
+struct frame_info {
+    std::string function;  // Demangled, "" if unknown
+    std::string where;     // module+offset, for addr2line
+    bool in_exe;
+};
+
+frame_info describe(const exe_symbols &exe, std::uintptr_t ip) {
+    frame_info f;
+    const std::uintptr_t pc = ip - 1u;  // Inside the call, not after it
+    char buf[32];
+    f.in_exe = exe.contains(pc);
+    if (f.in_exe) {
+        f.function = exe.lookup(pc);
+        std::snprintf(buf, sizeof(buf), "+0x%lx", static_cast<unsigned long>(exe.offset(pc)));
+        f.where = exe.name() + buf;
+    } else {
+        Dl_info info;
+        if (dladdr(reinterpret_cast<void *>(pc), &info) != 0) {
+            const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+            f.function = (info.dli_sname != nullptr) ? demangle(info.dli_sname) : std::string();
+            std::snprintf(buf, sizeof(buf), "+0x%lx", static_cast<unsigned long>(pc - base));
+            f.where = ((info.dli_fname != nullptr) ? base_name(info.dli_fname) : "?") + buf;
+        } else {
+            std::snprintf(buf, sizeof(buf), "0x%lx", static_cast<unsigned long>(pc));
+            f.where = buf;
+        }
+    }
+    return f;
+}
+
+/** Library plumbing is charged to whoever called it. */
+bool is_plumbing(const std::string &function) {
+    const std::string head = function.substr(0u, function.find('('));
+    return (head.find("std::") != std::string::npos) ||
+           (head.find("__gnu_cxx::") != std::string::npos);
+}
+
+std::string short_name(const std::string &function) {
+    return function.substr(0u, function.find('('));
+}
+
+/* ---- Report ------------------------------------------------------------ */
+
+struct stack_total {
+    std::vector<std::uintptr_t> frames;
+    std::uint64_t allocs;
+    std::uint64_t bytes;
+};
+
+struct owner_total {
+    std::uint64_t allocs;
+    std::uint64_t bytes;
+};
+
+void write_report() {
+    g_reporting.store(true);
+    std::map<std::uint64_t, stack_total> stacks;
+    const std::uint64_t threads = g_threads.load(std::memory_order_relaxed);
+    std::uint64_t untracked = 0u;
+    for (thread_table *t = g_tables.load(std::memory_order_acquire); t != nullptr; t = t->next) {
+        untracked += t->untracked.load(std::memory_order_relaxed);
+        for (const site &s : t->sites) {
+            const std::uint64_t key = s.key.load(std::memory_order_acquire);
+            if (key != 0u) {
+                stack_total &total = stacks[key];
+                if (total.frames.empty()) {
+                    total.frames.assign(s.frames, s.frames + s.depth);
+                }
+                total.allocs += s.allocs.load(std::memory_order_relaxed);
+                total.bytes += s.bytes.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    const exe_symbols exe;
+    std::uint64_t allocs = 0u;
+    std::uint64_t bytes = 0u;
+    std::map<std::string, owner_total> owners;
+    std::vector<std::pair<const stack_total *, std::string>> order;
+    const char *forbid = std::getenv("ALLOC_TRACE_FORBID");
+    const bool check_forbid = (forbid != nullptr) && (forbid[0] != '\0');
+    std::set<std::string> forbidden;  // Matching functions anywhere in a stack
+    for (const auto &entry : stacks) {
+        const stack_total &s = entry.second;
+        std::string owner;
+        for (std::uintptr_t ip : s.frames) {
+            const frame_info f = describe(exe, ip);
+            if (owner.empty() && f.in_exe && !f.function.empty() && !is_plumbing(f.function)) {
+                owner = short_name(f.function);
+            }
+            if (check_forbid && (f.function.find(forbid) != std::string::npos)) {
+                forbidden.insert(short_name(f.function));
+            }
+        }
+        if (owner.empty()) {
+            const frame_info f = describe(exe, s.frames.front());
+            owner = f.function.empty() ? f.where : short_name(f.function);
+        }
+        owners[owner].allocs += s.allocs;
+        owners[owner].bytes += s.bytes;
+        allocs += s.allocs;
+        bytes += s.bytes;
+        order.emplace_back(&s, owner);
+    }
+    std::sort(order.begin(), order.end(), [](const auto &a, const auto &b) {
+        return a.first->bytes > b.first->bytes;
+    });
+
+    const char *path = std::getenv("ALLOC_TRACE_OUT");
+    std::FILE *out = (path != nullptr) ? std::fopen(path, "w") : stderr;
+    out = (out != nullptr) ? out : stderr;
+    std::fprintf(out,
+                 "alloc_trace: %s: %llu allocations, %llu bytes requested, %llu frees, "
+                 "peak live %lld bytes, %llu thread(s), %llu untracked\n",
+                 exe.name().c_str(), static_cast<unsigned long long>(allocs),
+                 static_cast<unsigned long long>(bytes),
+                 static_cast<unsigned long long>(g_frees.load()),
+                 static_cast<long long>(g_peak.load()), static_cast<unsigned long long>(threads),
+                 static_cast<unsigned long long>(untracked));
+    std::fprintf(out, "\n%-48s %10s %12s\n", "owner", "allocs", "bytes");
+    for (const auto &o : owners) {
+        std::fprintf(out, "%-48s %10llu %12llu\n", o.first.c_str(),
+                     static_cast<unsigned long long>(o.second.allocs),
+                     static_cast<unsigned long long>(o.second.bytes));
+    }
+    std::fprintf(out, "\ncall stacks (innermost first, up to %u frames)\n", g_depth);
+    for (const auto &entry : order) {
+        std::fprintf(out, "%10llu allocs %12llu bytes  %s\n",
+                     static_cast<unsigned long long>(entry.first->allocs),
+                     static_cast<unsigned long long>(entry.first->bytes), entry.second.c_str());
+        for (std::uintptr_t ip : entry.first->frames) {
+            const frame_info f = describe(exe, ip);
+            std::fprintf(out, "        at %s (%s)\n",
+                         f.function.empty() ? "?" : f.function.c_str(), f.where.c_str());
+        }
+    }
+
+    for (const std::string &name : forbidden) {
+        std::fprintf(out, "alloc_trace: FORBIDDEN allocation in %s\n", name.c_str());
+    }
+    if (out != stderr) {
+        static_cast<void>(std::fclose(out));
+    }
+    if (!forbidden.empty()) {
+        _exit(kForbiddenStatus);
+    }
+}
+
+__attribute__((constructor)) void start_tracing() {
+    const char *depth = std::getenv("ALLOC_TRACE_DEPTH");
+    if (depth != nullptr) {
+        const unsigned long d = std::strtoul(depth, nullptr, 10);
+        g_depth = static_cast<std::uint32_t>((d < 1u) ? 1u : ((d > kMaxDepth) ? kMaxDepth : d));
+    }
+    static_cast<void>(std::atexit(write_report));
+}
+
+}  // namespace
+
+/* ---- Interposed entry points ------------------------------------------- */
+
+extern "C" {
+
+void *malloc(std::size_t size) {
+    void *p = __libc_malloc(size);
+    if (p != nullptr) {
+        on_alloc(p, size, __builtin_return_address(0));
+    }
+    return p;
+}
+
+void *calloc(std::size_t n, std::size_t size) {
+    void *p = __libc_calloc(n, size);
+    if (p != nullptr) {
+        on_alloc(p, n * size, __builtin_return_address(0));
+    }
+    return p;
+}
+
+void *realloc(void *p, std::size_t size) {
+    const std::size_t old = (p != nullptr) ? malloc_usable_size(p) : 0u;
+    void *q = __libc_realloc(p, size);
+    if ((q != nullptr) || ((size == 0u) && (p != nullptr))) {
+        // The old block is gone (moved, resized in place, or freed by realloc(p, 0))
+        if (p != nullptr) {
+            g_live.fetch_sub(static_cast<std::int64_t>(old), std::memory_order_relaxed);
+        }
+        if (q != nullptr) {
+            on_alloc(q, size, __builtin_return_address(0));
+        }
+    }
+    return q;
+}
+
+void free(void *p) { release(p); }
+
+void *memalign(std::size_t align, std::size_t size) {
+    void *p = __libc_memalign(align, size);
+    if (p != nullptr) {
+        on_alloc(p, size, __builtin_return_address(0));
+    }
+    return p;
+}
+
+void *aligned_alloc(std::size_t align, std::size_t size) {
+    void *p = __libc_memalign(align, size);
+    if (p != nullptr) {
+        on_alloc(p, size, __builtin_return_address(0));
+    }
+    return p;
+}
+
+int posix_memalign(void **out, std::size_t align, std::size_t size) {
+    int err = 0;
+    if ((align < sizeof(void *)) || ((align & (align - 1u)) != 0u)) {
+        err = EINVAL;
+    } else {
+        void *p = __libc_memalign(align, size);
+        if (p == nullptr) {
+            err = ENOMEM;
+        } else {
+            on_alloc(p, size, __builtin_return_address(0));
+            *out = p;
+        }
+    }
+    return err;
+}
+
+void *valloc(std::size_t size) {
+    void *p = __libc_memalign(static_cast<std::size_t>(sysconf(_SC_PAGESIZE)), size);
+    if (p != nullptr) {
+        on_alloc(p, size, __builtin_return_address(0));
+    }
+    return p;
+}
+
+}  // extern "C"
+
+void *operator new(std::size_t size) { return new_or_throw(size, __builtin_return_address(0)); }
+void *operator new[](std::size_t size) { return new_or_throw(size, __builtin_return_address(0)); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return new_nothrow(size, __builtin_return_address(0));
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return new_nothrow(size, __builtin_return_address(0));
+}
+
+void operator delete(void *p) noexcept { release(p); }
+void operator delete[](void *p) noexcept { release(p); }
+void operator delete(void *p, std::size_t) noexcept { release(p); }
+void operator delete[](void *p, std::size_t) noexcept { release(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { release(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { release(p); }
@@ -0,0 +1,591 @@
+/**
+ * @file corpus_gen.cpp
+ * @brief Generate a scalable synthetic corpus from the example sources.
+ *
+ * The rule sections of the files under src/c or src/cpp (each starting at
+ * a "==== <STANDARD> <rule> ====" comment banner) are used as templates. Every generated
+ * translation unit instantiates a mix of rule sections and clean filler
+ * functions, with the top-level names of each section suffixed so the
+ * copies link together. The knobs:
+ *
+ *   --tus N             number of translation units
+ *   --sections S        functions per TU (rule sections + fillers)
+ *   --density D         fraction (0..1) of the S slots that are rule sections
+ *   --include-depth K   length of the per-TU header chain each TU includes
+ *   --cross-refs R      each TU calls/reads the exported symbols (e.g.
+ *                       misra_rule_8_4_func, misra_rule_8_7_global) of R
+ *                       other TUs through their headers
+ *
+ * The output directory gets tu_NNNN.{c,cpp}, include/, corpus_main and a
+ * Makefile, so it can be traced with `codeql database create --command=make`.
+ *
+ * Usage: corpus_gen --lang c|cpp --out DIR [options] [--src-root DIR]
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+struct options {
+    std::string lang = "c";
+    std::string out;
+    std::string src_root = ".";
+    unsigned tus = 10u;
+    unsigned sections = 8u;
+    double density = 0.5;
+    unsigned include_depth = 3u;
+    unsigned cross_refs = 2u;
+};
+
+/** A symbol other TUs may reference: an `int f(int)`/`int f()` or `int g = ...;`. */
+struct exported {
+    std::string name;
+    enum { function_int_arg, function_no_arg, global_int } kind;
+};
+
+struct section {
+    std::string banner;             // "MISRA C 2012 Rule 8.4 — ..." line
+    std::string body;               // Banner and code, verbatim
+    std::vector<std::string> names; // Top-level names defined in the body
+    std::vector<exported> exports;
+    std::vector<std::string> calls; // Statements from the file's main() that use it
+};
+
+struct template_set {
+    std::set<std::string> includes; // #include lines from the file prologues
+    std::vector<section> sections;
+};
+
+[[noreturn]] void die(const std::string &msg) {
+    std::fprintf(stderr, "corpus_gen: %s\n", msg.c_str());
+    std::exit(EXIT_FAILURE);
+}
+
+std::string read_file(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        die("cannot read " + path);
+    }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+void write_file(const std::string &path, const std::string &text) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out || !(out << text)) {
+        die("cannot write " + path);
+    }
+}
+
+void make_dir(const std::string &path) {
+    if ((mkdir(path.c_str(), 0755) != 0) && (errno != EEXIST)) {
+        die("cannot create " + path);
+    }
+}
+
+std::vector<std::string> split_lines(const std::string &text) {
+    std::vector<std::string> lines;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::vector<std::string> list_sources(const std::string &dir, const std::string &ext) {
+    std::vector<std::string> files;
+    DIR *d = opendir(dir.c_str());
+    if (d == nullptr) {
+        die("cannot open " + dir);
+    }
+    while (dirent *e = readdir(d)) {
+        std::string name = e->d_name;
+        if ((name.size() > ext.size()) &&
+            (name.compare(name.size() - ext.size(), ext.size(), ext) == 0)) {
+            files.push_back(dir + "/" + name);
+        }
+    }
+    closedir(d);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+bool is_ident_char(char c) {
+    return (std::isalnum(static_cast<unsigned char>(c)) != 0) || (c == '_');
+}
+
+/** Replace whole-word occurrences of every name in `renames`. */
+std::string rename_words(const std::string &text, const std::map<std::string, std::string> &renames) {
+    std::string out;
+    out.reserve(text.size() + 256u);
+    std::size_t i = 0u;
+    while (i < text.size()) {
+        if (is_ident_char(text[i]) && ((i == 0u) || !is_ident_char(text[i - 1u]))) {
+            std::size_t j = i;
+            while ((j < text.size()) && is_ident_char(text[j])) {
+                ++j;
+            }
+            std::string word = text.substr(i, j - i);
+            auto it = renames.find(word);
+            out += (it != renames.end()) ? it->second : word;
+            i = j;
+        } else {
+            out += text[i];
+            ++i;
+        }
+    }
+    return out;
+}
+
+std::set<std::string> words_in(const std::string &text) {
+    std::set<std::string> words;
+    std::size_t i = 0u;
+    while (i < text.size()) {
+        if (is_ident_char(text[i])) {
+            std::size_t j = i;
+            while ((j < text.size()) && is_ident_char(text[j])) {
+                ++j;
+            }
+            words.insert(text.substr(i, j - i));
+            i = j;
+        } else {
+            ++i;
+        }
+    }
+    return words;
+}
+
+/** Names declared at column 0: functions, globals, types, macros. */
+void collect_names(section &s) {
+    static const std::regex define_re(R"(^#define\s+(\w+))");
+    static const std::regex type_re(R"(^(?:struct|class|union|enum)\s+(\w+))");
+    static const std::regex macro_decl_re(R"(^[A-Z][A-Z0-9_]*\((\w+)\s*,)");
+    static const std::regex int_fn_re(R"(^int\s+(\w+)\s*\((int\s+\w+)?\)\s*\{)");
+    static const std::regex int_global_re(R"(^int\s+(\w+)\s*=\s*[^;]+;)");
+    static const std::set<std::string> keywords = {"if", "for", "while", "switch", "return",
+                                                   "sizeof", "main"};
+    std::set<std::string> seen;
+    for (const std::string &line : split_lines(s.body)) {
+        if (line.empty() || std::isspace(static_cast<unsigned char>(line[0])) ||
+            (line[0] == '/') || (line[0] == '*') || (line[0] == '}') || (line[0] == '{')) {
+            continue;
+        }
+        std::smatch m;
+        std::string name;
+        if (std::regex_search(line, m, define_re) || std::regex_search(line, m, type_re) ||
+            std::regex_search(line, m, macro_decl_re)) {
+            name = m[1];
+        } else if (line[0] != '#') {
+            // Identifier just before the first '(', '=' or ';'
+            std::size_t stop = line.find_first_of("(=;");
+            if (stop != std::string::npos) {
+                std::size_t end = stop;
+                while ((end > 0u) && std::isspace(static_cast<unsigned char>(line[end - 1u]))) {
+                    --end;
+                }
+                std::size_t begin = end;
+                while ((begin > 0u) && is_ident_char(line[begin - 1u])) {
+                    --begin;
+                }
+                name = line.substr(begin, end - begin);
+            }
+        }
+        if (!name.empty() && (keywords.count(name) == 0u) && seen.insert(name).second) {
+            s.names.push_back(name);
+        }
+        if (std::regex_search(line, m, int_fn_re)) {
+            s.exports.push_back({m[1], m[2].matched ? exported::function_int_arg
+                                                    : exported::function_no_arg});
+        } else if (std::regex_search(line, m, int_global_re)) {
+            s.exports.push_back({m[1], exported::global_int});
+        }
+    }
+}
+
+/** Split one example file into its rule sections and main() statements. */
+void parse_template(const std::string &path, template_set &out) {
+    std::vector<std::string> lines = split_lines(read_file(path));
+    std::vector<section> sections;
+    std::vector<std::string> main_body;
+    bool in_main_section = false;
+    bool in_main_body = false;
+    section *current = nullptr;
+
+    for (std::size_t i = 0u; i < lines.size(); ++i) {
+        const std::string &line = lines[i];
+        if ((current == nullptr) && !in_main_section && (line.rfind("#include", 0u) == 0u)) {
+            out.includes.insert(line);
+            continue;
+        }
+        if (line.rfind("/* ====", 0u) == 0u) {
+            std::string banner = (i + 1u < lines.size()) ? lines[i + 1u] : std::string();
+            banner.erase(0u, std::min(banner.find_first_not_of(" *"), banner.size()));
+            in_main_section = (banner.find("Helper:") == 0u);
+            if (in_main_section) {
+                current = nullptr;
+            } else {
+                sections.push_back(section());
+                current = &sections.back();
+                current->banner = banner;
+            }
+        }
+        if (in_main_section) {
+            if (line.rfind("int main", 0u) == 0u) {
+                in_main_body = true;
+            } else if (in_main_body && (line.rfind("}", 0u) == 0u)) {
+                in_main_body = false;
+            } else if (in_main_body) {
+                main_body.push_back(line);
+            }
+        } else if (current != nullptr) {
+            current->body += line;
+            current->body += '\n';
+        }
+    }
+
+    for (section &s : sections) {
+        collect_names(s);
+    }
+    // Attach each main() statement to the section whose names it uses.
+    // Statements that use none continue the previous statement's group
+    // (s.visible = 1 after autosar_a11_0_2_struct s;) or, after a blank
+    // line, open the next one (std::vector<int> v before autosar_a8_4_7(v)).
+    std::vector<std::string> pending;
+    section *last_owner = nullptr;
+    for (const std::string &stmt : main_body) {
+        std::string trimmed = stmt;
+        trimmed.erase(0u, std::min(trimmed.find_first_not_of(' '), trimmed.size()));
+        if (trimmed.empty()) {
+            last_owner = nullptr;
+            continue;
+        }
+        if ((trimmed.rfind("return", 0u) == 0u) || (trimmed.rfind("//", 0u) == 0u)) {
+            continue;
+        }
+        std::set<std::string> used = words_in(trimmed);
+        section *owner = nullptr;
+        for (section &s : sections) {
+            for (const std::string &n : s.names) {
+                if (used.count(n) != 0u) {
+                    owner = &s;
+                }
+            }
+        }
+        if ((owner == nullptr) && (last_owner != nullptr) && pending.empty()) {
+            last_owner->calls.push_back(trimmed);
+        } else if (owner == nullptr) {
+            pending.push_back(trimmed);
+        } else {
+            for (const std::string &p : pending) {
+                owner->calls.push_back(p);
+            }
+            pending.clear();
+            owner->calls.push_back(trimmed);
+            last_owner = owner;
+        }
+    }
+    for (section &s : sections) {
+        out.sections.push_back(std::move(s));
+    }
+}
+
+std::string pad(unsigned v) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%04u", v);
+    return buf;
+}
+
+struct tu_plan {
+    std::vector<std::size_t> sections; // Indices into template_set::sections
+    unsigned fillers = 0u;
+};
+
+std::string filler_function(const options &o, unsigned tu, unsigned i) {
+    std::ostringstream f;
+    const char *i32 = (o.lang == "c") ? "int32_t" : "std::int32_t";
+    f << "/* Clean filler (no expected findings) */\n"
+      << "static " << i32 << " corpus_filler_" << pad(tu) << "_" << i << "(" << i32 << " a) {\n"
+      << "    " << i32 << " r = a;\n"
+      << "    if (a > " << (i % 7u) << ") {\n"
+      << "        r = a - " << (i + 1u) << ";\n"
+      << "    } else {\n"
+      << "        r = a + " << (i + 2u) << ";\n"
+      << "    }\n"
+      << "    return r;\n"
+      << "}\n\n";
+    return f.str();
+}
+
+std::string exported_decl(const options &o, const exported &e, const std::string &name) {
+    std::string linkage = (o.lang == "c") ? "extern " : "";
+    std::string decl;
+    if (e.kind == exported::function_int_arg) {
+        decl = linkage + "int " + name + "(int a);\n";
+    } else if (e.kind == exported::function_no_arg) {
+        decl = linkage + "int " + name + (o.lang == "c" ? "(void);\n" : "();\n");
+    } else {
+        decl = "extern int " + name + ";\n";
+    }
+    return decl;
+}
+
+std::string exported_use(const options &o, const exported &e, const std::string &name) {
+    std::string use;
+    std::string cast_open = (o.lang == "c") ? "(void)" : "static_cast<void>(";
+    std::string cast_close = (o.lang == "c") ? "" : ")";
+    if (e.kind == exported::function_int_arg) {
+        use = cast_open + name + "(1)" + cast_close;
+    } else if (e.kind == exported::function_no_arg) {
+        use = cast_open + name + "()" + cast_close;
+    } else {
+        use = cast_open + name + cast_close;
+    }
+    return "    " + use + ";\n";
+}
+
+void generate(const options &o, const template_set &t) {
+    const bool is_c = (o.lang == "c");
+    const std::string ext = is_c ? ".c" : ".cpp";
+    const std::string void_params = is_c ? "void" : "";
+    make_dir(o.out);
+    make_dir(o.out + "/include");
+
+    // Shared prologue: every include the templates use, at the bottom of each chain
+    std::ostringstream common;
+    common << "/* Generated by corpus_gen: includes shared by all templates. */\n"
+           << "#ifndef CORPUS_COMMON_H\n#define CORPUS_COMMON_H\n\n";
+    if (is_c) {
+        common << "#include <stdint.h>\n";
+    } else {
+        common << "#include <cstdint>\n";
+    }
+    for (const std::string &inc : t.includes) {
+        common << inc << "\n";
+    }
+    common << "\n#endif\n";
+    write_file(o.out + "/include/corpus_common.h", common.str());
+
+    // Decide which rule sections and how many fillers each TU gets
+    const unsigned rule_slots =
+        static_cast<unsigned>(static_cast<double>(o.sections) * o.density + 0.5);
+    std::vector<tu_plan> plans(o.tus);
+    std::size_t next = 0u;
+    for (unsigned k = 0u; k < o.tus; ++k) {
+        std::set<std::size_t> used;
+        for (unsigned i = 0u; (i < rule_slots) && (used.size() < t.sections.size()); ++i) {
+            std::size_t idx = next % t.sections.size();
+            ++next;
+            if (used.insert(idx).second) {
+                plans[k].sections.push_back(idx);
+            }
+        }
+        plans[k].fillers = o.sections - static_cast<unsigned>(plans[k].sections.size());
+    }
+
+    std::size_t total_lines = 0u;
+    for (unsigned k = 0u; k < o.tus; ++k) {
+        const std::string sfx = "_tu" + pad(k);
+        std::map<std::string, std::string> renames;
+        for (std::size_t idx : plans[k].sections) {
+            for (const std::string &n : t.sections[idx].names) {
+                renames[n] = n + sfx;
+            }
+        }
+
+        // Public header: entry point plus this TU's exported symbols. The TU
+        // itself does not include it, so e.g. MISRA Rule 8.4 still applies.
+        std::ostringstream hdr;
+        std::string guard = "CORPUS_TU_" + pad(k) + "_H";
+        hdr << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+        if (!is_c) {
+            hdr << "void corpus_entry_" << pad(k) << "();\n";
+        } else {
+            hdr << "void corpus_entry_" << pad(k) << "(void);\n";
+        }
+        for (std::size_t idx : plans[k].sections) {
+            for (const exported &e : t.sections[idx].exports) {
+                hdr << exported_decl(o, e, e.name + sfx);
+            }
+        }
+        hdr << "\n#endif\n";
+        write_file(o.out + "/include/tu_" + pad(k) + ".h", hdr.str());
+
+        // Include chain: inc_k_1.h -> ... -> inc_k_D.h -> corpus_common.h
+        for (unsigned d = 1u; d <= o.include_depth; ++d) {
+            std::ostringstream inc;
+            std::string g = "CORPUS_INC_" + pad(k) + "_" + std::to_string(d) + "_H";
+            inc << "#ifndef " << g << "\n#define " << g << "\n\n";
+            inc << "#include \""
+                << ((d == o.include_depth) ? std::string("corpus_common.h")
+                                           : "inc_" + pad(k) + "_" + std::to_string(d + 1u) + ".h")
+                << "\"\n\n";
+            std::string i32 = is_c ? "int32_t" : "std::int32_t";
+            inc << "static inline " << i32 << " corpus_depth_" << pad(k) << "_" << d << "(" << i32
+                << " v) {\n    return v + " << d << ";\n}\n\n#endif\n";
+            write_file(o.out + "/include/inc_" + pad(k) + "_" + std::to_string(d) + ".h",
+                       inc.str());
+        }
+
+        std::ostringstream tu;
+        tu << "/* Generated by corpus_gen from the rule templates in src/. */\n\n";
+        if (o.include_depth > 0u) {
+            tu << "#include \"inc_" << pad(k) << "_1.h\"\n";
+        } else {
+            tu << "#include \"corpus_common.h\"\n";
+        }
+        std::vector<unsigned> refs;
+        for (unsigned r = 1u; (r <= o.cross_refs) && (r < o.tus); ++r) {
+            unsigned other = (k + r) % o.tus;
+            refs.push_back(other);
+            tu << "#include \"tu_" << pad(other) << ".h\"\n";
+        }
+        tu << "\n";
+        for (std::size_t idx : plans[k].sections) {
+            tu << rename_words(t.sections[idx].body, renames) << "\n";
+        }
+        for (unsigned i = 0u; i < plans[k].fillers; ++i) {
+            tu << filler_function(o, k, i);
+        }
+
+        tu << "void corpus_entry_" << pad(k) << "(" << void_params << ") {\n";
+        for (std::size_t idx : plans[k].sections) {
+            for (const std::string &call : t.sections[idx].calls) {
+                tu << "    " << rename_words(call, renames) << "\n";
+            }
+        }
+        for (unsigned i = 0u; i < plans[k].fillers; ++i) {
+            std::string arg = std::to_string(i);
+            if (o.include_depth > 0u) {
+                arg = "corpus_depth_" + pad(k) + "_1(" + arg + ")";
+            }
+            std::string call = "corpus_filler_" + pad(k) + "_" + std::to_string(i) + "(" + arg + ")";
+            tu << "    " << (is_c ? "(void)" + call : "static_cast<void>(" + call + ")") << ";\n";
+        }
+        for (unsigned other : refs) {
+            for (std::size_t idx : plans[other].sections) {
+                for (const exported &e : t.sections[idx].exports) {
+                    tu << exported_use(o, e, e.name + "_tu" + pad(other));
+                }
+            }
+        }
+        tu << "}\n";
+        std::string text = tu.str();
+        total_lines += static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+        write_file(o.out + "/tu_" + pad(k) + ext, text);
+    }
+
+    std::ostringstream main_src;
+    main_src << "/* Generated by corpus_gen: calls every TU's entry point. */\n\n";
+    for (unsigned k = 0u; k < o.tus; ++k) {
+        main_src << "#include \"tu_" << pad(k) << ".h\"\n";
+    }
+    main_src << "\nint main(" << void_params << ") {\n";
+    for (unsigned k = 0u; k < o.tus; ++k) {
+        main_src << "    corpus_entry_" << pad(k) << "();\n";
+    }
+    main_src << "    return 0;\n}\n";
+    write_file(o.out + "/corpus_main" + ext, main_src.str());
+
+    // The generated build mirrors the top-level Makefile's flags and links
+    // the compliant-alternative libraries the templates use.
+    char root[4096];
+    if (realpath(o.src_root.c_str(), root) == nullptr) {
+        die("cannot resolve " + o.src_root);
+    }
+    std::ostringstream mk;
+    mk << "# Generated by corpus_gen: " << o.tus << " TUs, " << o.sections
+       << " sections/TU, density " << o.density << ", include depth " << o.include_depth
+       << ", cross-refs " << o.cross_refs << "\n\n"
+       << "CC       = gcc\nCXX      = g++\n"
+       << "CPPFLAGS = -Iinclude -I" << root << "/include\n"
+       << "CFLAGS   = -std=c11 -Wall -Wextra\nCXXFLAGS = -std=c++14 -Wall -Wextra\n\n"
+       << "SRC     = $(wildcard tu_*" << ext << ") corpus_main" << ext << "\n"
+       << "OBJ     = $(SRC:" << ext << "=.o)\n"
+       << "LIB_SRC = $(wildcard " << root << "/lib/*.c)\n"
+       << "LIB_OBJ = $(patsubst " << root << "/lib/%.c,lib/%.o,$(LIB_SRC))\n\n"
+       << ".PHONY: all clean\n\nall: corpus\n\n"
+       << "corpus: $(OBJ) $(LIB_OBJ)\n\t$(" << (is_c ? "CC" : "CXX")
+       << ") -o $@ $^ -pthread\n\n"
+       << "%.o: %" << ext << "\n\t$(" << (is_c ? "CC" : "CXX") << ") $(CPPFLAGS) $("
+       << (is_c ? "CFLAGS" : "CXXFLAGS") << ") -c -o $@ $<\n\n"
+       << "lib/%.o: " << root << "/lib/%.c\n\t@mkdir -p lib\n"
+       << "\t$(CC) $(CPPFLAGS) $(CFLAGS) -c -o $@ $<\n\n"
+       << "clean:\n\trm -rf corpus $(OBJ) lib\n";
+    write_file(o.out + "/Makefile", mk.str());
+
+    // A TU holds each template section at most once
+    const std::size_t per_tu = std::min<std::size_t>(rule_slots, t.sections.size());
+    std::printf("%u TUs, %zu lines, %zu template sections, %zu rule sections/TU\n", o.tus,
+                total_lines, t.sections.size(), per_tu);
+}
+
+options parse_args(int argc, char **argv) {
+    options o;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (i + 1 >= argc) {
+            die("missing value for " + a);
+        }
+        std::string v = argv[++i];
+        if (a == "--lang") {
+            o.lang = v;
+        } else if (a == "--out") {
+            o.out = v;
+        } else if (a == "--src-root") {
+            o.src_root = v;
+        } else if (a == "--tus") {
+            o.tus = static_cast<unsigned>(std::strtoul(v.c_str(), nullptr, 10));
+        } else if (a == "--sections") {
+            o.sections = static_cast<unsigned>(std::strtoul(v.c_str(), nullptr, 10));
+        } else if (a == "--density") {
+            o.density = std::strtod(v.c_str(), nullptr);
+        } else if (a == "--include-depth") {
+            o.include_depth = static_cast<unsigned>(std::strtoul(v.c_str(), nullptr, 10));
+        } else if (a == "--cross-refs") {
+            o.cross_refs = static_cast<unsigned>(std::strtoul(v.c_str(), nullptr, 10));
+        } else {
+            die("unknown option " + a);
+        }
+    }
+    if (o.out.empty() || ((o.lang != "c") && (o.lang != "cpp")) || (o.tus == 0u) ||
+        (o.density < 0.0) || (o.density > 1.0)) {
+        die("usage: corpus_gen --lang c|cpp --out DIR [--tus N] [--sections S] [--density D]\n"
+            "                  [--include-depth K] [--cross-refs R] [--src-root DIR]");
+    }
+    return o;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    options o = parse_args(argc, argv);
+    template_set t;
+    std::string dir = o.src_root + "/src/" + o.lang;
+    for (const std::string &path : list_sources(dir, (o.lang == "c") ? ".c" : ".cpp")) {
+        parse_template(path, t);
+    }
+    if (t.sections.empty()) {
+        die("no rule sections found under " + dir);
+    }
+    generate(o, t);
+    return 0;
+}
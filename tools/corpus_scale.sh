@@ -0,0 +1,63 @@
+#!/bin/sh
+# Generate synthetic corpora of growing size and record how long a plain
+# build and (when the CodeQL CLI is on PATH) a traced database build take.
+#
+# Usage: tools/corpus_scale.sh [-l c|cpp] [-d density] [-i include_depth]
+#                              [-r cross_refs] [-s sections] [-o out_dir] N...
+#
+# Prints one CSV row per N: tus,lines,build_s,extract_s (extract_s is empty
+# without CodeQL). Corpora and databases are left under out_dir for inspection.
+
+set -eu
+
+lang=c
+density=0.5
+depth=3
+refs=2
+sections=8
+out=corpus
+gen="$(dirname "$0")/corpus_gen"
+root="$(cd "$(dirname "$0")/.." && pwd)"
+jobs="$(nproc 2>/dev/null || echo 1)"
+
+while getopts "l:d:i:r:s:o:" opt; do
+    case "$opt" in
+        l) lang="$OPTARG" ;;
+        d) density="$OPTARG" ;;
+        i) depth="$OPTARG" ;;
+        r) refs="$OPTARG" ;;
+        s) sections="$OPTARG" ;;
+        o) out="$OPTARG" ;;
+        *) exit 2 ;;
+    esac
+done
+shift $((OPTIND - 1))
+[ "$#" -gt 0 ] || { echo "usage: $0 [options] N..." >&2; exit 2; }
+
+now() { date +%s.%N; }
+elapsed() { awk "BEGIN { printf \"%.3f\", $2 - $1 }"; }
+
+mkdir -p "$out"
+echo "tus,lines,build_s,extract_s"
+for n in "$@"; do
+    dir="$out/$lang-$n"
+    rm -rf "$dir" "$dir.db"
+    "$gen" --lang "$lang" --out "$dir" --tus "$n" --sections "$sections" \
+        --density "$density" --include-depth "$depth" --cross-refs "$refs" \
+        --src-root "$root" >/dev/null
+    lines=$(cat "$dir"/tu_* | wc -l)
+
+    t0=$(now)
+    make -C "$dir" -j"$jobs" >"$dir/build.log" 2>&1
+    build=$(elapsed "$t0" "$(now)")
+
+    extract=
+    if command -v codeql >/dev/null 2>&1; then
+        make -C "$dir" clean >/dev/null
+        t0=$(now)
+        codeql database create "$dir.db" --language=cpp --source-root="$dir" \
+            --command="make -j$jobs" --overwrite >"$dir/extract.log" 2>&1
+        extract=$(elapsed "$t0" "$(now)")
+    fi
+    echo "$n,$lines,$build,$extract"
+done
@@ -0,0 +1,245 @@
+/**
+ * @file rule_manifest.hpp
+ * @brief Expected findings, read from the rule banners in src/.
+ *
+ * Every rule section in the example files opens with a "====" banner
+ * comment whose first line names the rule ("MISRA C 2012 Rule 8.4 — ...",
+ * "CERT C++ DCL50-CPP — ...") and runs to the next banner. The section
+ * is expected to produce a finding for that rule; a compliant twin, if present, starts at the
+ * section's "Compliant:" comment and is expected to produce none.
+ * Functions are located by their column-0 definition line and closing
+ * brace so findings can be attributed to them.
+ */
+
+#ifndef RULE_MANIFEST_HPP
+#define RULE_MANIFEST_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+
+namespace manifest {
+
+struct function {
+    std::string name;
+    std::uint32_t begin;  // Definition line (1-based)
+    std::uint32_t end;    // Closing-brace line
+};
+
+struct section {
+    std::string banner;             // "MISRA C 2012 Rule 8.4 — ..."
+    std::vector<std::string> keys;  // Standard keys, e.g. "misra/rule-8-4"
+    std::string file;               // "src/c/misra_violations.c"
+    std::uint32_t begin;            // Banner line
+    std::uint32_t end;              // Last line before the next banner
+    std::uint32_t compliant_begin;  // "Compliant:" comment line, 0 if none
+    std::string function;           // First function defined in the section
+};
+
+struct rule_manifest {
+    std::vector<section> sections;
+    std::map<std::string, std::vector<function>> functions;  // By file, sorted by line
+
+    /** Section of `file` containing `line`, or nullptr. */
+    const section *section_at(const std::string &file, std::uint32_t line) const {
+        const section *found = nullptr;
+        for (const section &s : sections) {
+            if ((s.file == file) && (line >= s.begin) && (line <= s.end)) {
+                found = &s;
+            }
+        }
+        return found;
+    }
+
+    /** Function of `file` whose body contains `line`, or nullptr. */
+    const function *function_at(const std::string &file, std::uint32_t line) const {
+        const function *found = nullptr;
+        auto it = functions.find(file);
+        if (it != functions.end()) {
+            const std::vector<function> &fns = it->second;
+            auto after = std::upper_bound(fns.begin(), fns.end(), line,
+                                          [](std::uint32_t l, const function &f) { return l < f.begin; });
+            if ((after != fns.begin()) && (line <= (after - 1)->end)) {
+                found = &*(after - 1);
+            }
+        }
+        return found;
+    }
+
+    /**
+     * Manifest file a SARIF URI refers to: the URI equals the file or ends
+     * with "/" + file. Empty when the URI is outside the manifest.
+     */
+    std::string file_for_uri(const std::string &uri) const {
+        std::string match;
+        for (const auto &entry : functions) {
+            const std::string &f = entry.first;
+            if ((uri == f) || ((uri.size() > f.size()) &&
+                               (uri.compare(uri.size() - f.size(), f.size(), f) == 0) &&
+                               (uri[uri.size() - f.size() - 1u] == '/'))) {
+                match = f;
+            }
+        }
+        return match;
+    }
+};
+
+namespace detail {
+
+inline std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    return s;
+}
+
+inline bool starts_with(const std::string &s, const char *prefix) {
+    return s.compare(0u, std::char_traits<char>::length(prefix), prefix) == 0;
+}
+
+inline bool is_ident(char c) {
+    return (std::isalnum(static_cast<unsigned char>(c)) != 0) || (c == '_');
+}
+
+/** Name defined by a column-0 function definition line, or empty. */
+inline std::string definition_name(const std::string &line) {
+    std::string name;
+    std::string trimmed = line.substr(0u, line.find_last_not_of(" \t\r") + 1u);
+    bool candidate = !trimmed.empty() && (is_ident(trimmed[0]) || (trimmed[0] == '~')) &&
+                     (trimmed.find('{') != std::string::npos) &&
+                     !starts_with(trimmed, "struct ") && !starts_with(trimmed, "class ") &&
+                     !starts_with(trimmed, "union ") && !starts_with(trimmed, "enum ") &&
+                     !starts_with(trimmed, "namespace ") && !starts_with(trimmed, "typedef ");
+    std::size_t stop = trimmed.find_first_of("(=;");
+    if (candidate && (stop != std::string::npos)) {
+        std::size_t end = stop;
+        while ((end > 0u) && (trimmed[end - 1u] == ' ')) {
+            --end;
+        }
+        std::size_t begin = end;
+        while ((begin > 0u) && is_ident(trimmed[begin - 1u])) {
+            --begin;
+        }
+        name = trimmed.substr(begin, end - begin);
+    }
+    return name;
+}
+
+}  // namespace detail
+
+/**
+ * Standard keys for a banner title, matching the "external/<std>/id/<rule>"
+ * tags of the CodeQL coding-standards packs. MISRA C++ rules are also
+ * reported by the AUTOSAR pack under their "m" id.
+ */
+inline std::vector<std::string> banner_keys(const std::string &banner) {
+    std::vector<std::string> keys;
+    std::string title = banner.substr(0u, banner.find(" \xE2\x80\x94"));  // Up to " —"
+    std::string id = detail::lower(title.substr(title.rfind(' ') + 1u));
+    if (detail::starts_with(title, "MISRA C++")) {
+        keys.push_back("misra/rule-" + id);
+        keys.push_back("autosar/m" + id);
+    } else if (detail::starts_with(title, "MISRA C")) {
+        std::replace(id.begin(), id.end(), '.', '-');
+        std::string kind = (title.find(" Dir ") != std::string::npos) ? "dir-" : "rule-";
+        keys.push_back("misra/" + kind + id);
+    } else if (detail::starts_with(title, "CERT")) {
+        keys.push_back("cert/" + id);
+    } else if (detail::starts_with(title, "AUTOSAR")) {
+        keys.push_back("autosar/" + id);
+    }
+    return keys;
+}
+
+/** Parse one example file; `rel` is its path as reported in SARIF URIs. */
+inline void load_file(const std::string &path, const std::string &rel, rule_manifest &out) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("cannot read " + path);
+    }
+    std::vector<function> &fns = out.functions[rel];
+    std::vector<section> found;
+    std::string line;
+    std::string previous;
+    function *open_fn = nullptr;
+    std::uint32_t n = 0u;
+    while (std::getline(in, line)) {
+        ++n;
+        if (!found.empty() && detail::starts_with(previous, "/* ====") &&
+            found.back().banner.empty()) {
+            found.back().banner = line.substr(std::min(line.find_first_not_of(" *"), line.size()));
+            found.back().keys = banner_keys(found.back().banner);
+        }
+        if (detail::starts_with(line, "/* ====")) {
+            if (!found.empty()) {
+                found.back().end = n - 1u;
+            }
+            found.push_back(section{"", {}, rel, n, n, 0u, ""});
+        } else if (!found.empty() && (found.back().compliant_begin == 0u) &&
+                   (detail::starts_with(line, "/* Compliant:") ||
+                    detail::starts_with(line, "// Compliant:"))) {
+            found.back().compliant_begin = n;
+        }
+        std::string name = detail::definition_name(line);
+        if ((open_fn == nullptr) && !name.empty()) {
+            fns.push_back(function{name, n, n});
+            std::size_t brace = line.find('{');
+            // One-line definitions close on the same line
+            if (line.find('}', brace) == std::string::npos) {
+                open_fn = &fns.back();
+            }
+            if (!found.empty() && found.back().function.empty()) {
+                found.back().function = name;
+            }
+        } else if ((open_fn != nullptr) && detail::starts_with(line, "}")) {
+            open_fn->end = n;
+            open_fn = nullptr;
+        }
+        previous = line;
+    }
+    if (!found.empty()) {
+        found.back().end = n;
+    }
+    for (section &s : found) {
+        if (!s.keys.empty()) {  // Skips the "Helper: entry point" section
+            out.sections.push_back(s);
+        }
+    }
+}
+
+/** Build the manifest from `<src_root>/src/{c,cpp}`; paths are relative to src_root. */
+inline rule_manifest load(const std::string &src_root) {
+    rule_manifest out;
+    for (const char *dir : {"src/c", "src/cpp"}) {
+        std::string full = src_root + "/" + dir;
+        DIR *d = opendir(full.c_str());
+        if (d == nullptr) {
+            throw std::runtime_error("cannot open " + full);
+        }
+        std::vector<std::string> names;
+        while (dirent *e = readdir(d)) {
+            std::string name = e->d_name;
+            std::size_t dot = name.rfind('.');
+            if ((dot != std::string::npos) &&
+                ((name.substr(dot) == ".c") || (name.substr(dot) == ".cpp"))) {
+                names.push_back(name);
+            }
+        }
+        closedir(d);
+        std::sort(names.begin(), names.end());
+        for (const std::string &name : names) {
+            load_file(full + "/" + name, std::string(dir) + "/" + name, out);
+        }
+    }
+    return out;
+}
+
+}  // namespace manifest
+
+#endif  // RULE_MANIFEST_HPP
@@ -0,0 +1,172 @@
+/**
+ * @file sarif_check.cpp
+ * @brief Check `codeql database analyze` output against the rule banners.
+ *
+ * Builds the expected-findings manifest from the banners in src/ (see
+ * rule_manifest.hpp), streams the given SARIF files through the mapped
+ * scanner (sarif_scan.hpp) and reports:
+ *
+ *   MISSING     a rule section with no finding for its rule, although a
+ *               query for that rule ran
+ *   TWIN        a finding for a section's rule inside its compliant twin
+ *   UNEXPECTED  any other finding (listed with --strict only)
+ *
+ * Usage: sarif_check [--src-root DIR] [--strict] [--manifest] FILE.sarif...
+ * Exit status: 0 clean, 1 mismatches, 2 usage or input error.
+ */
+
+#include "rule_manifest.hpp"
+#include "sarif_scan.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct options {
+    std::string src_root = ".";
+    bool strict = false;
+    bool print_manifest = false;
+    std::vector<std::string> inputs;
+};
+
+bool parse_args(int argc, char **argv, options &o) {
+    bool ok = true;
+    for (int i = 1; ok && (i < argc); ++i) {
+        std::string a = argv[i];
+        if ((a == "--src-root") && (i + 1 < argc)) {
+            o.src_root = argv[++i];
+        } else if (a == "--strict") {
+            o.strict = true;
+        } else if (a == "--manifest") {
+            o.print_manifest = true;
+        } else if ((a.size() > 1u) && (a[0] == '-')) {
+            ok = false;
+        } else {
+            o.inputs.push_back(a);
+        }
+    }
+    return ok && (o.print_manifest || !o.inputs.empty());
+}
+
+void print_manifest(const manifest::rule_manifest &m) {
+    for (const manifest::section &s : m.sections) {
+        std::printf("%-18s %s:%u-%u %s", s.keys.front().c_str(), s.file.c_str(), s.begin, s.end,
+                    s.function.c_str());
+        if (s.compliant_begin != 0u) {
+            std::printf(" (compliant from %u)", s.compliant_begin);
+        }
+        std::printf("\n");
+    }
+}
+
+bool has_key(const manifest::section &s, const std::string &key) {
+    return std::find(s.keys.begin(), s.keys.end(), key) != s.keys.end();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    options o;
+    if (!parse_args(argc, argv, o)) {
+        std::fprintf(stderr,
+                     "usage: sarif_check [--src-root DIR] [--strict] [--manifest] FILE.sarif...\n");
+        return 2;
+    }
+
+    int status = 0;
+    try {
+        manifest::rule_manifest m = manifest::load(o.src_root);
+        if (o.print_manifest) {
+            print_manifest(m);
+        }
+        if (o.inputs.empty()) {
+            return 0;
+        }
+
+        std::vector<bool> found(m.sections.size(), false);
+        std::set<std::string> analyzed;  // Standard keys of the rules that ran
+        std::uint64_t scanned = 0u;
+        std::uint64_t bytes = 0u;
+        std::uint64_t twins = 0u;
+        std::uint64_t unexpected = 0u;
+
+        for (const std::string &path : o.inputs) {
+            sarif::log log = sarif::load(path);
+            bytes += log.bytes;
+            scanned += log.results.size();
+            for (std::uint32_t k : log.rules) {
+                analyzed.insert(log.strings[k]);
+            }
+            // URIs repeat across results; resolve each distinct one once
+            std::vector<std::string> file_of(log.strings.size());
+            std::vector<bool> resolved(log.strings.size(), false);
+
+            for (const sarif::result &r : log.results) {
+                if (!resolved[r.uri]) {
+                    file_of[r.uri] = m.file_for_uri(log.strings[r.uri]);
+                    resolved[r.uri] = true;
+                }
+                const std::string &file = file_of[r.uri];
+                const std::string &key = log.strings[r.key];
+                const manifest::section *s = file.empty() ? nullptr : m.section_at(file, r.line);
+                bool own_rule = (s != nullptr) && has_key(*s, key);
+                bool in_twin = (s != nullptr) && (s->compliant_begin != 0u) &&
+                               (r.line >= s->compliant_begin);
+
+                if (own_rule && !in_twin) {
+                    found[static_cast<std::size_t>(s - m.sections.data())] = true;
+                } else if (own_rule) {
+                    ++twins;
+                    const manifest::function *f = m.function_at(file, r.line);
+                    std::printf("TWIN        %-18s %s:%u in %s\n", key.c_str(), file.c_str(),
+                                r.line, (f != nullptr) ? f->name.c_str() : "?");
+                } else {
+                    ++unexpected;
+                    if (o.strict) {
+                        std::printf("UNEXPECTED  %-18s %s:%u\n", key.c_str(),
+                                    log.strings[r.uri].c_str(), r.line);
+                    }
+                }
+            }
+        }
+
+        std::uint64_t missing = 0u;
+        std::uint64_t not_run = 0u;
+        for (std::size_t i = 0u; i < m.sections.size(); ++i) {
+            const manifest::section &s = m.sections[i];
+            bool ran = std::any_of(s.keys.begin(), s.keys.end(),
+                                   [&analyzed](const std::string &k) { return analyzed.count(k) != 0u; });
+            if (!ran) {
+                ++not_run;
+            } else if (!found[i]) {
+                ++missing;
+                std::printf("MISSING     %-18s %s:%u-%u (%s)\n", s.keys.front().c_str(),
+                            s.file.c_str(), s.begin, s.end, s.function.c_str());
+            }
+        }
+
+        std::fprintf(stderr,
+                     "%llu results in %.1f MB; %zu rule sections: %llu found, %llu missing, "
+                     "%llu not analysed; %llu twin findings, %llu other findings\n",
+                     static_cast<unsigned long long>(scanned), static_cast<double>(bytes) / 1e6,
+                     m.sections.size(),
+                     static_cast<unsigned long long>(m.sections.size() - missing - not_run),
+                     static_cast<unsigned long long>(missing),
+                     static_cast<unsigned long long>(not_run), static_cast<unsigned long long>(twins),
+                     static_cast<unsigned long long>(unexpected));
+        if ((missing != 0u) || (twins != 0u) || (o.strict && (unexpected != 0u))) {
+            status = 1;
+        }
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "sarif_check: %s\n", e.what());
+        status = 2;
+    }
+    return status;
+}
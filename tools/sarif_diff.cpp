@@ -0,0 +1,449 @@
+/**
+ * @file sarif_diff.cpp
+ * @brief Compare the findings of two or more analysis runs.
+ *
+ * Every result is indexed by (rule, file, function, line relative to the
+ * function start), so edits elsewhere in a file that only shift code do
+ * not show up as churn. Against the first run (the baseline), each later
+ * run reports:
+ *
+ *   +  added     key only in the later run
+ *   -  removed   key only in the baseline
+ *   ~  moved     same key at a different absolute line, or an unmatched
+ *                added/removed pair for the same rule and function
+ *
+ * Functions come from the manifest of the example sources (--src-root);
+ * results outside them are keyed by their absolute line. A run may span
+ * several files (one per pack): join them with commas. All files are
+ * scanned in parallel.
+ *
+ * Usage: sarif_diff [--src-root DIR] [--summary] [--threads N]
+ *                   BASE[,BASE2...] RUN[,RUN2...] [RUN...]
+ * Exit status: 0 identical, 1 differences, 2 usage or input error.
+ */
+
+#include "rule_manifest.hpp"
+#include "sarif_scan.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/** Index key; the ids index the global interner. */
+struct finding_key {
+    std::uint32_t rule;
+    std::uint32_t file;
+    std::uint32_t function;  // Interned name, "" outside known functions
+    std::uint32_t rel_line;  // Line minus function start, or absolute line
+
+    bool operator==(const finding_key &o) const noexcept {
+        return (rule == o.rule) && (file == o.file) && (function == o.function) &&
+               (rel_line == o.rel_line);
+    }
+};
+
+/** A key with its multiplicity and first absolute line in one run. */
+struct finding {
+    finding_key key;
+    std::uint32_t line;
+    std::uint32_t count;
+};
+
+/** Open-addressing multiset of findings: 24-byte entries behind 4-byte slots. */
+class finding_index {
+public:
+    explicit finding_index(std::size_t expected) {
+        std::size_t cap = 16u;
+        while (cap < (expected * 2u)) {
+            cap *= 2u;
+        }
+        slots_.assign(cap, 0u);
+        entries_.reserve(expected);
+    }
+
+    void add(const finding_key &k, std::uint32_t line) {
+        if ((entries_.size() + 1u) * 2u > slots_.size()) {
+            rehash(slots_.size() * 2u);
+        }
+        std::size_t i = probe(k);
+        if (slots_[i] == 0u) {
+            entries_.push_back(finding{k, line, 1u});
+            slots_[i] = static_cast<std::uint32_t>(entries_.size());
+        } else {
+            finding &f = entries_[slots_[i] - 1u];
+            f.count += 1u;
+            f.line = std::min(f.line, line);
+        }
+    }
+
+    const finding *find(const finding_key &k) const {
+        std::size_t i = probe(k);
+        return (slots_[i] == 0u) ? nullptr : &entries_[slots_[i] - 1u];
+    }
+
+    const std::vector<finding> &entries() const noexcept { return entries_; }
+
+private:
+    static std::uint64_t hash(const finding_key &k) noexcept {
+        std::uint64_t h = (static_cast<std::uint64_t>(k.rule) << 32u) ^ k.file;
+        h ^= ((static_cast<std::uint64_t>(k.function) << 32u) | k.rel_line) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29u;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 32u;
+        return h;
+    }
+
+    std::size_t probe(const finding_key &k) const noexcept {
+        std::size_t mask = slots_.size() - 1u;
+        std::size_t i = static_cast<std::size_t>(hash(k)) & mask;
+        while ((slots_[i] != 0u) && !(entries_[slots_[i] - 1u].key == k)) {
+            i = (i + 1u) & mask;
+        }
+        return i;
+    }
+
+    void rehash(std::size_t cap) {
+        slots_.assign(cap, 0u);
+        for (std::size_t e = 0u; e < entries_.size(); ++e) {
+            slots_[probe(entries_[e].key)] = static_cast<std::uint32_t>(e + 1u);
+        }
+    }
+
+    std::vector<std::uint32_t> slots_;  // 0 = empty, else entry index + 1
+    std::vector<finding> entries_;
+};
+
+struct options {
+    std::string src_root = ".";
+    bool summary = false;
+    unsigned threads = 0u;
+    std::vector<std::vector<std::string>> runs;
+    std::vector<std::string> names;
+};
+
+bool parse_args(int argc, char **argv, options &o) {
+    bool ok = true;
+    for (int i = 1; ok && (i < argc); ++i) {
+        std::string a = argv[i];
+        if ((a == "--src-root") && (i + 1 < argc)) {
+            o.src_root = argv[++i];
+        } else if (a == "--summary") {
+            o.summary = true;
+        } else if ((a == "--threads") && (i + 1 < argc)) {
+            o.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if ((a.size() > 1u) && (a[0] == '-')) {
+            ok = false;
+        } else {
+            std::vector<std::string> files;
+            std::size_t start = 0u;
+            while (start <= a.size()) {
+                std::size_t comma = std::min(a.find(',', start), a.size());
+                if (comma > start) {
+                    files.push_back(a.substr(start, comma - start));
+                }
+                start = comma + 1u;
+            }
+            o.runs.push_back(files);
+            o.names.push_back(a);
+        }
+    }
+    return ok && (o.runs.size() >= 2u);
+}
+
+/** Scan every file on a pool of threads; rethrows the first failure. */
+std::vector<sarif::log> load_all(const std::vector<std::string> &paths, unsigned threads) {
+    std::vector<sarif::log> logs(paths.size());
+    std::vector<std::exception_ptr> errors(paths.size());
+    std::atomic<std::size_t> next{0u};
+    auto worker = [&]() {
+        for (std::size_t i = next.fetch_add(1u); i < paths.size(); i = next.fetch_add(1u)) {
+            try {
+                logs[i] = sarif::load(paths[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1u; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &t : pool) {
+        t.join();
+    }
+    for (std::size_t i = 0u; i < paths.size(); ++i) {
+        if (errors[i]) {
+            try {
+                std::rethrow_exception(errors[i]);
+            } catch (const std::exception &e) {
+                throw std::runtime_error(paths[i] + ": " + e.what());
+            }
+        }
+    }
+    return logs;
+}
+
+struct change {
+    char kind;  // '+', '-', '~'
+    finding_key key;
+    std::uint32_t old_line;
+    std::uint32_t new_line;
+    std::uint32_t count;
+};
+
+struct rule_totals {
+    std::uint64_t base = 0u;
+    std::uint64_t run = 0u;
+    std::uint64_t added = 0u;
+    std::uint64_t removed = 0u;
+    std::uint64_t moved = 0u;
+};
+
+/** Pair leftover removals and additions in the same rule/file/function as moves. */
+void pair_moves(std::vector<change> &removed, std::vector<change> &added, std::uint32_t no_function,
+                std::vector<change> &moved) {
+    auto by_place = [](const change &a, const change &b) {
+        return std::tie(a.key.rule, a.key.file, a.key.function, a.old_line, a.new_line) <
+               std::tie(b.key.rule, b.key.file, b.key.function, b.old_line, b.new_line);
+    };
+    std::sort(removed.begin(), removed.end(), by_place);
+    std::sort(added.begin(), added.end(), by_place);
+    std::vector<change> rest_removed;
+    std::vector<change> rest_added;
+    std::size_t r = 0u;
+    std::size_t a = 0u;
+    while ((r < removed.size()) || (a < added.size())) {
+        bool take_r = (a == added.size());
+        bool take_a = (r == removed.size());
+        if (!take_r && !take_a) {
+            const finding_key &rk = removed[r].key;
+            const finding_key &ak = added[a].key;
+            auto rp = std::tie(rk.rule, rk.file, rk.function);
+            auto ap = std::tie(ak.rule, ak.file, ak.function);
+            if (rp < ap) {
+                take_r = true;
+            } else if (ap < rp) {
+                take_a = true;
+            } else if (rk.function == no_function) {
+                take_r = true;  // Outside known functions a line change is not a move
+            } else {
+                std::uint32_t n = std::min(removed[r].count, added[a].count);
+                moved.push_back(change{'~', ak, removed[r].old_line, added[a].new_line, n});
+                removed[r].count -= n;
+                added[a].count -= n;
+                r += (removed[r].count == 0u) ? 1u : 0u;
+                a += (added[a].count == 0u) ? 1u : 0u;
+            }
+        }
+        if (take_r) {
+            rest_removed.push_back(removed[r++]);
+        } else if (take_a) {
+            rest_added.push_back(added[a++]);
+        }
+    }
+    removed.swap(rest_removed);
+    added.swap(rest_added);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    options o;
+    if (!parse_args(argc, argv, o)) {
+        std::fprintf(stderr, "usage: sarif_diff [--src-root DIR] [--summary] [--threads N] "
+                             "BASE[,BASE2...] RUN[,RUN2...] [RUN...]\n");
+        return 2;
+    }
+
+    int status = 0;
+    try {
+        // Functions are only known for the example sources; elsewhere keys use absolute lines
+        manifest::rule_manifest m;
+        try {
+            m = manifest::load(o.src_root);
+        } catch (const std::exception &) {
+            m = manifest::rule_manifest();
+        }
+
+        std::vector<std::string> paths;
+        std::vector<std::size_t> run_of;
+        for (std::size_t r = 0u; r < o.runs.size(); ++r) {
+            for (const std::string &p : o.runs[r]) {
+                paths.push_back(p);
+                run_of.push_back(r);
+            }
+        }
+        unsigned threads = (o.threads != 0u) ? o.threads : std::thread::hardware_concurrency();
+        threads = std::max(1u, std::min(threads, static_cast<unsigned>(paths.size())));
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<sarif::log> logs = load_all(paths, threads);
+
+        // Re-key every log's strings into one interner; the per-log tables are small
+        sarif::interner names;
+        const std::uint32_t no_function = names.intern("", 0u);
+        std::vector<std::size_t> sizes(o.runs.size(), 0u);
+        for (std::size_t i = 0u; i < logs.size(); ++i) {
+            sizes[run_of[i]] += logs[i].results.size();
+        }
+        std::unordered_map<const manifest::function *, std::uint32_t> function_ids;
+        std::vector<finding_index> index;
+        for (std::size_t r = 0u; r < o.runs.size(); ++r) {
+            index.emplace_back(sizes[r]);
+        }
+        std::uint64_t total = 0u;
+        for (std::size_t i = 0u; i < logs.size(); ++i) {
+            const sarif::log &log = logs[i];
+            std::vector<std::uint32_t> global(log.strings.size(), UINT32_MAX);
+            auto map = [&](std::uint32_t id) {
+                if (global[id] == UINT32_MAX) {
+                    global[id] = names.intern(log.strings[id]);
+                }
+                return global[id];
+            };
+            // Resolve each distinct URI to a manifest file once
+            std::vector<std::string> file_of(log.strings.size());
+            std::vector<std::uint32_t> file_id(log.strings.size(), UINT32_MAX);
+            for (const sarif::result &res : log.results) {
+                if (file_id[res.uri] == UINT32_MAX) {
+                    file_of[res.uri] = m.file_for_uri(log.strings[res.uri]);
+                    file_id[res.uri] = file_of[res.uri].empty() ? map(res.uri)
+                                                                : names.intern(file_of[res.uri]);
+                }
+                const std::string &file = file_of[res.uri];
+                finding_key k{map(res.key), file_id[res.uri], no_function, res.line};
+                const manifest::function *f = file.empty() ? nullptr : m.function_at(file, res.line);
+                if (f != nullptr) {
+                    auto it = function_ids.find(f);
+                    if (it == function_ids.end()) {
+                        it = function_ids.emplace(f, names.intern(f->name)).first;
+                    }
+                    k.function = it->second;
+                    k.rel_line = res.line - f->begin;
+                }
+                index[run_of[i]].add(k, res.line);
+            }
+            total += log.results.size();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::fprintf(stderr, "indexed %llu results from %zu files on %u threads in %.2f s\n",
+                     static_cast<unsigned long long>(total), paths.size(), threads, seconds);
+
+        const finding_index &base = index[0];
+        for (std::size_t r = 1u; r < o.runs.size(); ++r) {
+            const finding_index &run = index[r];
+            std::vector<change> added;
+            std::vector<change> removed;
+            std::vector<change> moved;
+            std::map<std::uint32_t, rule_totals> totals;
+
+            for (const finding &b : base.entries()) {
+                totals[b.key.rule].base += b.count;
+                const finding *n = run.find(b.key);
+                std::uint32_t both = (n != nullptr) ? std::min(n->count, b.count) : 0u;
+                if ((n != nullptr) && (n->line != b.line)) {
+                    moved.push_back(change{'~', b.key, b.line, n->line, both});
+                }
+                if (b.count > both) {
+                    removed.push_back(change{'-', b.key, b.line, b.line, b.count - both});
+                }
+            }
+            for (const finding &n : run.entries()) {
+                totals[n.key.rule].run += n.count;
+                const finding *b = base.find(n.key);
+                std::uint32_t both = (b != nullptr) ? std::min(n.count, b->count) : 0u;
+                if (n.count > both) {
+                    added.push_back(change{'+', n.key, n.line, n.line, n.count - both});
+                }
+            }
+            pair_moves(removed, added, no_function, moved);
+
+            std::vector<change> all;
+            all.insert(all.end(), removed.begin(), removed.end());
+            all.insert(all.end(), added.begin(), added.end());
+            all.insert(all.end(), moved.begin(), moved.end());
+            std::sort(all.begin(), all.end(), [&names](const change &a, const change &b) {
+                return std::make_tuple(names[a.key.rule], names[a.key.file], a.new_line, a.kind) <
+                       std::make_tuple(names[b.key.rule], names[b.key.file], b.new_line, b.kind);
+            });
+
+            std::printf("== %s -> %s\n", o.names[0].c_str(), o.names[r].c_str());
+            for (const change &c : all) {
+                rule_totals &t = totals[c.key.rule];
+                if (c.kind == '+') {
+                    t.added += c.count;
+                } else if (c.kind == '-') {
+                    t.removed += c.count;
+                } else {
+                    t.moved += c.count;
+                }
+                if (!o.summary) {
+                    std::printf("%c %-22s %s:", c.kind, names[c.key.rule].c_str(),
+                                names[c.key.file].c_str());
+                    if (c.kind == '~') {
+                        std::printf("%u -> %u", c.old_line, c.new_line);
+                    } else {
+                        std::printf("%u", c.new_line);
+                    }
+                    if (c.key.function != no_function) {
+                        std::printf(" in %s", names[c.key.function].c_str());
+                    }
+                    if (c.count > 1u) {
+                        std::printf(" (x%u)", c.count);
+                    }
+                    std::printf("\n");
+                }
+            }
+            if (o.summary) {
+                std::printf("%-26s %8s %8s %8s %8s %8s\n", "rule", "base", "run", "added",
+                            "removed", "moved");
+                std::vector<std::pair<std::string, rule_totals>> rows;
+                for (const auto &t : totals) {
+                    rows.emplace_back(names[t.first], t.second);
+                }
+                std::sort(rows.begin(), rows.end(),
+                          [](const std::pair<std::string, rule_totals> &a,
+                             const std::pair<std::string, rule_totals> &b) { return a.first < b.first; });
+                for (const auto &row : rows) {
+                    const rule_totals &t = row.second;
+                    if ((t.added + t.removed + t.moved) != 0u) {
+                        std::printf("%-26s %8llu %8llu %8llu %8llu %8llu\n", row.first.c_str(),
+                                    static_cast<unsigned long long>(t.base),
+                                    static_cast<unsigned long long>(t.run),
+                                    static_cast<unsigned long long>(t.added),
+                                    static_cast<unsigned long long>(t.removed),
+                                    static_cast<unsigned long long>(t.moved));
+                    }
+                }
+            }
+            auto sum = [](const std::vector<change> &v) {
+                std::uint64_t n = 0u;
+                for (const change &c : v) {
+                    n += c.count;
+                }
+                return static_cast<unsigned long long>(n);
+            };
+            std::printf("%llu added, %llu removed, %llu moved\n", sum(added), sum(removed),
+                        sum(moved));
+            if (!all.empty()) {
+                status = 1;
+            }
+        }
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "sarif_diff: %s\n", e.what());
+        status = 2;
+    }
+    return status;
+}
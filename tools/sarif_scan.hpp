@@ -0,0 +1,614 @@
+/**
+ * @file sarif_scan.hpp
+ * @brief Streaming, zero-copy extraction of results from SARIF files.
+ *
+ * The file is memory-mapped and walked once by a recursive-descent scanner
+ * that only descends into the members it needs (runs[].results[] and the
+ * rule metadata under runs[].tool); every other value is skipped without
+ * being decoded. Nothing resembling a DOM is built, so memory use is the
+ * compact result table plus whatever pages the kernel keeps cached.
+ *
+ * Per result, the scanner keeps the rule id, the first location's URI and
+ * start line. Rule ids are resolved to coding-standard keys such as
+ * "misra/rule-8-4" or "cert/str31-c" through the rule's
+ * "external/<standard>/id/<rule>" tag; ids without such a tag are kept
+ * as-is.
+ */
+
+#ifndef SARIF_SCAN_HPP
+#define SARIF_SCAN_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sarif {
+
+/** Malformed input; what() includes the byte offset. */
+class parse_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/** Read-only memory mapping of a whole file, advised for sequential access. */
+class mapped_file {
+public:
+    explicit mapped_file(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0u) {
+            void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), path);
+            }
+            static_cast<void>(::madvise(p, size_, MADV_SEQUENTIAL));
+            data_ = static_cast<const char *>(p);
+        }
+        ::close(fd);
+    }
+    ~mapped_file() {
+        if (data_ != nullptr) {
+            static_cast<void>(::munmap(const_cast<char *>(data_), size_));
+        }
+    }
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    const char *data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+    /**
+     * Drop the pages wholly before `p` from this process. The scan never
+     * goes back, so resident memory stays bounded on multi-GB inputs.
+     */
+    void release_before(const char *p) noexcept {
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        std::size_t upto = (static_cast<std::size_t>(p - data_) / page) * page;
+        if (upto > released_) {
+            static_cast<void>(::madvise(const_cast<char *>(data_) + released_, upto - released_,
+                                        MADV_DONTNEED));
+            released_ = upto;
+        }
+    }
+
+private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0u;
+    std::size_t released_ = 0u;
+};
+
+/** A view into the mapped file; `escaped` means it still holds JSON escapes. */
+struct slice {
+    const char *ptr;
+    std::size_t len;
+    bool escaped;
+
+    bool operator==(const char *lit) const noexcept {
+        std::size_t n = std::strlen(lit);
+        return (n == len) && (std::memcmp(ptr, lit, n) == 0);
+    }
+};
+
+inline std::uint64_t hash_bytes(const char *p, std::size_t n) noexcept {
+    std::uint64_t h = 14695981039346656037ull;  // FNV-1a
+    for (std::size_t i = 0u; i < n; ++i) {
+        h = (h ^ static_cast<unsigned char>(p[i])) * 1099511628211ull;
+    }
+    return h;
+}
+
+/** Maps distinct strings to dense 32-bit ids (open addressing, linear probing). */
+class interner {
+public:
+    interner() : slots_(64u, 0u) {}
+
+    std::uint32_t intern(const char *p, std::size_t n) {
+        if ((values_.size() + 1u) * 2u > slots_.size()) {
+            grow();
+        }
+        std::size_t mask = slots_.size() - 1u;
+        std::size_t i = static_cast<std::size_t>(hash_bytes(p, n)) & mask;
+        for (;;) {
+            std::uint32_t s = slots_[i];
+            if (s == 0u) {
+                values_.emplace_back(p, n);
+                slots_[i] = static_cast<std::uint32_t>(values_.size());
+                return static_cast<std::uint32_t>(values_.size() - 1u);
+            }
+            const std::string &v = values_[s - 1u];
+            if ((v.size() == n) && (std::memcmp(v.data(), p, n) == 0)) {
+                return s - 1u;
+            }
+            i = (i + 1u) & mask;
+        }
+    }
+    std::uint32_t intern(const std::string &s) { return intern(s.data(), s.size()); }
+
+    const std::string &operator[](std::uint32_t id) const { return values_[id]; }
+    std::size_t size() const noexcept { return values_.size(); }
+
+private:
+    void grow() {
+        std::vector<std::uint32_t> bigger(slots_.size() * 2u, 0u);
+        std::size_t mask = bigger.size() - 1u;
+        for (std::uint32_t id = 0u; id < values_.size(); ++id) {
+            const std::string &v = values_[id];
+            std::size_t i = static_cast<std::size_t>(hash_bytes(v.data(), v.size())) & mask;
+            while (bigger[i] != 0u) {
+                i = (i + 1u) & mask;
+            }
+            bigger[i] = id + 1u;
+        }
+        slots_.swap(bigger);
+    }
+
+    std::vector<std::string> values_;
+    std::vector<std::uint32_t> slots_;
+};
+
+/** Pull-style JSON reader over a byte range; values it is not asked for are skipped. */
+class json_cursor {
+public:
+    json_cursor(const char *begin, const char *end) noexcept : base_(begin), p_(begin), end_(end) {}
+
+    /** Next non-whitespace byte, or 0 at end of input. */
+    char peek() noexcept {
+        while ((p_ < end_) && ((*p_ == ' ') || (*p_ == '\n') || (*p_ == '\r') || (*p_ == '\t'))) {
+            ++p_;
+        }
+        return (p_ < end_) ? *p_ : '\0';
+    }
+
+    slice string() {
+        expect('"');
+        const char *start = p_;
+        bool escaped = false;
+        for (;;) {
+            const void *q = std::memchr(p_, '"', static_cast<std::size_t>(end_ - p_));
+            if (q == nullptr) {
+                fail("unterminated string");
+            }
+            const char *quote = static_cast<const char *>(q);
+            const char *b = quote;
+            while ((b > start) && (b[-1] == '\\')) {
+                --b;
+            }
+            p_ = quote + 1;
+            if (((quote - b) % 2) == 0) {
+                std::size_t len = static_cast<std::size_t>(quote - start);
+                escaped = escaped || (std::memchr(start, '\\', len) != nullptr);
+                return slice{start, len, escaped};
+            }
+            escaped = true;
+        }
+    }
+
+    std::int64_t integer() {
+        peek();
+        bool negative = (p_ < end_) && (*p_ == '-');
+        if (negative) {
+            ++p_;
+        }
+        if ((p_ >= end_) || (*p_ < '0') || (*p_ > '9')) {
+            fail("expected integer");
+        }
+        std::int64_t v = 0;
+        while ((p_ < end_) && (*p_ >= '0') && (*p_ <= '9')) {
+            v = (v * 10) + (*p_ - '0');
+            ++p_;
+        }
+        if ((p_ < end_) && ((*p_ == '.') || (*p_ == 'e') || (*p_ == 'E'))) {
+            skip_scalar();
+        }
+        return negative ? -v : v;
+    }
+
+    /** Skip one value of any type without decoding it. */
+    void skip() {
+        char c = peek();
+        if (c == '"') {
+            static_cast<void>(string());
+        } else if ((c == '{') || (c == '[')) {
+            std::size_t depth = 0u;
+            while (p_ < end_) {
+                char d = *p_;
+                if (d == '"') {
+                    static_cast<void>(string());
+                    continue;
+                }
+                ++p_;
+                if ((d == '{') || (d == '[')) {
+                    ++depth;
+                } else if ((d == '}') || (d == ']')) {
+                    --depth;
+                    if (depth == 0u) {
+                        return;
+                    }
+                }
+            }
+            fail("unterminated container");
+        } else {
+            skip_scalar();
+        }
+    }
+
+    /**
+     * Visit each member of an object; `on_member(key)` must consume the
+     * value. A non-object value is skipped and false returned.
+     */
+    template <typename F>
+    bool object(F on_member) {
+        if (peek() != '{') {
+            skip();
+            return false;
+        }
+        ++p_;
+        if (peek() == '}') {
+            ++p_;
+            return true;
+        }
+        for (;;) {
+            slice key = string();
+            expect(':');
+            on_member(key);
+            char c = peek();
+            ++p_;
+            if (c == '}') {
+                return true;
+            }
+            if (c != ',') {
+                fail("expected ',' or '}'");
+            }
+        }
+    }
+
+    /** Visit each element of an array; `on_element(index)` must consume it. */
+    template <typename F>
+    bool array(F on_element) {
+        if (peek() != '[') {
+            skip();
+            return false;
+        }
+        ++p_;
+        if (peek() == ']') {
+            ++p_;
+            return true;
+        }
+        for (std::size_t i = 0u;; ++i) {
+            on_element(i);
+            char c = peek();
+            ++p_;
+            if (c == ']') {
+                return true;
+            }
+            if (c != ',') {
+                fail("expected ',' or ']'");
+            }
+        }
+    }
+
+    const char *position() const noexcept { return p_; }
+
+    [[noreturn]] void fail(const char *what) const {
+        throw parse_error(std::string(what) + " at byte " +
+                          std::to_string(static_cast<long long>(p_ - base_)));
+    }
+
+private:
+    void expect(char c) {
+        if (peek() != c) {
+            std::string msg = "expected '";
+            msg += c;
+            msg += "'";
+            fail(msg.c_str());
+        }
+        ++p_;
+    }
+
+    void skip_scalar() {
+        while ((p_ < end_) && (*p_ != ',') && (*p_ != '}') && (*p_ != ']') && (*p_ != ' ') &&
+               (*p_ != '\n') && (*p_ != '\r') && (*p_ != '\t')) {
+            ++p_;
+        }
+    }
+
+    const char *base_;
+    const char *p_;
+    const char *end_;
+};
+
+/** Decode JSON escapes; slices without escapes are copied unchanged. */
+inline std::string unescape(const slice &s) {
+    std::string out;
+    out.reserve(s.len);
+    for (std::size_t i = 0u; i < s.len; ++i) {
+        char c = s.ptr[i];
+        if ((c != '\\') || (i + 1u >= s.len)) {
+            out += c;
+            continue;
+        }
+        char e = s.ptr[++i];
+        if (e == 'n') {
+            out += '\n';
+        } else if (e == 't') {
+            out += '\t';
+        } else if (e == 'r') {
+            out += '\r';
+        } else if (e == 'b') {
+            out += '\b';
+        } else if (e == 'f') {
+            out += '\f';
+        } else if ((e == 'u') && (i + 4u < s.len)) {
+            unsigned long cp = std::strtoul(std::string(s.ptr + i + 1u, 4u).c_str(), nullptr, 16);
+            i += 4u;
+            if ((cp >= 0xD800u) && (cp < 0xDC00u) && (i + 6u < s.len) && (s.ptr[i + 1u] == '\\') &&
+                (s.ptr[i + 2u] == 'u')) {
+                unsigned long lo =
+                    std::strtoul(std::string(s.ptr + i + 3u, 4u).c_str(), nullptr, 16);
+                cp = 0x10000u + ((cp - 0xD800u) << 10u) + (lo - 0xDC00u);
+                i += 6u;
+            }
+            if (cp < 0x80u) {
+                out += static_cast<char>(cp);
+            } else if (cp < 0x800u) {
+                out += static_cast<char>(0xC0u | (cp >> 6u));
+                out += static_cast<char>(0x80u | (cp & 0x3Fu));
+            } else if (cp < 0x10000u) {
+                out += static_cast<char>(0xE0u | (cp >> 12u));
+                out += static_cast<char>(0x80u | ((cp >> 6u) & 0x3Fu));
+                out += static_cast<char>(0x80u | (cp & 0x3Fu));
+            } else {
+                out += static_cast<char>(0xF0u | (cp >> 18u));
+                out += static_cast<char>(0x80u | ((cp >> 12u) & 0x3Fu));
+                out += static_cast<char>(0x80u | ((cp >> 6u) & 0x3Fu));
+                out += static_cast<char>(0x80u | (cp & 0x3Fu));
+            }
+        } else {
+            out += e;  // \" \\ \/
+        }
+    }
+    return out;
+}
+
+/** One finding; the ids index sarif_log::strings. */
+struct result {
+    std::uint32_t rule_id;  // ruleId as written in the SARIF
+    std::uint32_t key;      // Coding-standard key, or rule_id when untagged
+    std::uint32_t uri;      // First location, "file://" stripped
+    std::uint32_t line;     // First location's startLine, 0 if absent
+};
+
+struct log {
+    interner strings;
+    std::vector<result> results;
+    std::vector<std::uint32_t> rules;  // Keys of the rules the tool declared (ran)
+    std::uint64_t bytes = 0u;
+};
+
+namespace detail {
+
+inline std::uint32_t intern_slice(interner &strings, const slice &s) {
+    std::uint32_t id;
+    if (s.escaped) {
+        id = strings.intern(unescape(s));
+    } else {
+        id = strings.intern(s.ptr, s.len);
+    }
+    return id;
+}
+
+/** "external/misra/id/rule-8-4" -> "misra/rule-8-4"; empty if not a rule-id tag. */
+inline std::string standard_key(const std::string &tag) {
+    static const char prefix[] = "external/";
+    std::string key;
+    std::size_t id = tag.find("/id/");
+    if ((tag.compare(0u, sizeof(prefix) - 1u, prefix) == 0) && (id != std::string::npos)) {
+        key = tag.substr(sizeof(prefix) - 1u, id - (sizeof(prefix) - 1u)) + "/" +
+              tag.substr(id + 4u);
+    }
+    return key;
+}
+
+class reader {
+public:
+    reader(json_cursor &cur, log &out, mapped_file &file) : cur_(cur), out_(out), file_(file) {}
+
+    void root() {
+        bool is_object = cur_.object([this](const slice &k) {
+            if (k == "runs") {
+                cur_.array([this](std::size_t) { run(); });
+            } else {
+                cur_.skip();
+            }
+        });
+        if (!is_object) {
+            cur_.fail("SARIF log is not a JSON object");
+        }
+        for (result &r : out_.results) {
+            auto it = keys_.find(r.rule_id);
+            r.key = (it != keys_.end()) ? it->second : r.rule_id;
+        }
+    }
+
+private:
+    void run() {
+        cur_.object([this](const slice &k) {
+            if (k == "tool") {
+                tool();
+            } else if (k == "results") {
+                cur_.array([this](std::size_t i) {
+                    one_result();
+                    if ((i % kReleaseEvery) == 0u) {
+                        file_.release_before(cur_.position());
+                    }
+                });
+            } else {
+                cur_.skip();
+            }
+        });
+    }
+
+    // tool.driver and tool.extensions[] are both toolComponents with rules[]
+    void tool() {
+        cur_.object([this](const slice &k) {
+            if (k == "driver") {
+                component();
+            } else if (k == "extensions") {
+                cur_.array([this](std::size_t) { component(); });
+            } else {
+                cur_.skip();
+            }
+        });
+    }
+
+    void component() {
+        cur_.object([this](const slice &k) {
+            if (k == "rules") {
+                cur_.array([this](std::size_t) { rule(); });
+            } else {
+                cur_.skip();
+            }
+        });
+    }
+
+    void rule() {
+        std::uint32_t id = UINT32_MAX;
+        std::string key;
+        cur_.object([&](const slice &k) {
+            if (k == "id") {
+                id = intern_slice(out_.strings, cur_.string());
+            } else if (k == "properties") {
+                cur_.object([&](const slice &pk) {
+                    if (pk == "tags") {
+                        cur_.array([&](std::size_t) {
+                            std::string candidate = standard_key(unescape(cur_.string()));
+                            if (key.empty()) {
+                                key = candidate;
+                            }
+                        });
+                    } else {
+                        cur_.skip();
+                    }
+                });
+            } else {
+                cur_.skip();
+            }
+        });
+        if (id != UINT32_MAX) {
+            std::uint32_t k = key.empty() ? id : out_.strings.intern(key);
+            keys_[id] = k;
+            if (std::find(out_.rules.begin(), out_.rules.end(), k) == out_.rules.end()) {
+                out_.rules.push_back(k);
+            }
+        }
+    }
+
+    void one_result() {
+        result r{UINT32_MAX, UINT32_MAX, UINT32_MAX, 0u};
+        cur_.object([&](const slice &k) {
+            if (k == "ruleId") {
+                r.rule_id = intern_slice(out_.strings, cur_.string());
+            } else if (k == "locations") {
+                cur_.array([&](std::size_t i) {
+                    if (i == 0u) {
+                        location(r);
+                    } else {
+                        cur_.skip();
+                    }
+                });
+            } else {
+                cur_.skip();
+            }
+        });
+        if (r.rule_id == UINT32_MAX) {
+            cur_.fail("result without ruleId");
+        }
+        if (r.uri == UINT32_MAX) {
+            r.uri = out_.strings.intern("", 0u);
+        }
+        out_.results.push_back(r);
+    }
+
+    void location(result &r) {
+        cur_.object([&](const slice &k) {
+            if (k == "physicalLocation") {
+                cur_.object([&](const slice &pk) {
+                    if (pk == "artifactLocation") {
+                        cur_.object([&](const slice &ak) {
+                            if (ak == "uri") {
+                                slice s = cur_.string();
+                                static const char scheme[] = "file://";
+                                if ((s.len >= sizeof(scheme) - 1u) &&
+                                    (std::memcmp(s.ptr, scheme, sizeof(scheme) - 1u) == 0)) {
+                                    s.ptr += sizeof(scheme) - 1u;
+                                    s.len -= sizeof(scheme) - 1u;
+                                }
+                                r.uri = intern_slice(out_.strings, s);
+                            } else {
+                                cur_.skip();
+                            }
+                        });
+                    } else if (pk == "region") {
+                        cur_.object([&](const slice &rk) {
+                            if (rk == "startLine") {
+                                r.line = static_cast<std::uint32_t>(cur_.integer());
+                            } else {
+                                cur_.skip();
+                            }
+                        });
+                    } else {
+                        cur_.skip();
+                    }
+                });
+            } else {
+                cur_.skip();
+            }
+        });
+    }
+
+    static constexpr std::size_t kReleaseEvery = 4096u;  // Results between page releases
+
+    json_cursor &cur_;
+    log &out_;
+    mapped_file &file_;
+    std::unordered_map<std::uint32_t, std::uint32_t> keys_;  // rule id -> standard key
+};
+
+}  // namespace detail
+
+/** Scan one SARIF file; throws std::system_error or sarif::parse_error. */
+inline log load(const std::string &path) {
+    mapped_file file(path);
+    log out;
+    out.bytes = file.size();
+    json_cursor cur(file.data(), file.data() + file.size());
+    detail::reader(cur, out, file).root();
+    return out;
+}
+
+}  // namespace sarif
+
+#endif  // SARIF_SCAN_HPP